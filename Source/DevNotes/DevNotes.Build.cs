@@ -51,7 +51,9 @@ public class DevNotes : ModuleRules
 				"PropertyEditor",
 				"LevelEditor", 
 				"HTTPServer", 
-				"AppFramework"
+				"AppFramework",
+				"ApplicationCore",
+				"WorkspaceMenuStructure"
 
 				// ... add private dependencies that you statically link with here ...	
 			}
@@ -0,0 +1,467 @@
+#include "DevNotesBenchmarkCommandlet.h"
+
+#include "DevNoteQuery.h"
+#include "DevNoteSearchIndex.h"
+#include "DevNoteSubsystem.h"
+#include "DevNoteSyntheticData.h"
+#include "DevNoteTrafficReplay.h"
+#include "DevNotesLog.h"
+#include "Editor.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include <atomic>
+
+namespace DevNotesBenchmark
+{
+	// Queries shaped like what the selector filters with: exact fields, tag sets, time ranges and ranked text
+	static const TCHAR* FilterQueries[] = {
+		TEXT("tag=bug"),
+		TEXT("map=zone04 crash"),
+		TEXT("user=user01 +tag=bug -tag=tag002"),
+		TEXT("edited<30d tag=bug"),
+		TEXT("crash lighting"),
+		TEXT("body=navm"),
+	};
+
+	// Differences below these are noise, whatever the threshold says
+	static constexpr double MinRegressionMs = 0.5;
+	static constexpr int64 MinRegressionAllocations = 100;
+
+	/**
+	 * Forwards to the real allocator, counting allocations and the net bytes they hold while installed.
+	 * Counts come from every thread, so background work running alongside a case is included.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		void Reset()
+		{
+			Allocations = 0;
+			AllocatedBytes = 0;
+			LiveBytes = 0;
+			PeakBytes = 0;
+		}
+
+		int64 GetAllocations() const { return Allocations; }
+		int64 GetAllocatedBytes() const { return AllocatedBytes; }
+		int64 GetPeakBytes() const { return PeakBytes; }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			void* Result = Inner->Malloc(Count, Alignment);
+			OnAllocated(Result);
+			return Result;
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			OnFreed(Original);
+			void* Result = Inner->Realloc(Original, Count, Alignment);
+			OnAllocated(Result);
+			return Result;
+		}
+
+		virtual void Free(void* Original) override
+		{
+			OnFreed(Original);
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("DevNotesBenchmark"); }
+
+		// Swap GMalloc for this while a case runs
+		struct FScopedInstall
+		{
+			explicit FScopedInstall(FCountingMalloc& Counting) : Previous(GMalloc) { GMalloc = &Counting; }
+			~FScopedInstall() { GMalloc = Previous; }
+			FMalloc* Previous;
+		};
+
+	private:
+		void OnAllocated(void* Ptr)
+		{
+			SIZE_T Size = 0;
+			if (!Ptr || !Inner->GetAllocationSize(Ptr, Size))
+			{
+				return;
+			}
+			++Allocations;
+			AllocatedBytes += Size;
+
+			const int64 Live = LiveBytes += Size;
+			int64 Peak = PeakBytes;
+			while (Live > Peak && !PeakBytes.compare_exchange_weak(Peak, Live))
+			{
+			}
+		}
+
+		void OnFreed(void* Ptr)
+		{
+			SIZE_T Size = 0;
+			if (Ptr && Inner->GetAllocationSize(Ptr, Size))
+			{
+				LiveBytes -= Size;
+			}
+		}
+
+		FMalloc* Inner;
+		std::atomic<int64> Allocations = 0;
+		std::atomic<int64> AllocatedBytes = 0;
+		std::atomic<int64> LiveBytes = 0;
+		std::atomic<int64> PeakBytes = 0;
+	};
+
+	// Time Body over Iterations runs, then count its allocations in one more. Setup runs before each, outside of what is measured
+	static FCaseResult Measure(FCountingMalloc& Counting, const FString& Name, int32 NumNotes, int32 Iterations,
+		TFunctionRef<void()> Setup, TFunctionRef<void()> Body)
+	{
+		FCaseResult Result;
+		Result.Name = Name;
+		Result.NumNotes = NumNotes;
+		Result.Iterations = Iterations;
+		Result.MinMs = TNumericLimits<double>::Max();
+
+		// Counting puts atomics on every allocation, so the timed runs go through the real allocator
+		double TotalMs = 0.0;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Setup();
+
+			const double Start = FPlatformTime::Seconds();
+			Body();
+			const double ElapsedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+			TotalMs += ElapsedMs;
+			Result.MinMs = FMath::Min(Result.MinMs, ElapsedMs);
+			Result.MaxMs = FMath::Max(Result.MaxMs, ElapsedMs);
+		}
+		Result.MeanMs = TotalMs / FMath::Max(1, Iterations);
+
+		Setup();
+		Counting.Reset();
+		{
+			FCountingMalloc::FScopedInstall Install(Counting);
+			Body();
+		}
+		Result.Allocations = Counting.GetAllocations();
+		Result.AllocatedBytes = Counting.GetAllocatedBytes();
+		Result.PeakBytes = Counting.GetPeakBytes();
+
+		UE_LOG(LogDevNotes, Display, TEXT("  %-40s %7d notes: min %9.3f ms, mean %9.3f ms, %lld allocations, %.2f MB allocated, %.2f MB peak"),
+			*Name, NumNotes, Result.MinMs, Result.MeanMs, Result.Allocations, Result.AllocatedBytes / (1024.0 * 1024.0), Result.PeakBytes / (1024.0 * 1024.0));
+		return Result;
+	}
+
+	static TSharedRef<FJsonObject> ToJson(const FCaseResult& Result)
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("name"), Result.Name);
+		Json->SetNumberField(TEXT("notes"), Result.NumNotes);
+		Json->SetNumberField(TEXT("iterations"), Result.Iterations);
+		Json->SetNumberField(TEXT("minMs"), Result.MinMs);
+		Json->SetNumberField(TEXT("meanMs"), Result.MeanMs);
+		Json->SetNumberField(TEXT("maxMs"), Result.MaxMs);
+		Json->SetNumberField(TEXT("allocations"), Result.Allocations);
+		Json->SetNumberField(TEXT("allocatedBytes"), Result.AllocatedBytes);
+		Json->SetNumberField(TEXT("peakBytes"), Result.PeakBytes);
+		return Json;
+	}
+
+	// Package of the map open in the editor, if any, so generated notes on it get waypoints
+	static FString GetEditorWorldPackage()
+	{
+		UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+		return World ? World->GetOutermost()->GetName() : FString();
+	}
+}
+
+// The fastest run is compared, it is the one least disturbed by the rest of the machine
+TArray<FString> DevNotesBenchmark::FindRegressions(const TArray<FCaseResult>& Results, const FJsonObject& Baseline, double Threshold)
+{
+	TArray<FString> Regressions;
+
+	TMap<FString, TSharedPtr<FJsonObject>> BaselineByKey;
+	const TArray<TSharedPtr<FJsonValue>>* BaselineCases = nullptr;
+	if (Baseline.TryGetArrayField(TEXT("cases"), BaselineCases))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *BaselineCases)
+		{
+			const TSharedPtr<FJsonObject> Case = Value->AsObject();
+			if (Case.IsValid())
+			{
+				BaselineByKey.Add(FString::Printf(TEXT("%s@%d"), *Case->GetStringField(TEXT("name")), Case->GetIntegerField(TEXT("notes"))), Case);
+			}
+		}
+	}
+
+	for (const FCaseResult& Result : Results)
+	{
+		const TSharedPtr<FJsonObject>* Case = BaselineByKey.Find(Result.GetKey());
+		if (!Case)
+		{
+			continue;
+		}
+
+		const double BaselineMs = (*Case)->GetNumberField(TEXT("minMs"));
+		if (Result.MinMs > BaselineMs * (1.0 + Threshold) && Result.MinMs - BaselineMs > MinRegressionMs)
+		{
+			Regressions.Add(FString::Printf(TEXT("%s: %.3f ms, baseline %.3f ms"), *Result.GetKey(), Result.MinMs, BaselineMs));
+		}
+
+		const int64 BaselineAllocations = static_cast<int64>((*Case)->GetNumberField(TEXT("allocations")));
+		if (Result.Allocations > BaselineAllocations * (1.0 + Threshold) && Result.Allocations - BaselineAllocations > MinRegressionAllocations)
+		{
+			Regressions.Add(FString::Printf(TEXT("%s: %lld allocations, baseline %lld"), *Result.GetKey(), Result.Allocations, BaselineAllocations));
+		}
+	}
+	return Regressions;
+}
+
+UDevNotesBenchmarkCommandlet::UDevNotesBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UDevNotesBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace DevNotesBenchmark;
+
+	FString SizesString = TEXT("1000,10000,100000");
+	FParse::Value(*Params, TEXT("Sizes="), SizesString);
+	TArray<FString> SizeStrings;
+	SizesString.ParseIntoArray(SizeStrings, TEXT(","));
+
+	FDevNoteSyntheticDataParams DataParams;
+	FParse::Value(*Params, TEXT("Tags="), DataParams.NumTags);
+	FParse::Value(*Params, TEXT("Users="), DataParams.NumUsers);
+	FParse::Value(*Params, TEXT("Levels="), DataParams.NumLevels);
+	DataParams.FirstLevelPackage = GetEditorWorldPackage();
+
+	int32 Iterations = 5;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(1, Iterations);
+
+	double Threshold = 0.2;
+	FParse::Value(*Params, TEXT("Threshold="), Threshold);
+
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("DevNotes") / FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString());
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+	FString BaselinePath;
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+
+	// Lives past the last case: a thread may still be inside it when GMalloc is swapped back
+	static FCountingMalloc Counting(GMalloc);
+
+	TArray<FCaseResult> Results;
+	for (const FString& SizeString : SizeStrings)
+	{
+		DataParams.NumNotes = FMath::Max(1, FCString::Atoi(*SizeString));
+		const int32 NumNotes = DataParams.NumNotes;
+		UE_LOG(LogDevNotes, Display, TEXT("Generating %d notes, %d tags, %d users, %d levels"), NumNotes, DataParams.NumTags, DataParams.NumUsers, DataParams.NumLevels);
+
+		const FDevNoteSyntheticData Data = FDevNoteSyntheticData::Generate(DataParams);
+		const FString NotesJson = Data.NotesToJson();
+
+		TArray<TSharedPtr<FJsonValue>> NotesArray;
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(NotesJson), NotesArray);
+
+		Results.Add(Measure(Counting, TEXT("ParseNoteFromJsonObject"), NumNotes, Iterations, [] {}, [&NotesArray]()
+		{
+			FDevNote Note;
+			for (const TSharedPtr<FJsonValue>& Value : NotesArray)
+			{
+				UDevNoteSubsystem::ParseNoteFromJsonObject(Value->AsObject(), Note);
+			}
+		}));
+
+		Results.Add(Measure(Counting, TEXT("SerializeNoteToJsonString"), NumNotes, Iterations, [] {}, [&Data]()
+		{
+			int64 TotalLength = 0;
+			for (const FDevNote& Note : Data.Notes)
+			{
+				TotalLength += UDevNoteSubsystem::SerializeNoteToJsonString(Note).Len();
+			}
+			check(TotalLength > 0);
+		}));
+
+		// A first sync into an empty cache, then the same notes again as a poll that finds nothing changed
+		TStrongObjectPtr<UDevNoteSubsystem> Subsystem;
+		Results.Add(Measure(Counting, TEXT("ParseAndCacheNotesFromJson"), NumNotes, Iterations, [&Subsystem]()
+		{
+			Subsystem.Reset(NewObject<UDevNoteSubsystem>(GetTransientPackage()));
+		},
+		[&Subsystem, &NotesJson]()
+		{
+			Subsystem->ParseAndCacheNotesFromJson(NotesJson);
+		}));
+
+		Results.Add(Measure(Counting, TEXT("ParseAndCacheNotesFromJson (unchanged)"), NumNotes, Iterations, [] {}, [&Subsystem, &NotesJson]()
+		{
+			Subsystem->ParseAndCacheNotesFromJson(NotesJson);
+		}));
+
+		// What SDevNoteSelector::ParseAndApplyFilters runs per keystroke, without the widget around it
+		TArray<TSharedPtr<FDevNote>> SharedNotes;
+		SharedNotes.Reserve(Data.Notes.Num());
+		for (const FDevNote& Note : Data.Notes)
+		{
+			SharedNotes.Add(MakeShared<FDevNote>(Note));
+		}
+		FDevNoteSearchIndex Index;
+		Index.SetTags(Data.Tags);
+		Index.SetUsers(Data.Users);
+		Index.RebuildNotes(SharedNotes);
+
+		Results.Add(Measure(Counting, TEXT("SelectorFilter"), NumNotes, Iterations, [] {}, [&Index]()
+		{
+			TArray<int32> Matches;
+			for (const TCHAR* QueryString : FilterQueries)
+			{
+				const FDevNoteQuery Query = FDevNoteQuery::Compile(QueryString, Index);
+				Matches.Reset();
+				Query.Evaluate(Index.GetEntries(), nullptr, Matches);
+				if (Query.IsRanked())
+				{
+					Query.SortByScore(Index.GetEntries(), Matches);
+				}
+			}
+		}));
+
+		// Notes on level 0 are on the map open in the editor, about one in NumLevels of them. Each iteration of the first
+		// case starts without waypoints so it spawns them all, the second reconciles waypoints that are already up to date
+		if (!DataParams.FirstLevelPackage.IsEmpty())
+		{
+			Results.Add(Measure(Counting, TEXT("RefreshWaypointActors"), NumNotes, Iterations, [&Subsystem]()
+			{
+				Subsystem->ClearAllNoteWaypoints();
+			},
+			[&Subsystem]()
+			{
+				Subsystem->RefreshWaypointActors();
+			}));
+			Results.Add(Measure(Counting, TEXT("RefreshWaypointActors(Unchanged)"), NumNotes, Iterations, [&Subsystem]()
+			{
+				Subsystem->RefreshWaypointActors();
+			},
+			[&Subsystem]()
+			{
+				Subsystem->RefreshWaypointActors();
+			}));
+			Subsystem->ClearAllNoteWaypoints();
+		}
+		else
+		{
+			UE_LOG(LogDevNotes, Warning, TEXT("No editor world, skipping RefreshWaypointActors"));
+		}
+	}
+
+	// A captured session applied back to back into a fresh cache, so the real mix of payloads is measured too
+	FString ReplayPath;
+	if (FParse::Value(*Params, TEXT("Replay="), ReplayPath))
+	{
+		TArray<FDevNoteExchange> Exchanges;
+		if (FDevNoteTrafficCapture::Load(ReplayPath, Exchanges))
+		{
+			// The replay leaves out what it can't apply. The case is keyed by every exchange captured
+			TStrongObjectPtr<UDevNoteSubsystem> Subsystem;
+			TSharedPtr<FDevNoteTrafficReplay> Replay;
+			Results.Add(Measure(Counting, FString::Printf(TEXT("Replay:%s"), *FPaths::GetCleanFilename(ReplayPath)), Exchanges.Num(), Iterations,
+			[&Subsystem, &Replay, &Exchanges]()
+			{
+				if (Subsystem)
+				{
+					Subsystem->ClearAllNoteWaypoints();
+				}
+				Subsystem.Reset(NewObject<UDevNoteSubsystem>(GetTransientPackage()));
+				Replay = MakeShared<FDevNoteTrafficReplay>(*Subsystem, CopyTemp(Exchanges));
+			},
+			[&Replay]()
+			{
+				Replay->ApplyAll();
+			}));
+			Subsystem->ClearAllNoteWaypoints();
+		}
+		else
+		{
+			UE_LOG(LogDevNotes, Error, TEXT("Could not read capture %s, skipping replay"), *ReplayPath);
+		}
+	}
+
+	TArray<FString> Regressions;
+	if (!BaselinePath.IsEmpty())
+	{
+		FString BaselineString;
+		TSharedPtr<FJsonObject> Baseline;
+		if (FFileHelper::LoadFileToString(BaselineString, *BaselinePath) && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineString), Baseline) && Baseline.IsValid())
+		{
+			Regressions = FindRegressions(Results, *Baseline, Threshold);
+		}
+		else
+		{
+			Regressions.Add(FString::Printf(TEXT("Could not read baseline %s"), *BaselinePath));
+		}
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Report->SetStringField(TEXT("createdAt"), FDateTime::UtcNow().ToIso8601());
+	Report->SetNumberField(TEXT("tags"), DataParams.NumTags);
+	Report->SetNumberField(TEXT("users"), DataParams.NumUsers);
+	Report->SetNumberField(TEXT("levels"), DataParams.NumLevels);
+	TArray<TSharedPtr<FJsonValue>> CasesJson;
+	for (const FCaseResult& Result : Results)
+	{
+		CasesJson.Add(MakeShared<FJsonValueObject>(ToJson(Result)));
+	}
+	Report->SetArrayField(TEXT("cases"), CasesJson);
+	if (!BaselinePath.IsEmpty())
+	{
+		Report->SetStringField(TEXT("baseline"), BaselinePath);
+		Report->SetNumberField(TEXT("threshold"), Threshold);
+		TArray<TSharedPtr<FJsonValue>> RegressionsJson;
+		for (const FString& Regression : Regressions)
+		{
+			RegressionsJson.Add(MakeShared<FJsonValueString>(Regression));
+		}
+		Report->SetArrayField(TEXT("regressions"), RegressionsJson);
+	}
+
+	FString ReportString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportString);
+	FJsonSerializer::Serialize(Report, Writer);
+	if (!FFileHelper::SaveStringToFile(ReportString, *ReportPath))
+	{
+		UE_LOG(LogDevNotes, Error, TEXT("Could not write benchmark report to %s"), *ReportPath);
+		return 1;
+	}
+	UE_LOG(LogDevNotes, Display, TEXT("Wrote benchmark report to %s"), *FPaths::ConvertRelativePathToFull(ReportPath));
+
+	for (const FString& Regression : Regressions)
+	{
+		UE_LOG(LogDevNotes, Error, TEXT("Regression: %s"), *Regression);
+	}
+	return Regressions.IsEmpty() ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DevNotesBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+
+namespace DevNotesBenchmark
+{
+	struct FCaseResult
+	{
+		FString Name;
+		int32 NumNotes = 0;
+		int32 Iterations = 0;
+		double MinMs = 0.0;
+		double MeanMs = 0.0;
+		double MaxMs = 0.0;
+
+		// Per iteration, counted in a pass of its own so the counting doesn't slow the timed runs
+		int64 Allocations = 0;
+		int64 AllocatedBytes = 0;
+
+		// Most memory held at once above where the iteration started
+		int64 PeakBytes = 0;
+
+		FString GetKey() const { return FString::Printf(TEXT("%s@%d"), *Name, NumNotes); }
+	};
+
+	// The cases that got slower or allocate more than Threshold allows over a baseline report's, one line each
+	TArray<FString> FindRegressions(const TArray<FCaseResult>& Results, const FJsonObject& Baseline, double Threshold);
+}
+
+/**
+ * Times the plugin's parse, serialize, filter and waypoint paths over synthetic datasets and writes a JSON report.
+ * With -Replay it also times applying a DevNotes.Capture.Start file's responses.
+ * With a baseline report it fails (returns 1) when a case got slower or allocates more than the threshold allows.
+ *
+ * UnrealEditor-Cmd <Project> -run=DevNotesBenchmark [-Sizes=1000,10000,100000] [-Tags=2000] [-Users=500] [-Levels=200]
+ *     [-Iterations=5] [-Report=<path>] [-Baseline=<path>] [-Threshold=0.2] [-Replay=<capture>]
+ */
+UCLASS()
+class UDevNotesBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDevNotesBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
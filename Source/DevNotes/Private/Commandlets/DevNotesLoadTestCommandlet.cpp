@@ -0,0 +1,539 @@
+#include "DevNotesLoadTestCommandlet.h"
+
+#include "DevNoteDiagnostics.h"
+#include "DevNoteSubsystem.h"
+#include "DevNoteSyntheticData.h"
+#include "DevNotesLog.h"
+#include "FDevNoteTag.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace DevNotesLoadTest
+{
+	enum class EAction : uint8
+	{
+		Poll,
+		Create,
+		Move,
+		Retag,
+		Delete,
+		Num
+	};
+
+	static const TCHAR* ActionNames[] = { TEXT("poll"), TEXT("create"), TEXT("move"), TEXT("retag"), TEXT("delete") };
+	static_assert(UE_ARRAY_COUNT(ActionNames) == static_cast<int32>(EAction::Num), "Name every action");
+
+	// How long to wait for requests still in flight once the test is over
+	static constexpr double DrainSeconds = 30.0;
+	static constexpr double HarvestIntervalSeconds = 60.0;
+	static constexpr double SignInRetrySeconds = 5.0;
+
+	struct FClient
+	{
+		TStrongObjectPtr<UDevNoteSubsystem> Subsystem;
+		FString UserName;
+		FRandomStream Random;
+
+		double SignInTime = 0.0;
+		bool bSigningIn = false;
+		double NextPollTime = 0.0;
+		double NextActionTime = 0.0;
+
+		// Notes this client created, the only ones it deletes so the shared dataset doesn't drain away
+		TArray<FGuid> OwnNotes;
+
+		// End times of the newest diagnostics records already collected
+		double RequestsHarvestedUntil = 0.0;
+		double StagesHarvestedUntil = 0.0;
+	};
+
+	struct FCounts
+	{
+		int32 Actions[static_cast<int32>(EAction::Num)] = {};
+		int32 Skipped = 0;
+		int32 SignIns = 0;
+		int32 SignInFailures = 0;
+	};
+
+	// Parse "poll:20,create:30,..." into weights per action. Actions left out get no weight
+	static bool ParseMix(const FString& MixString, float (&OutWeights)[static_cast<int32>(EAction::Num)])
+	{
+		TArray<FString> Entries;
+		MixString.ParseIntoArray(Entries, TEXT(","));
+		for (float& Weight : OutWeights)
+		{
+			Weight = 0.0f;
+		}
+
+		float Total = 0.0f;
+		for (const FString& Entry : Entries)
+		{
+			FString Name;
+			FString Value;
+			if (!Entry.Split(TEXT(":"), &Name, &Value))
+			{
+				return false;
+			}
+
+			bool bKnown = false;
+			for (int32 Action = 0; Action < static_cast<int32>(EAction::Num); ++Action)
+			{
+				if (Name.TrimStartAndEnd().Equals(ActionNames[Action], ESearchCase::IgnoreCase))
+				{
+					OutWeights[Action] = FMath::Max(0.0f, FCString::Atof(*Value));
+					Total += OutWeights[Action];
+					bKnown = true;
+				}
+			}
+			if (!bKnown)
+			{
+				return false;
+			}
+		}
+		return Total > 0.0f;
+	}
+
+	static EAction PickAction(FRandomStream& Random, const float (&Weights)[static_cast<int32>(EAction::Num)])
+	{
+		float Total = 0.0f;
+		for (const float Weight : Weights)
+		{
+			Total += Weight;
+		}
+
+		float Pick = Random.FRand() * Total;
+		for (int32 Action = 0; Action < static_cast<int32>(EAction::Num); ++Action)
+		{
+			Pick -= Weights[Action];
+			if (Pick < 0.0f)
+			{
+				return static_cast<EAction>(Action);
+			}
+		}
+		return EAction::Poll;
+	}
+
+	// Exponentially distributed, so clients act independently of each other around the mean
+	static double NextDelay(FRandomStream& Random, double MeanSeconds)
+	{
+		return -MeanSeconds * FMath::Loge(FMath::Max(KINDA_SMALL_NUMBER, 1.0f - Random.FRand()));
+	}
+
+	static TArray<FGuid> PickTags(FRandomStream& Random, const UDevNoteSubsystem& Subsystem)
+	{
+		const TArray<FDevNoteTag>& Tags = Subsystem.GetCachedTags();
+		TArray<FGuid> Picked;
+		for (int32 Count = Random.RandRange(1, 3); Count > 0 && !Tags.IsEmpty(); --Count)
+		{
+			Picked.AddUnique(Tags[Random.RandHelper(Tags.Num())].Id);
+		}
+		return Picked;
+	}
+
+	static void RunAction(FClient& Client, EAction Action, const FDevNoteSyntheticData& Vocabulary, int32 BodyWords, FCounts& Counts)
+	{
+		UDevNoteSubsystem& Subsystem = *Client.Subsystem;
+		const TArray<TSharedPtr<FDevNote>>& Notes = Subsystem.GetNotes();
+		const TSharedPtr<FDevNote> Target = Notes.IsEmpty() ? nullptr : Notes[Client.Random.RandHelper(Notes.Num())];
+
+		switch (Action)
+		{
+		case EAction::Poll:
+			Subsystem.RequestNotesFromServer();
+			break;
+
+		case EAction::Create:
+		{
+			FDevNote Note = Vocabulary.MakeNote(Client.Random, BodyWords);
+			Note.CreatedById = Subsystem.GetCurrentUser().Id;
+			Note.CreatedAt = FDateTime::UtcNow();
+			Note.Tags = PickTags(Client.Random, Subsystem);
+			Note.bBodyLoaded = true;
+			Client.OwnNotes.Add(Note.Id);
+			Subsystem.PostNote(Note);
+			break;
+		}
+
+		case EAction::Move:
+		case EAction::Retag:
+		{
+			if (!Target.IsValid())
+			{
+				++Counts.Skipped;
+				return;
+			}
+			FDevNote Note = *Target;
+			if (Action == EAction::Move)
+			{
+				Note.WorldPosition += FVector(Client.Random.FRandRange(-500.0f, 500.0f), Client.Random.FRandRange(-500.0f, 500.0f), 0.0f);
+			}
+			else
+			{
+				Note.Tags = PickTags(Client.Random, Subsystem);
+			}
+			Subsystem.UpdateNote(Note);
+			break;
+		}
+
+		case EAction::Delete:
+			if (Client.OwnNotes.IsEmpty())
+			{
+				++Counts.Skipped;
+				return;
+			}
+			Subsystem.DeleteNote(Client.OwnNotes.Pop(EAllowShrinking::No));
+			break;
+
+		default:
+			break;
+		}
+		++Counts.Actions[static_cast<int32>(Action)];
+	}
+
+	// Collect the client's records that finished since the last harvest, before its diagnostics window drops them
+	static void Harvest(FClient& Client, TArray<FDevNoteRequestRecord>& OutRequests, TArray<FDevNoteStageRecord>& OutStages)
+	{
+		const FDevNoteDiagnostics& Diagnostics = Client.Subsystem->GetDiagnostics();
+		for (const FDevNoteRequestRecord& Record : Diagnostics.GetRequests())
+		{
+			if (Record.EndTime > Client.RequestsHarvestedUntil)
+			{
+				OutRequests.Add(Record);
+			}
+		}
+		for (const FDevNoteStageRecord& Record : Diagnostics.GetStages())
+		{
+			if (Record.EndTime > Client.StagesHarvestedUntil)
+			{
+				OutStages.Add(Record);
+			}
+		}
+
+		// Both are ordered by end time
+		if (!Diagnostics.GetRequests().IsEmpty())
+		{
+			Client.RequestsHarvestedUntil = FMath::Max(Client.RequestsHarvestedUntil, Diagnostics.GetRequests().Last().EndTime);
+		}
+		if (!Diagnostics.GetStages().IsEmpty())
+		{
+			Client.StagesHarvestedUntil = FMath::Max(Client.StagesHarvestedUntil, Diagnostics.GetStages().Last().EndTime);
+		}
+	}
+
+	// What the editor's main loop would do for HTTP completions between frames
+	static void Tick(float DeltaTime)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+		FHttpModule::Get().GetHttpManager().Tick(DeltaTime);
+	}
+
+	static int32 GetRequestsInFlight(const TArray<TSharedRef<FClient>>& Clients)
+	{
+		int32 InFlight = 0;
+		for (const TSharedRef<FClient>& Client : Clients)
+		{
+			InFlight += Client->Subsystem->GetDiagnostics().GetRequestsInFlight();
+		}
+		return InFlight;
+	}
+
+	static TSharedRef<FJsonObject> SummaryToJson(const FDevNoteLatencySummary& Summary, double Seconds)
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetNumberField(TEXT("count"), Summary.Count);
+		Json->SetNumberField(TEXT("perSecond"), Seconds > 0.0 ? Summary.Count / Seconds : 0.0);
+		Json->SetNumberField(TEXT("failed"), Summary.NumFailed);
+		Json->SetNumberField(TEXT("errorRate"), Summary.Count > 0 ? double(Summary.NumFailed) / Summary.Count : 0.0);
+		Json->SetNumberField(TEXT("p50Ms"), Summary.P50Ms);
+		Json->SetNumberField(TEXT("p95Ms"), Summary.P95Ms);
+		Json->SetNumberField(TEXT("p99Ms"), Summary.P99Ms);
+		Json->SetNumberField(TEXT("maxMs"), Summary.MaxMs);
+		Json->SetNumberField(TEXT("p50Bytes"), Summary.P50Bytes);
+		Json->SetNumberField(TEXT("maxBytes"), Summary.MaxBytes);
+
+		TArray<TSharedPtr<FJsonValue>> Histogram;
+		for (int32 Bucket = 0; Bucket < FDevNoteLatencySummary::NumBuckets; ++Bucket)
+		{
+			TSharedRef<FJsonObject> BucketJson = MakeShared<FJsonObject>();
+			if (Bucket < FDevNoteLatencySummary::NumBuckets - 1)
+			{
+				BucketJson->SetNumberField(TEXT("upToMs"), FDevNoteLatencySummary::BucketLimitsMs[Bucket]);
+			}
+			BucketJson->SetNumberField(TEXT("count"), Summary.Histogram[Bucket]);
+			Histogram.Add(MakeShared<FJsonValueObject>(BucketJson));
+		}
+		Json->SetArrayField(TEXT("histogram"), Histogram);
+		return Json;
+	}
+}
+
+UDevNotesLoadTestCommandlet::UDevNotesLoadTestCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UDevNotesLoadTestCommandlet::Main(const FString& Params)
+{
+	using namespace DevNotesLoadTest;
+
+	FString Server;
+	FParse::Value(*Params, TEXT("Server="), Server);
+	int32 NumClients = 150;
+	FParse::Value(*Params, TEXT("Clients="), NumClients);
+	NumClients = FMath::Max(1, NumClients);
+	double Duration = 300.0;
+	FParse::Value(*Params, TEXT("Duration="), Duration);
+	double RampUp = 30.0;
+	FParse::Value(*Params, TEXT("RampUp="), RampUp);
+	double PollInterval = 30.0;
+	FParse::Value(*Params, TEXT("PollInterval="), PollInterval);
+	double ThinkTime = 20.0;
+	FParse::Value(*Params, TEXT("ThinkTime="), ThinkTime);
+	FString UserPrefix = TEXT("LoadTest");
+	FParse::Value(*Params, TEXT("UserPrefix="), UserPrefix);
+	FString Password;
+	FParse::Value(*Params, TEXT("Password="), Password);
+	int32 BodyWords = 40;
+	FParse::Value(*Params, TEXT("BodyWords="), BodyWords);
+
+	FString MixString = TEXT("poll:20,create:30,move:20,retag:20,delete:10");
+	FParse::Value(*Params, TEXT("Mix="), MixString, /* bShouldStopOnSeparator */ false);
+	float Weights[static_cast<int32>(EAction::Num)];
+	if (!ParseMix(MixString, Weights))
+	{
+		UE_LOG(LogDevNotes, Error, TEXT("Could not read -Mix=%s, expected e.g. poll:20,create:30,move:20,retag:20,delete:10"), *MixString);
+		return 1;
+	}
+
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("DevNotes") / FString::Printf(TEXT("LoadTest-%s.json"), *FDateTime::Now().ToString());
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	// Levels for created notes to sit on, in the same shape as the mock server's
+	FDevNoteSyntheticDataParams VocabularyParams;
+	VocabularyParams.NumNotes = 0;
+	VocabularyParams.NumTags = 0;
+	VocabularyParams.NumUsers = 0;
+	const FDevNoteSyntheticData Vocabulary = FDevNoteSyntheticData::Generate(VocabularyParams);
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<TSharedRef<FClient>> Clients;
+	Clients.Reserve(NumClients);
+	for (int32 Index = 0; Index < NumClients; ++Index)
+	{
+		TSharedRef<FClient> Client = MakeShared<FClient>();
+		Client->Subsystem.Reset(NewObject<UDevNoteSubsystem>(GetTransientPackage()));
+		Client->Subsystem->MakeSimulatedClient(Server);
+		Client->UserName = FString::Printf(TEXT("%s%03d"), *UserPrefix, Index);
+		Client->Random.Initialize(Index + 1);
+		Client->SignInTime = StartTime + RampUp * Index / NumClients;
+		Client->RequestsHarvestedUntil = StartTime;
+		Client->StagesHarvestedUntil = StartTime;
+		Clients.Add(Client);
+	}
+
+	UE_LOG(LogDevNotes, Display, TEXT("Load test: %d clients against %s for %.0f s, mix %s"),
+		NumClients, Server.IsEmpty() ? TEXT("the configured server") : *Server, Duration, *MixString);
+
+	FCounts Counts;
+	TArray<FDevNoteRequestRecord> Requests;
+	TArray<FDevNoteStageRecord> Stages;
+	const double EndTime = StartTime + Duration;
+	double LastTickTime = StartTime;
+	double NextHarvestTime = StartTime + HarvestIntervalSeconds;
+	while (true)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= EndTime || IsEngineExitRequested())
+		{
+			break;
+		}
+
+		for (const TSharedRef<FClient>& Client : Clients)
+		{
+			UDevNoteSubsystem& Subsystem = *Client->Subsystem;
+			if (!Subsystem.IsLoggedIn())
+			{
+				// Not signed in yet, or signed out by the server
+				if (!Client->bSigningIn && Now >= Client->SignInTime)
+				{
+					Client->bSigningIn = true;
+					++Counts.SignIns;
+					Subsystem.SignIn(Client->UserName, Password, [WeakClient = TWeakPtr<FClient>(Client), &Counts, PollInterval, ThinkTime](bool bSuccess, const FString& Error)
+					{
+						const TSharedPtr<FClient> SignedIn = WeakClient.Pin();
+						if (!SignedIn.IsValid())
+						{
+							return;
+						}
+
+						SignedIn->bSigningIn = false;
+						const double SignedInTime = FPlatformTime::Seconds();
+						if (!bSuccess)
+						{
+							++Counts.SignInFailures;
+							SignedIn->SignInTime = SignedInTime + SignInRetrySeconds;
+							return;
+						}
+
+						// The editor syncs everything on sign in, then polls on a timer that no two editors share a phase of
+						SignedIn->Subsystem->RequestNotesFromServer();
+						SignedIn->NextPollTime = SignedInTime + SignedIn->Random.FRand() * PollInterval;
+						SignedIn->NextActionTime = SignedInTime + NextDelay(SignedIn->Random, ThinkTime);
+					});
+				}
+				continue;
+			}
+
+			if (Client->bSigningIn)
+			{
+				continue;
+			}
+			if (Now >= Client->NextPollTime)
+			{
+				Subsystem.RequestNotesFromServer();
+				Client->NextPollTime = Now + PollInterval;
+			}
+			if (Now >= Client->NextActionTime)
+			{
+				RunAction(*Client, PickAction(Client->Random, Weights), Vocabulary, BodyWords, Counts);
+				Client->NextActionTime = Now + NextDelay(Client->Random, ThinkTime);
+			}
+		}
+
+		Tick(Now - LastTickTime);
+		LastTickTime = Now;
+
+		if (Now >= NextHarvestTime)
+		{
+			for (const TSharedRef<FClient>& Client : Clients)
+			{
+				Harvest(*Client, Requests, Stages);
+			}
+			NextHarvestTime = Now + HarvestIntervalSeconds;
+			UE_LOG(LogDevNotes, Display, TEXT("  %.0f s: %d requests done, %d in flight"), Now - StartTime, Requests.Num(), GetRequestsInFlight(Clients));
+		}
+
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	// Let the last requests finish, then sign everyone out so a real server doesn't keep their sessions
+	for (const TSharedRef<FClient>& Client : Clients)
+	{
+		if (Client->Subsystem->IsLoggedIn())
+		{
+			Client->Subsystem->SignOut(nullptr);
+		}
+	}
+	const double DrainEndTime = FPlatformTime::Seconds() + DrainSeconds;
+	while (GetRequestsInFlight(Clients) > 0 && FPlatformTime::Seconds() < DrainEndTime)
+	{
+		const double Now = FPlatformTime::Seconds();
+		Tick(Now - LastTickTime);
+		LastTickTime = Now;
+		FPlatformProcess::Sleep(0.001f);
+	}
+	const int32 Abandoned = GetRequestsInFlight(Clients);
+
+	for (const TSharedRef<FClient>& Client : Clients)
+	{
+		Harvest(*Client, Requests, Stages);
+	}
+	const double Elapsed = FMath::Max(KINDA_SMALL_NUMBER, FPlatformTime::Seconds() - StartTime);
+
+	// Report
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("server"), Server);
+	Report->SetStringField(TEXT("createdAt"), FDateTime::UtcNow().ToIso8601());
+	Report->SetNumberField(TEXT("clients"), NumClients);
+	Report->SetNumberField(TEXT("seconds"), Elapsed);
+	Report->SetStringField(TEXT("mix"), MixString);
+	Report->SetNumberField(TEXT("pollInterval"), PollInterval);
+	Report->SetNumberField(TEXT("thinkTime"), ThinkTime);
+	Report->SetNumberField(TEXT("signIns"), Counts.SignIns);
+	Report->SetNumberField(TEXT("signInFailures"), Counts.SignInFailures);
+	Report->SetNumberField(TEXT("abandonedRequests"), Abandoned);
+
+	TSharedRef<FJsonObject> ActionsJson = MakeShared<FJsonObject>();
+	for (int32 Action = 0; Action < static_cast<int32>(EAction::Num); ++Action)
+	{
+		ActionsJson->SetNumberField(ActionNames[Action], Counts.Actions[Action]);
+	}
+	ActionsJson->SetNumberField(TEXT("skipped"), Counts.Skipped);
+	Report->SetObjectField(TEXT("actions"), ActionsJson);
+
+	int32 NumFailed = 0;
+	TMap<int32, int32> ResponseCodes;
+	for (const FDevNoteRequestRecord& Record : Requests)
+	{
+		NumFailed += Record.bFailed ? 1 : 0;
+		++ResponseCodes.FindOrAdd(Record.ResponseCode);
+	}
+	Report->SetNumberField(TEXT("requests"), Requests.Num());
+	Report->SetNumberField(TEXT("requestsPerSecond"), Requests.Num() / Elapsed);
+	Report->SetNumberField(TEXT("errorRate"), Requests.IsEmpty() ? 0.0 : double(NumFailed) / Requests.Num());
+
+	// 0 counts requests that got no response at all
+	ResponseCodes.KeySort(TLess<int32>());
+	TSharedRef<FJsonObject> CodesJson = MakeShared<FJsonObject>();
+	for (const TPair<int32, int32>& Code : ResponseCodes)
+	{
+		CodesJson->SetNumberField(FString::FromInt(Code.Key), Code.Value);
+	}
+	Report->SetObjectField(TEXT("responseCodes"), CodesJson);
+
+	UE_LOG(LogDevNotes, Display, TEXT("Load test done: %d clients, %.0f s, %d requests (%.1f/s), %.2f%% failed, %d sign in failures, %d abandoned"),
+		NumClients, Elapsed, Requests.Num(), Requests.Num() / Elapsed, Requests.IsEmpty() ? 0.0 : 100.0 * NumFailed / Requests.Num(), Counts.SignInFailures, Abandoned);
+
+	TSharedRef<FJsonObject> EndpointsJson = MakeShared<FJsonObject>();
+	for (int32 Endpoint = 0; Endpoint < static_cast<int32>(EDevNoteEndpoint::Num); ++Endpoint)
+	{
+		const FDevNoteLatencySummary Summary = FDevNoteDiagnostics::SummarizeRequests(Requests, static_cast<EDevNoteEndpoint>(Endpoint), StartTime);
+		if (Summary.Count == 0)
+		{
+			continue;
+		}
+		const TCHAR* Name = FDevNoteDiagnostics::GetEndpointName(static_cast<EDevNoteEndpoint>(Endpoint));
+		EndpointsJson->SetObjectField(Name, SummaryToJson(Summary, Elapsed));
+		UE_LOG(LogDevNotes, Display, TEXT("  %-14s %7d requests %7.1f/s  p50 %8.1f ms  p95 %8.1f ms  p99 %8.1f ms  max %8.1f ms  %5.2f%% failed"),
+			Name, Summary.Count, Summary.Count / Elapsed, Summary.P50Ms, Summary.P95Ms, Summary.P99Ms, Summary.MaxMs, 100.0 * Summary.NumFailed / Summary.Count);
+	}
+	Report->SetObjectField(TEXT("endpoints"), EndpointsJson);
+
+	TSharedRef<FJsonObject> StagesJson = MakeShared<FJsonObject>();
+	for (int32 Stage = 0; Stage < static_cast<int32>(EDevNoteStage::Num); ++Stage)
+	{
+		const FDevNoteLatencySummary Summary = FDevNoteDiagnostics::SummarizeStage(Stages, static_cast<EDevNoteStage>(Stage), StartTime);
+		if (Summary.Count == 0)
+		{
+			continue;
+		}
+		const TCHAR* Name = FDevNoteDiagnostics::GetStageName(static_cast<EDevNoteStage>(Stage));
+		StagesJson->SetObjectField(Name, SummaryToJson(Summary, Elapsed));
+		UE_LOG(LogDevNotes, Display, TEXT("  %-14s %7d runs              p50 %8.1f ms  p95 %8.1f ms  p99 %8.1f ms  max %8.1f ms"),
+			Name, Summary.Count, Summary.P50Ms, Summary.P95Ms, Summary.P99Ms, Summary.MaxMs);
+	}
+	Report->SetObjectField(TEXT("stages"), StagesJson);
+
+	FString ReportString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportString);
+	FJsonSerializer::Serialize(Report, Writer);
+	if (!FFileHelper::SaveStringToFile(ReportString, *ReportPath))
+	{
+		UE_LOG(LogDevNotes, Error, TEXT("Could not write load test report to %s"), *ReportPath);
+		return 1;
+	}
+	UE_LOG(LogDevNotes, Display, TEXT("Wrote load test report to %s"), *FPaths::ConvertRelativePathToFull(ReportPath));
+	return 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DevNotesLoadTestCommandlet.generated.h"
+
+/**
+ * Simulates many editors using one DevNotes server at once. Each client is a separate UDevNoteSubsystem, so requests are
+ * built, sent and parsed by the plugin's own code. Clients sign in, poll on the editor's interval and, between think
+ * times, create, move, retag and delete notes in the given mix. Reports throughput, latency percentiles and histograms
+ * per endpoint, error rates and client side parse and cache times.
+ *
+ * UnrealEditor-Cmd <Project> -run=DevNotesLoadTest [-Server=<url>] [-Clients=150] [-Duration=300] [-RampUp=30]
+ *     [-PollInterval=30] [-ThinkTime=20] [-Mix=poll:20,create:30,move:20,retag:20,delete:10] [-UserPrefix=LoadTest]
+ *     [-Password=] [-BodyWords=40] [-Report=<path>]
+ */
+UCLASS()
+class UDevNotesLoadTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDevNotesLoadTestCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,130 @@
+﻿#include "DevNoteBodyCache.h"
+
+FDevNoteBodyCache::FDevNoteBodyCache(int64 InMaxBytes)
+	: MaxBytes(InMaxBytes)
+{
+}
+
+void FDevNoteBodyCache::SetMaxBytes(int64 InMaxBytes)
+{
+	MaxBytes = InMaxBytes;
+	EvictToBudget();
+}
+
+void FDevNoteBodyCache::Add(const FGuid& NoteId, const FString& Body, const FDateTime& LastEdited)
+{
+	Remove(NoteId);
+
+	const int64 Bytes = GetEntryBytes(Body);
+	if (Bytes > MaxBytes)
+	{
+		return;
+	}
+
+	const int32 Index = Entries.Add(FEntry());
+	FEntry& Entry = Entries[Index];
+	Entry.NoteId = NoteId;
+	Entry.Body = Body;
+	Entry.LastEdited = LastEdited;
+	EntryIndices.Add(NoteId, Index);
+	Link(Index);
+	UsedBytes += Bytes;
+
+	EvictToBudget();
+}
+
+bool FDevNoteBodyCache::TryGet(const FGuid& NoteId, const FDateTime& LastEdited, FString& OutBody)
+{
+	const int32* Index = EntryIndices.Find(NoteId);
+	if (!Index)
+	{
+		return false;
+	}
+
+	// Note was edited on the server since we fetched it
+	if (Entries[*Index].LastEdited < LastEdited)
+	{
+		RemoveAt(*Index);
+		return false;
+	}
+
+	if (*Index != Head)
+	{
+		Unlink(*Index);
+		Link(*Index);
+	}
+	OutBody = Entries[*Index].Body;
+	return true;
+}
+
+void FDevNoteBodyCache::Remove(const FGuid& NoteId)
+{
+	if (const int32* Index = EntryIndices.Find(NoteId))
+	{
+		RemoveAt(*Index);
+	}
+}
+
+void FDevNoteBodyCache::Empty()
+{
+	Entries.Empty();
+	EntryIndices.Empty();
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+	UsedBytes = 0;
+}
+
+void FDevNoteBodyCache::Link(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+	if (Head != INDEX_NONE)
+	{
+		Entries[Head].Prev = Index;
+	}
+	Head = Index;
+	if (Tail == INDEX_NONE)
+	{
+		Tail = Index;
+	}
+}
+
+void FDevNoteBodyCache::Unlink(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		Head = Entry.Next;
+	}
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+	else
+	{
+		Tail = Entry.Prev;
+	}
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+void FDevNoteBodyCache::RemoveAt(int32 Index)
+{
+	Unlink(Index);
+	UsedBytes -= GetEntryBytes(Entries[Index].Body);
+	EntryIndices.Remove(Entries[Index].NoteId);
+	Entries.RemoveAt(Index);
+}
+
+void FDevNoteBodyCache::EvictToBudget()
+{
+	while (UsedBytes > MaxBytes && Tail != INDEX_NONE)
+	{
+		RemoveAt(Tail);
+	}
+}
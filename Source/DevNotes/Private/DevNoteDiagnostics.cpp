@@ -0,0 +1,452 @@
+#include "DevNoteDiagnostics.h"
+
+#include "DevNoteSubsystem.h"
+#include "DevNotesLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+
+namespace DevNoteDiagnostics
+{
+	// Nothing is kept past this many of either kind, however busy the window was
+	static constexpr int32 MaxRecords = 20000;
+
+	// Chrome trace thread ids: stages on the game thread, each endpoint on a row of its own
+	static constexpr int32 GameThreadTrackId = 1;
+	static constexpr int32 FirstEndpointTrackId = 10;
+
+	static double Percentile(const TArray<double>& Sorted, double Fraction)
+	{
+		if (Sorted.IsEmpty())
+		{
+			return 0.0;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	static void Summarize(TArray<double>& DurationsMs, TArray<int64>& Bytes, FDevNoteLatencySummary& Out)
+	{
+		DurationsMs.Sort();
+		Out.Count = DurationsMs.Num();
+		Out.P50Ms = Percentile(DurationsMs, 0.50);
+		Out.P95Ms = Percentile(DurationsMs, 0.95);
+		Out.P99Ms = Percentile(DurationsMs, 0.99);
+		Out.MaxMs = DurationsMs.IsEmpty() ? 0.0 : DurationsMs.Last();
+
+		for (const double Ms : DurationsMs)
+		{
+			int32 Bucket = 0;
+			while (Bucket < FDevNoteLatencySummary::NumBuckets - 1 && Ms >= FDevNoteLatencySummary::BucketLimitsMs[Bucket])
+			{
+				++Bucket;
+			}
+			++Out.Histogram[Bucket];
+		}
+
+		if (!Bytes.IsEmpty())
+		{
+			Bytes.Sort();
+			Out.P50Bytes = Bytes[FMath::Clamp(FMath::CeilToInt32(0.50 * Bytes.Num()) - 1, 0, Bytes.Num() - 1)];
+			Out.P95Bytes = Bytes[FMath::Clamp(FMath::CeilToInt32(0.95 * Bytes.Num()) - 1, 0, Bytes.Num() - 1)];
+			Out.MaxBytes = Bytes.Last();
+		}
+	}
+
+	// Drop records older than OldestTime, and the oldest past MaxRecords. GetTime reads a record's time
+	template <typename RecordType, typename GetTimeType>
+	static void TrimFront(TRingBuffer<RecordType>& Records, double OldestTime, GetTimeType GetTime)
+	{
+		while (!Records.IsEmpty() && (Records.Num() > MaxRecords || GetTime(Records.First()) < OldestTime))
+		{
+			Records.PopFront();
+		}
+	}
+
+	// Routes are normalized, so this only guards against a server with unbounded paths
+	static constexpr int32 MaxFailedRequests = 256;
+
+	static FString MakeRequestKey(const FString& Verb, const FString& Route)
+	{
+		return Verb + TEXT(" ") + Route;
+	}
+
+	template <typename RangeType>
+	static FDevNoteLatencySummary SummarizeRequestRecords(const RangeType& Records, EDevNoteEndpoint Endpoint, double SinceTime)
+	{
+		FDevNoteLatencySummary Summary;
+		TArray<double> DurationsMs;
+		TArray<int64> Bytes;
+		for (const FDevNoteRequestRecord& Record : Records)
+		{
+			if (Record.Endpoint != Endpoint || Record.EndTime < SinceTime)
+			{
+				continue;
+			}
+
+			DurationsMs.Add((Record.EndTime - Record.StartTime) * 1000.0);
+			Bytes.Add(Endpoint == EDevNoteEndpoint::Mutations ? Record.BytesSent : Record.BytesReceived);
+			Summary.NumFailed += Record.bFailed ? 1 : 0;
+			Summary.NumRetried += Record.bRetry ? 1 : 0;
+		}
+
+		Summarize(DurationsMs, Bytes, Summary);
+		return Summary;
+	}
+
+	template <typename RangeType>
+	static FDevNoteLatencySummary SummarizeStageRecords(const RangeType& Records, EDevNoteStage Stage, double SinceTime)
+	{
+		FDevNoteLatencySummary Summary;
+		TArray<double> DurationsMs;
+		TArray<int64> Bytes;
+		for (const FDevNoteStageRecord& Record : Records)
+		{
+			if (Record.Stage == Stage && Record.EndTime >= SinceTime)
+			{
+				DurationsMs.Add((Record.EndTime - Record.StartTime) * 1000.0);
+			}
+		}
+
+		Summarize(DurationsMs, Bytes, Summary);
+		return Summary;
+	}
+
+	static void DumpTrace(const TArray<FString>& Args)
+	{
+		UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+		if (!Subsystem)
+		{
+			return;
+		}
+
+		const double Minutes = Args.Num() > 0 ? FCString::Atod(*Args[0]) : 5.0;
+		const FString Path = Subsystem->GetDiagnostics().DumpChromeTrace(Minutes);
+		if (!Path.IsEmpty())
+		{
+			UE_LOG(LogDevNotes, Display, TEXT("Wrote DevNotes trace to %s"), *Path);
+		}
+	}
+}
+
+FDevNoteDiagnostics::FScope::FScope(FDevNoteDiagnostics& InDiagnostics, EDevNoteStage InStage)
+	: Diagnostics(InDiagnostics)
+	, Stage(InStage)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+FDevNoteDiagnostics::FScope::~FScope()
+{
+	Diagnostics.AddStage(Stage, StartTime, FPlatformTime::Seconds());
+}
+
+FString FDevNoteDiagnostics::GetPathAndQuery(const FString& URL)
+{
+	const int32 SchemeEnd = URL.Find(TEXT("://"));
+	const int32 PathStart = URL.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, SchemeEnd == INDEX_NONE ? 0 : SchemeEnd + 3);
+	return PathStart == INDEX_NONE ? FString(TEXT("/")) : URL.Mid(PathStart);
+}
+
+FString FDevNoteDiagnostics::GetRequestRoute(const FString& URL)
+{
+	FString Path = GetPathAndQuery(URL);
+	int32 QueryStart = INDEX_NONE;
+	if (Path.FindChar(TEXT('?'), QueryStart))
+	{
+		Path.LeftInline(QueryStart);
+	}
+
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"));
+	FGuid Id;
+	for (FString& Segment : Segments)
+	{
+		if (FGuid::Parse(Segment, Id))
+		{
+			Segment = TEXT("{id}");
+		}
+	}
+	return TEXT("/") + FString::Join(Segments, TEXT("/"));
+}
+
+EDevNoteEndpoint FDevNoteDiagnostics::ClassifyRequest(const FString& Verb, const FString& Route)
+{
+	if (Route.StartsWith(TEXT("/signin")) || Route.StartsWith(TEXT("/signout")) || Route.StartsWith(TEXT("/validatetoken")))
+	{
+		return EDevNoteEndpoint::Auth;
+	}
+	if (Route.StartsWith(TEXT("/notes/query")))
+	{
+		return EDevNoteEndpoint::Query;
+	}
+	if (!Verb.Equals(TEXT("GET"), ESearchCase::IgnoreCase))
+	{
+		return EDevNoteEndpoint::Mutations;
+	}
+	if (Route.StartsWith(TEXT("/notes/")))
+	{
+		return EDevNoteEndpoint::NoteBodies;
+	}
+	if (Route.StartsWith(TEXT("/tags")))
+	{
+		return EDevNoteEndpoint::Tags;
+	}
+	if (Route.StartsWith(TEXT("/users")))
+	{
+		return EDevNoteEndpoint::Users;
+	}
+	return EDevNoteEndpoint::Notes;
+}
+
+const TCHAR* FDevNoteDiagnostics::GetEndpointName(EDevNoteEndpoint Endpoint)
+{
+	switch (Endpoint)
+	{
+	case EDevNoteEndpoint::Notes:		return TEXT("/notes");
+	case EDevNoteEndpoint::NoteBodies:	return TEXT("/notes/{id}");
+	case EDevNoteEndpoint::Tags:		return TEXT("/tags");
+	case EDevNoteEndpoint::Users:		return TEXT("/users");
+	case EDevNoteEndpoint::Query:		return TEXT("/notes/query");
+	case EDevNoteEndpoint::Mutations:	return TEXT("Mutations");
+	case EDevNoteEndpoint::Auth:		return TEXT("Auth");
+	default:							return TEXT("Unknown");
+	}
+}
+
+const TCHAR* FDevNoteDiagnostics::GetStageName(EDevNoteStage Stage)
+{
+	switch (Stage)
+	{
+	case EDevNoteStage::Parse:		return TEXT("Parse");
+	case EDevNoteStage::ApplyCache:	return TEXT("Apply To Cache");
+	case EDevNoteStage::RefreshWaypoints:	return TEXT("Reconcile Waypoints");
+	default:						return TEXT("Unknown");
+	}
+}
+
+void FDevNoteDiagnostics::BeginRequest()
+{
+	++RequestsInFlight;
+	DepthSamples.Emplace(FPlatformTime::Seconds(), RequestsInFlight);
+}
+
+void FDevNoteDiagnostics::EndRequest(FDevNoteRequestRecord&& Record)
+{
+	RequestsInFlight = FMath::Max(RequestsInFlight - 1, 0);
+	DepthSamples.Emplace(Record.EndTime, RequestsInFlight);
+	const FString Key = DevNoteDiagnostics::MakeRequestKey(Record.Verb, Record.Route);
+	if (Record.bFailed)
+	{
+		if (FailedRequests.Num() >= DevNoteDiagnostics::MaxFailedRequests)
+		{
+			FailedRequests.Reset();
+		}
+		FailedRequests.Add(Key);
+	}
+	else
+	{
+		FailedRequests.Remove(Key);
+	}
+	Requests.Add(MoveTemp(Record));
+	TrimToWindow(FPlatformTime::Seconds());
+}
+
+bool FDevNoteDiagnostics::DidLastAttemptFail(const FString& Verb, const FString& Route) const
+{
+	return FailedRequests.Contains(DevNoteDiagnostics::MakeRequestKey(Verb, Route));
+}
+
+void FDevNoteDiagnostics::AddStage(EDevNoteStage Stage, double StartTime, double EndTime)
+{
+	FDevNoteStageRecord& Record = Stages.Emplace();
+	Record.Stage = Stage;
+	Record.StartTime = StartTime;
+	Record.EndTime = EndTime;
+	TrimToWindow(EndTime);
+}
+
+void FDevNoteDiagnostics::TrimToWindow(double Now)
+{
+	const double OldestEndTime = Now - WindowSeconds;
+	DevNoteDiagnostics::TrimFront(Requests, OldestEndTime, [](const FDevNoteRequestRecord& Record) { return Record.EndTime; });
+	DevNoteDiagnostics::TrimFront(Stages, OldestEndTime, [](const FDevNoteStageRecord& Record) { return Record.EndTime; });
+	DevNoteDiagnostics::TrimFront(DepthSamples, OldestEndTime, [](const TPair<double, int32>& Sample) { return Sample.Key; });
+}
+
+int32 FDevNoteDiagnostics::GetPeakRequestsInFlight(double SinceTime) const
+{
+	int32 Peak = RequestsInFlight;
+	for (const TPair<double, int32>& Sample : DepthSamples)
+	{
+		if (Sample.Key >= SinceTime)
+		{
+			Peak = FMath::Max(Peak, Sample.Value);
+		}
+	}
+	return Peak;
+}
+
+FDevNoteLatencySummary FDevNoteDiagnostics::SummarizeRequests(EDevNoteEndpoint Endpoint, double SinceTime) const
+{
+	return DevNoteDiagnostics::SummarizeRequestRecords(Requests, Endpoint, SinceTime);
+}
+
+FDevNoteLatencySummary FDevNoteDiagnostics::SummarizeStage(EDevNoteStage Stage, double SinceTime) const
+{
+	return DevNoteDiagnostics::SummarizeStageRecords(Stages, Stage, SinceTime);
+}
+
+FDevNoteLatencySummary FDevNoteDiagnostics::SummarizeRequests(TArrayView<const FDevNoteRequestRecord> Records, EDevNoteEndpoint Endpoint, double SinceTime)
+{
+	return DevNoteDiagnostics::SummarizeRequestRecords(Records, Endpoint, SinceTime);
+}
+
+FDevNoteLatencySummary FDevNoteDiagnostics::SummarizeStage(TArrayView<const FDevNoteStageRecord> Records, EDevNoteStage Stage, double SinceTime)
+{
+	return DevNoteDiagnostics::SummarizeStageRecords(Records, Stage, SinceTime);
+}
+
+FString FDevNoteDiagnostics::ToChromeTrace(double SinceTime) const
+{
+	using namespace DevNoteDiagnostics;
+
+	// Timestamps are microseconds from the first event in the dump
+	double Origin = TNumericLimits<double>::Max();
+	for (const FDevNoteRequestRecord& Record : Requests)
+	{
+		if (Record.EndTime >= SinceTime)
+		{
+			Origin = FMath::Min(Origin, Record.StartTime);
+		}
+	}
+	for (const FDevNoteStageRecord& Record : Stages)
+	{
+		if (Record.EndTime >= SinceTime)
+		{
+			Origin = FMath::Min(Origin, Record.StartTime);
+		}
+	}
+	if (Origin == TNumericLimits<double>::Max())
+	{
+		Origin = SinceTime;
+	}
+	auto ToMicroseconds = [Origin](double Time) { return (Time - Origin) * 1000000.0; };
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("displayTimeUnit"), TEXT("ms"));
+	Writer->WriteArrayStart(TEXT("traceEvents"));
+
+	auto WriteThreadName = [&Writer](int32 TrackId, const FString& Name)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), TEXT("thread_name"));
+		Writer->WriteValue(TEXT("ph"), TEXT("M"));
+		Writer->WriteValue(TEXT("pid"), 1);
+		Writer->WriteValue(TEXT("tid"), TrackId);
+		Writer->WriteObjectStart(TEXT("args"));
+		Writer->WriteValue(TEXT("name"), Name);
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+	};
+	WriteThreadName(GameThreadTrackId, TEXT("Sync stages"));
+	for (int32 Endpoint = 0; Endpoint < static_cast<int32>(EDevNoteEndpoint::Num); ++Endpoint)
+	{
+		WriteThreadName(FirstEndpointTrackId + Endpoint, GetEndpointName(static_cast<EDevNoteEndpoint>(Endpoint)));
+	}
+
+	for (const FDevNoteRequestRecord& Record : Requests)
+	{
+		if (Record.EndTime < SinceTime)
+		{
+			continue;
+		}
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Record.Verb + TEXT(" ") + Record.Route);
+		Writer->WriteValue(TEXT("cat"), TEXT("request"));
+		Writer->WriteValue(TEXT("ph"), TEXT("X"));
+		Writer->WriteValue(TEXT("ts"), ToMicroseconds(Record.StartTime));
+		Writer->WriteValue(TEXT("dur"), (Record.EndTime - Record.StartTime) * 1000000.0);
+		Writer->WriteValue(TEXT("pid"), 1);
+		Writer->WriteValue(TEXT("tid"), FirstEndpointTrackId + static_cast<int32>(Record.Endpoint));
+		Writer->WriteObjectStart(TEXT("args"));
+		Writer->WriteValue(TEXT("code"), Record.ResponseCode);
+		Writer->WriteValue(TEXT("bytesSent"), Record.BytesSent);
+		Writer->WriteValue(TEXT("bytesReceived"), Record.BytesReceived);
+		Writer->WriteValue(TEXT("failed"), Record.bFailed);
+		Writer->WriteValue(TEXT("retry"), Record.bRetry);
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+	}
+
+	for (const FDevNoteStageRecord& Record : Stages)
+	{
+		if (Record.EndTime < SinceTime)
+		{
+			continue;
+		}
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), GetStageName(Record.Stage));
+		Writer->WriteValue(TEXT("cat"), TEXT("stage"));
+		Writer->WriteValue(TEXT("ph"), TEXT("X"));
+		Writer->WriteValue(TEXT("ts"), ToMicroseconds(Record.StartTime));
+		Writer->WriteValue(TEXT("dur"), (Record.EndTime - Record.StartTime) * 1000000.0);
+		Writer->WriteValue(TEXT("pid"), 1);
+		Writer->WriteValue(TEXT("tid"), GameThreadTrackId);
+		Writer->WriteObjectEnd();
+	}
+
+	for (const TPair<double, int32>& Sample : DepthSamples)
+	{
+		if (Sample.Key < SinceTime)
+		{
+			continue;
+		}
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), TEXT("Requests In Flight"));
+		Writer->WriteValue(TEXT("ph"), TEXT("C"));
+		Writer->WriteValue(TEXT("ts"), ToMicroseconds(Sample.Key));
+		Writer->WriteValue(TEXT("pid"), 1);
+		Writer->WriteObjectStart(TEXT("args"));
+		Writer->WriteValue(TEXT("requests"), Sample.Value);
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return Json;
+}
+
+FString FDevNoteDiagnostics::DumpChromeTrace(double Minutes) const
+{
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("DevNotes") / FString::Printf(TEXT("DevNotesTrace-%s.json"), *FDateTime::Now().ToString());
+	const FString Json = ToChromeTrace(FPlatformTime::Seconds() - Minutes * 60.0);
+	if (!FFileHelper::SaveStringToFile(Json, *Path))
+	{
+		UE_LOG(LogDevNotes, Error, TEXT("Could not write DevNotes trace to %s"), *Path);
+		return FString();
+	}
+	return FPaths::ConvertRelativePathToFull(Path);
+}
+
+void FDevNoteDiagnostics::Empty()
+{
+	Requests.Empty();
+	Stages.Empty();
+	DepthSamples.Empty();
+	FailedRequests.Empty();
+}
+
+static FAutoConsoleCommand GDevNotesDumpTraceCommand(
+	TEXT("DevNotes.Diagnostics.DumpTrace"),
+	TEXT("Writes the last minutes of DevNotes requests and sync stages to Saved/DevNotes as a Chrome trace.\n")
+	TEXT("Usage: DevNotes.Diagnostics.DumpTrace [Minutes=5]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DevNoteDiagnostics::DumpTrace));
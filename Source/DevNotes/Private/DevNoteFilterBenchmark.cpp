@@ -0,0 +1,156 @@
+﻿#include "DevNoteQuery.h"
+#include "DevNoteSearchIndex.h"
+#include "DevNotesLog.h"
+#include "DevNoteSyntheticData.h"
+#include "HAL/IConsoleManager.h"
+
+namespace DevNoteFilterBenchmark
+{
+	// Deterministic notes spread over a few hundred tags, users and levels
+	static void BuildIndex(int32 NumNotes, TArray<TSharedPtr<FDevNote>>& OutNotes, FDevNoteSearchIndex& OutIndex, int32 BodyWords = 0)
+	{
+		FDevNoteSyntheticDataParams Params;
+		Params.NumNotes = NumNotes;
+		Params.NumTags = 200;
+		Params.NumUsers = 50;
+		Params.NumLevels = 100;
+		Params.MaxTagsPerNote = 3;
+		Params.BodyWords = BodyWords;
+		FDevNoteSyntheticData Data = FDevNoteSyntheticData::Generate(Params);
+
+		OutNotes.Reset(NumNotes);
+		for (FDevNote& Note : Data.Notes)
+		{
+			OutNotes.Add(MakeShared<FDevNote>(MoveTemp(Note)));
+		}
+
+		OutIndex.SetTags(Data.Tags);
+		OutIndex.SetUsers(Data.Users);
+		OutIndex.RebuildNotes(OutNotes);
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumNotes = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50000;
+		FString FullQuery = TEXT("tag=bug map=zone04 crash");
+		if (Args.Num() > 1)
+		{
+			FullQuery.Reset();
+			for (int32 i = 1; i < Args.Num(); ++i)
+			{
+				FullQuery += (i > 1 ? TEXT(" ") : TEXT("")) + Args[i];
+			}
+		}
+
+		TArray<TSharedPtr<FDevNote>> Notes;
+		FDevNoteSearchIndex Index;
+		BuildIndex(NumNotes, Notes, Index);
+
+		// Replay the query as if typed one character at a time, the way the selector sees it,
+		// refining the previous results whenever the new query only narrows the old one
+		TOptional<FDevNoteQuery> Previous;
+		TArray<int32> Matches;
+		int32 NumRefined = 0;
+		double TotalMs = 0.0;
+		double WorstMs = 0.0;
+		for (int32 Len = 1; Len <= FullQuery.Len(); ++Len)
+		{
+			const double Start = FPlatformTime::Seconds();
+
+			FDevNoteQuery Query = FDevNoteQuery::Compile(FullQuery.Left(Len), Index);
+			const bool bRefine = Previous.IsSet() && !Previous->IsEmpty() && Query.IsNarrowingOf(*Previous);
+			TArray<int32> Candidates;
+			if (bRefine)
+			{
+				Candidates = MoveTemp(Matches);
+				++NumRefined;
+			}
+			Query.Evaluate(Index.GetEntries(), bRefine ? &Candidates : nullptr, Matches);
+			if (Query.IsRanked())
+			{
+				Query.SortByScore(Index.GetEntries(), Matches);
+			}
+
+			const double ElapsedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+			TotalMs += ElapsedMs;
+			WorstMs = FMath::Max(WorstMs, ElapsedMs);
+			UE_LOG(LogDevNotes, Display, TEXT("  '%s' -> %d notes in %.3f ms%s"), *FullQuery.Left(Len), Matches.Num(), ElapsedMs, bRefine ? TEXT(" (refined)") : TEXT(""));
+
+			Previous = MoveTemp(Query);
+		}
+
+		UE_LOG(LogDevNotes, Display, TEXT("Filter benchmark: %d notes, %d keystrokes, %d refined, avg %.3f ms, worst %.3f ms per keystroke"),
+			NumNotes, FullQuery.Len(), NumRefined, TotalMs / FMath::Max(1, FullQuery.Len()), WorstMs);
+	}
+
+	// What one note costs as the subsystem keeps it: its slot in the note array, the object MakeShared allocates along with
+	// its reference counts, and the title, body and tags. Level paths are FNames, which the engine interns already, so a soft
+	// pointer only allocates for a sub-object path, and level paths have none
+	static SIZE_T GetNoteSize(const FDevNote& Note)
+	{
+		constexpr SIZE_T ReferenceControllerBytes = 16;
+		return sizeof(TSharedPtr<FDevNote>) + ReferenceControllerBytes + sizeof(FDevNote)
+			+ Note.Title.GetAllocatedSize() + Note.Body.GetAllocatedSize() + Note.Tags.GetAllocatedSize();
+	}
+
+	// What one note's search entry cost when entries were an array of FDevNoteSearchEntry structs
+	static SIZE_T GetEntryStructSize(const FDevNoteSearchEntry& Entry)
+	{
+		return sizeof(FDevNoteSearchEntry) + Entry.Tags.GetAllocatedSize() + Entry.TitleLower.GetAllocatedSize()
+			+ Entry.LevelLower.GetAllocatedSize() + Entry.AuthorName.GetAllocatedSize() + Entry.LevelName.GetAllocatedSize();
+	}
+
+	static void ReportMemory(const TArray<FString>& Args)
+	{
+		const int32 NumNotes = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+		const int32 BodyWords = Args.Num() > 1 ? FMath::Max(0, FCString::Atoi(*Args[1])) : FDevNoteSyntheticDataParams().BodyWords;
+
+		TArray<TSharedPtr<FDevNote>> Notes;
+		FDevNoteSearchIndex Index;
+		BuildIndex(NumNotes, Notes, Index, BodyWords);
+
+		// The notes themselves were all there was before search entries existed, and they are still kept alongside them
+		SIZE_T NoteBytes = 0;
+		SIZE_T BodyBytes = 0;
+		for (const TSharedPtr<FDevNote>& Note : Notes)
+		{
+			NoteBytes += GetNoteSize(*Note);
+			BodyBytes += Note->Body.GetAllocatedSize();
+		}
+
+		const FDevNoteSearchEntries& Entries = Index.GetEntries();
+		SIZE_T StructBytes = 0;
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+		{
+			FDevNoteSearchEntry Entry = FDevNoteSearchEntry::Make(Entries.GetNote(EntryIndex));
+			Entry.AuthorName = Entries.GetAuthorName(EntryIndex);
+			StructBytes += GetEntryStructSize(Entry);
+		}
+		const SIZE_T ColumnBytes = Entries.GetAllocatedSize();
+
+		const double PerHundredThousand = 100000.0 / NumNotes / (1024.0 * 1024.0);
+		UE_LOG(LogDevNotes, Display, TEXT("Note memory: %d notes, %d body words, %d levels, %d users, %d tags"),
+			NumNotes, BodyWords, Entries.NumLevels(), Entries.NumUsers(), Entries.NumTags());
+		UE_LOG(LogDevNotes, Display, TEXT("  FDevNote objects: %.1f bytes per note, %.2f MB per 100k notes (%.2f MB of it bodies)"),
+			double(NoteBytes) / NumNotes, NoteBytes * PerHundredThousand, BodyBytes * PerHundredThousand);
+		UE_LOG(LogDevNotes, Display, TEXT("  search entries as one struct per note: %.1f bytes per note, %.2f MB per 100k notes"),
+			double(StructBytes) / NumNotes, StructBytes * PerHundredThousand);
+		UE_LOG(LogDevNotes, Display, TEXT("  search entries as columns: %.1f bytes per note, %.2f MB per 100k notes"),
+			double(ColumnBytes) / NumNotes, ColumnBytes * PerHundredThousand);
+		UE_LOG(LogDevNotes, Display, TEXT("  total: notes only %.2f MB, with entry structs %.2f MB, with columns %.2f MB per 100k notes (%+.0f%% over notes only)"),
+			NoteBytes * PerHundredThousand, (NoteBytes + StructBytes) * PerHundredThousand, (NoteBytes + ColumnBytes) * PerHundredThousand,
+			100.0 * ColumnBytes / FMath::Max<SIZE_T>(1, NoteBytes));
+	}
+}
+
+static FAutoConsoleCommand GDevNotesBenchmarkFilterCommand(
+	TEXT("DevNotes.BenchmarkFilter"),
+	TEXT("Times compiling and evaluating the selector filter for each keystroke of a query over synthetic notes.\n")
+	TEXT("Usage: DevNotes.BenchmarkFilter [NumNotes=50000] [Query...]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DevNoteFilterBenchmark::Run));
+
+static FAutoConsoleCommand GDevNotesMemoryReportCommand(
+	TEXT("DevNotes.MemoryReport"),
+	TEXT("Measures the memory synthetic notes take as FDevNote objects, and what their search entries add as one struct per note and as columns.\n")
+	TEXT("Usage: DevNotes.MemoryReport [NumNotes=100000] [BodyWords=40]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DevNoteFilterBenchmark::ReportMemory));
@@ -0,0 +1,83 @@
+#include "DevNotePrefixTrie.h"
+
+FDevNotePrefixTrie::FDevNotePrefixTrie()
+{
+	Nodes.AddDefaulted();
+}
+
+void FDevNotePrefixTrie::Add(const FString& KeyLower, int32 Item)
+{
+	for (int32 i = 0; i < KeyLower.Len(); ++i)
+	{
+		// Word starts, e.g. "testmap" in "/game/maps/testmap"
+		if (FChar::IsAlnum(KeyLower[i]) && (i == 0 || !FChar::IsAlnum(KeyLower[i - 1])))
+		{
+			Insert(FStringView(KeyLower).RightChop(i), Item);
+		}
+	}
+}
+
+void FDevNotePrefixTrie::Empty()
+{
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+}
+
+void FDevNotePrefixTrie::Insert(FStringView Suffix, int32 Item)
+{
+	int32 NodeIndex = 0;
+	for (const TCHAR Char : Suffix)
+	{
+		const int32* Child = Nodes[NodeIndex].Children.Find(Char);
+		if (Child)
+		{
+			NodeIndex = *Child;
+		}
+		else
+		{
+			// Adding may reallocate Nodes, so look the parent up again afterwards
+			const int32 NewIndex = Nodes.AddDefaulted();
+			Nodes[NodeIndex].Children.Add(Char, NewIndex);
+			NodeIndex = NewIndex;
+		}
+	}
+	Nodes[NodeIndex].Items.AddUnique(Item);
+}
+
+void FDevNotePrefixTrie::Find(FStringView PrefixLower, TArray<int32>& OutItems) const
+{
+	OutItems.Reset();
+
+	int32 NodeIndex = 0;
+	for (const TCHAR Char : PrefixLower)
+	{
+		const int32* Child = Nodes[NodeIndex].Children.Find(Char);
+		if (!Child)
+		{
+			return;
+		}
+		NodeIndex = *Child;
+	}
+
+	// The same key sits under several word starts, so keep track of what was already collected
+	TSet<int32> Seen;
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(NodeIndex);
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		for (const int32 Item : Node.Items)
+		{
+			bool bAlreadySeen = false;
+			Seen.Add(Item, &bAlreadySeen);
+			if (!bAlreadySeen)
+			{
+				OutItems.Add(Item);
+			}
+		}
+		for (const TPair<TCHAR, int32>& Child : Node.Children)
+		{
+			Stack.Add(Child.Value);
+		}
+	}
+}
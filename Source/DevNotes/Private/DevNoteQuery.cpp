@@ -0,0 +1,765 @@
+﻿#include "DevNoteQuery.h"
+
+#include "DevNoteSearchIndex.h"
+#include "DevNotesDeveloperSettings.h"
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
+#include "String/Find.h"
+
+namespace DevNoteQuery
+{
+	// Values are compared against lowercased fields. Empty values (still being typed) are skipped, the clause is off if none remain
+	static bool NormalizeValues(const TArray<FString>& InValues, TArray<FString>& OutValues)
+	{
+		OutValues.Reset(InValues.Num());
+		for (const FString& Value : InValues)
+		{
+			if (!Value.IsEmpty())
+			{
+				OutValues.Add(Value.ToLower());
+			}
+		}
+		return OutValues.Num() > 0;
+	}
+
+	// Each clause matched only through a corrected term costs this much score, scaled by how unlike the correction is
+	static constexpr float FuzzyPenalty = 10.0f;
+
+	static void ResolveIds(const TMap<FGuid, FString>& NamesLower, const TArray<FString>& Terms, TMap<FGuid, float>& OutIds)
+	{
+		for (const TPair<FGuid, FString>& Pair : NamesLower)
+		{
+			for (const FString& Term : Terms)
+			{
+				if (Pair.Value.Contains(Term, ESearchCase::CaseSensitive))
+				{
+					OutIds.Add(Pair.Key, 1.0f);
+					break;
+				}
+			}
+		}
+	}
+
+	static void ResolveFuzzyIds(const TMap<FGuid, FString>& NamesLower, const TArray<FDevNoteTrigramIndex::FMatch>& Corrections, TMap<FGuid, float>& OutIds)
+	{
+		for (const TPair<FGuid, FString>& Pair : NamesLower)
+		{
+			for (const FDevNoteTrigramIndex::FMatch& Correction : Corrections)
+			{
+				if (Pair.Value.Contains(Correction.Word, ESearchCase::CaseSensitive))
+				{
+					float& Relevance = OutIds.FindOrAdd(Pair.Key, 0.0f);
+					Relevance = FMath::Max(Relevance, Correction.Similarity);
+				}
+			}
+		}
+	}
+
+	// Corrections for every term no known word contains. Returns true if there were any
+	static bool FindCorrections(const FDevNoteTrigramIndex& Vocabulary, const TArray<FString>& Terms, float Threshold, TArray<FDevNoteTrigramIndex::FMatch>& OutCorrections)
+	{
+		OutCorrections.Reset();
+		TArray<FDevNoteTrigramIndex::FMatch> TermCorrections;
+		for (const FString& Term : Terms)
+		{
+			Vocabulary.FindCorrections(Term, Threshold, TermCorrections);
+			OutCorrections.Append(TermCorrections);
+		}
+		return OutCorrections.Num() > 0;
+	}
+
+	// Is every key of Keys also in Of?
+	static bool IsKeySubset(const TMap<FGuid, float>& Keys, const TMap<FGuid, float>& Of)
+	{
+		if (Keys.Num() > Of.Num())
+		{
+			return false;
+		}
+		for (const TPair<FGuid, float>& Pair : Keys)
+		{
+			if (!Of.Contains(Pair.Key))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// An age like 30m, 12h, 2d or 3w
+	static bool ParseAge(const FString& Value, FTimespan& OutAge)
+	{
+		if (Value.Len() < 2 || !FCString::IsNumeric(*Value.LeftChop(1)))
+		{
+			return false;
+		}
+
+		const double Amount = FCString::Atod(*Value.LeftChop(1));
+		switch (FChar::ToLower(Value[Value.Len() - 1]))
+		{
+		case TEXT('m'): OutAge = FTimespan::FromMinutes(Amount); return true;
+		case TEXT('h'): OutAge = FTimespan::FromHours(Amount); return true;
+		case TEXT('d'): OutAge = FTimespan::FromDays(Amount); return true;
+		case TEXT('w'): OutAge = FTimespan::FromDays(Amount * 7.0); return true;
+		default: return false;
+		}
+	}
+}
+
+void FDevNoteQuery::Tokenize(const FString& InStr, TArray<FString>& OutTokens)
+{
+	int32 Len = InStr.Len();
+	bool bInQuotes = false;
+	FString Current;
+	for (int32 i = 0; i < Len; ++i)
+	{
+		TCHAR C = InStr[i];
+		if (C == '\"')
+		{
+			bInQuotes = !bInQuotes;
+			continue;
+		}
+		if (!bInQuotes && FChar::IsWhitespace(C))
+		{
+			if (!Current.IsEmpty())
+			{
+				OutTokens.Add(Current);
+				Current.Empty();
+			}
+			continue;
+		}
+		Current.AppendChar(C);
+	}
+	if (!Current.IsEmpty()) OutTokens.Add(Current);
+}
+
+FDevNoteQuery FDevNoteQuery::Compile(const FString& QueryString, const FDevNoteSearchIndex& Index)
+{
+	return Compile(QueryString, Index, GetDefault<UDevNotesDeveloperSettings>()->FuzzyMatchThreshold);
+}
+
+FDevNoteQuery FDevNoteQuery::Compile(const FString& QueryString, const FDevNoteSearchIndex& Index, float FuzzyThreshold)
+{
+	FDevNoteQuery Query;
+	Query.SourceString = QueryString;
+
+	TArray<FString> Tokens;
+	Tokenize(QueryString, Tokens);
+
+	TMap<FString, TArray<FString>> FieldValues;
+	TArray<FString> GenericTerms;
+	const FDateTime UtcNow = FDateTime::UtcNow();
+	for (const FString& Token : Tokens)
+	{
+		if (ParseTimeTerm(Token, UtcNow, Query))
+		{
+			continue;
+		}
+
+		// Split into key value
+		FString Key, Value;
+		if (Token.Split(TEXT("="), &Key, &Value))
+		{
+			Key = Key.ToLower().TrimStartAndEnd();
+			Value = Value.TrimQuotes().TrimStartAndEnd();
+			FieldValues.FindOrAdd(Key).Add(Value);
+		}
+		else
+		{
+			// Generic (no key - wildcard)
+			GenericTerms.Add(Token.TrimQuotes().TrimStartAndEnd());
+		}
+	}
+
+	const FDevNoteTrigramIndex& Vocabulary = Index.GetVocabulary();
+	TArray<FString> Values;
+	TArray<FDevNoteTrigramIndex::FMatch> Corrections;
+
+	// Tag sets only take exact names: excluding a fuzzy correction would hide notes nobody asked to hide
+	if (const TArray<FString>* RequiredTags = FieldValues.Find(TEXT("+tag")))
+	{
+		for (const FString& Value : *RequiredTags)
+		{
+			if (DevNoteQuery::NormalizeValues({ Value }, Values))
+			{
+				FIdClause& Clause = Query.RequiredTagClauses.AddDefaulted_GetRef();
+				Clause.bActive = true;
+				DevNoteQuery::ResolveIds(Index.GetTagNamesLower(), Values, Clause.Ids);
+			}
+		}
+	}
+	if (const TArray<FString>* ExcludedTags = FieldValues.Find(TEXT("-tag")))
+	{
+		Query.ExcludedTagClause.bActive = DevNoteQuery::NormalizeValues(*ExcludedTags, Values);
+		if (Query.ExcludedTagClause.bActive)
+		{
+			DevNoteQuery::ResolveIds(Index.GetTagNamesLower(), Values, Query.ExcludedTagClause.Ids);
+		}
+	}
+
+	if (const TArray<FString>* Names = FieldValues.Find(TEXT("name")))
+	{
+		Query.NameClause.bActive = DevNoteQuery::NormalizeValues(*Names, Query.NameClause.Terms);
+		if (Query.NameClause.bActive)
+		{
+			Query.bFuzzy |= DevNoteQuery::FindCorrections(Vocabulary, Query.NameClause.Terms, FuzzyThreshold, Query.NameClause.FuzzyTerms);
+		}
+	}
+	if (const TArray<FString>* Maps = FieldValues.Find(TEXT("map")))
+	{
+		Query.MapClause.bActive = DevNoteQuery::NormalizeValues(*Maps, Query.MapClause.Terms);
+		if (Query.MapClause.bActive)
+		{
+			Query.bFuzzy |= DevNoteQuery::FindCorrections(Vocabulary, Query.MapClause.Terms, FuzzyThreshold, Query.MapClause.FuzzyTerms);
+		}
+	}
+	if (const TArray<FString>* Users = FieldValues.Find(TEXT("user")))
+	{
+		Query.UserClause.bActive = DevNoteQuery::NormalizeValues(*Users, Values);
+		if (Query.UserClause.bActive)
+		{
+			DevNoteQuery::ResolveIds(Index.GetUserNamesLower(), Values, Query.UserClause.Ids);
+			if (DevNoteQuery::FindCorrections(Vocabulary, Values, FuzzyThreshold, Corrections))
+			{
+				Query.bFuzzy = true;
+				DevNoteQuery::ResolveFuzzyIds(Index.GetUserNamesLower(), Corrections, Query.UserClause.Ids);
+			}
+		}
+	}
+	if (const TArray<FString>* Tags = FieldValues.Find(TEXT("tag")))
+	{
+		Query.TagClause.bActive = DevNoteQuery::NormalizeValues(*Tags, Values);
+		if (Query.TagClause.bActive)
+		{
+			DevNoteQuery::ResolveIds(Index.GetTagNamesLower(), Values, Query.TagClause.Ids);
+			if (DevNoteQuery::FindCorrections(Vocabulary, Values, FuzzyThreshold, Corrections))
+			{
+				Query.bFuzzy = true;
+				DevNoteQuery::ResolveFuzzyIds(Index.GetTagNamesLower(), Corrections, Query.TagClause.Ids);
+			}
+		}
+	}
+
+	if (const TArray<FString>* Bodies = FieldValues.Find(TEXT("body")))
+	{
+		// A value without any searchable words (e.g. a single letter while typing) doesn't narrow anything yet.
+		// Only that value is dropped, the clause stays on while any other value can be looked up
+		DevNoteQuery::NormalizeValues(*Bodies, Values);
+		for (const FString& Value : Values)
+		{
+			Query.BodyClause.bActive |= Index.GetTextIndex().Search(Value, FDevNoteTextIndex::EField::Body, Query.BodyClause.Scores);
+		}
+	}
+
+	Query.GenericClause.bActive = DevNoteQuery::NormalizeValues(GenericTerms, Query.GenericClause.Terms);
+	if (Query.GenericClause.bActive)
+	{
+		DevNoteQuery::ResolveIds(Index.GetUserNamesLower(), Query.GenericClause.Terms, Query.GenericUserIds);
+		DevNoteQuery::ResolveIds(Index.GetTagNamesLower(), Query.GenericClause.Terms, Query.GenericTagIds);
+		for (const FString& Term : Query.GenericClause.Terms)
+		{
+			Index.GetTextIndex().Search(Term, FDevNoteTextIndex::EField::Any, Query.GenericTextScores);
+		}
+
+		if (DevNoteQuery::FindCorrections(Vocabulary, Query.GenericClause.Terms, FuzzyThreshold, Query.GenericClause.FuzzyTerms))
+		{
+			Query.bFuzzy = true;
+			DevNoteQuery::ResolveFuzzyIds(Index.GetUserNamesLower(), Query.GenericClause.FuzzyTerms, Query.GenericUserIds);
+			DevNoteQuery::ResolveFuzzyIds(Index.GetTagNamesLower(), Query.GenericClause.FuzzyTerms, Query.GenericTagIds);
+		}
+	}
+
+	return Query;
+}
+
+bool FDevNoteQuery::ParseTimeBound(const FString& Token, const FDateTime& UtcNow, TOptional<FTimeBound>& OutBound)
+{
+	OutBound.Reset();
+
+	int32 OperatorIndex = INDEX_NONE;
+	if (!Token.FindChar(TEXT('<'), OperatorIndex) && !Token.FindChar(TEXT('>'), OperatorIndex))
+	{
+		return false;
+	}
+
+	FTimeBound Bound;
+	const FString Key = Token.Left(OperatorIndex).ToLower().TrimStartAndEnd();
+	if (Key == TEXT("created"))
+	{
+		Bound.Field = EDevNoteTimeField::Created;
+	}
+	else if (Key == TEXT("edited"))
+	{
+		Bound.Field = EDevNoteTimeField::LastEdited;
+	}
+	else
+	{
+		return false;
+	}
+
+	// A half typed value doesn't narrow anything yet
+	const bool bLess = Token[OperatorIndex] == TEXT('<');
+	const FString Value = Token.Mid(OperatorIndex + 1).TrimQuotes().TrimStartAndEnd();
+	FTimespan Age;
+	FDateTime Date;
+	if (DevNoteQuery::ParseAge(Value, Age))
+	{
+		// Less than an age ago means after that point in time
+		Bound.bUpper = !bLess;
+		Bound.Ticks = (UtcNow - Age).GetTicks();
+	}
+	else if (FDateTime::ParseIso8601(*Value, Date))
+	{
+		// Typed dates are local, note times are UTC. After a day means from the start of the next one, after a time right after it
+		const bool bDateOnly = !Value.Contains(TEXT("T"));
+		if (!bLess && bDateOnly)
+		{
+			Date += FTimespan::FromDays(1.0);
+		}
+		const int64 Ticks = Date.GetTicks() - (FDateTime::Now().GetTicks() - UtcNow.GetTicks());
+		Bound.bUpper = bLess;
+		Bound.Ticks = bLess || bDateOnly ? Ticks : Ticks + 1;
+	}
+	else
+	{
+		return true;
+	}
+
+	OutBound = Bound;
+	return true;
+}
+
+bool FDevNoteQuery::ParseTimeTerm(const FString& Token, const FDateTime& UtcNow, FDevNoteQuery& Query)
+{
+	TOptional<FTimeBound> Bound;
+	if (!ParseTimeBound(Token, UtcNow, Bound))
+	{
+		return false;
+	}
+	if (!Bound.IsSet())
+	{
+		return true;
+	}
+
+	FTimeClause& Clause = Bound->Field == EDevNoteTimeField::Created ? Query.CreatedClause : Query.EditedClause;
+	if (Bound->bUpper)
+	{
+		Clause.MaxTicks = FMath::Min(Clause.MaxTicks, Bound->Ticks);
+	}
+	else
+	{
+		Clause.MinTicks = FMath::Max(Clause.MinTicks, Bound->Ticks);
+	}
+	Clause.bActive = true;
+	return true;
+}
+
+bool FDevNoteQuery::FindTimeCandidates(const FDevNoteSearchEntries& Entries, TArray<int32>& OutCandidates) const
+{
+	// The narrower range gives the candidates, Matches checks the other one
+	TOptional<TArrayView<const int32>> Rows;
+	if (CreatedClause.bActive)
+	{
+		Rows = Entries.GetRowsInTimeRange(EDevNoteTimeField::Created, CreatedClause.MinTicks, CreatedClause.MaxTicks);
+	}
+	if (EditedClause.bActive)
+	{
+		const TArrayView<const int32> Edited = Entries.GetRowsInTimeRange(EDevNoteTimeField::LastEdited, EditedClause.MinTicks, EditedClause.MaxTicks);
+		if (!Rows.IsSet() || Edited.Num() < Rows->Num())
+		{
+			Rows = Edited;
+		}
+	}
+	if (!Rows.IsSet())
+	{
+		return false;
+	}
+
+	OutCandidates = *Rows;
+	OutCandidates.Sort();
+	return true;
+}
+
+bool FDevNoteQuery::IsEmpty() const
+{
+	return !NameClause.bActive && !MapClause.bActive && !UserClause.bActive && !TagClause.bActive && !BodyClause.bActive && !GenericClause.bActive
+		&& RequiredTagClauses.IsEmpty() && !ExcludedTagClause.bActive && !CreatedClause.bActive && !EditedClause.bActive;
+}
+
+FDevNoteQuery::FBoundQuery FDevNoteQuery::Bind(const FDevNoteSearchEntries& Entries) const
+{
+	FBoundQuery Bound;
+	Bound.MapRelevance.SetNumZeroed(Entries.NumLevels());
+	Bound.GenericLevelRelevance.SetNumZeroed(Entries.NumLevels());
+	for (int32 LevelIndex = 0; LevelIndex < Entries.NumLevels(); ++LevelIndex)
+	{
+		const FString& LevelLower = Entries.GetInternedLevelLower(LevelIndex);
+		if (MapClause.bActive) Bound.MapRelevance[LevelIndex] = MapClause.Relevance(LevelLower);
+		if (GenericClause.bActive) Bound.GenericLevelRelevance[LevelIndex] = GenericClause.Relevance(LevelLower);
+	}
+
+	Bound.UserRelevance.SetNumZeroed(Entries.NumUsers());
+	Bound.GenericUserRelevance.SetNumZeroed(Entries.NumUsers());
+	for (int32 UserIndex = 0; UserIndex < Entries.NumUsers(); ++UserIndex)
+	{
+		const FGuid& UserId = Entries.GetInternedUserId(UserIndex);
+		Bound.UserRelevance[UserIndex] = UserClause.Ids.FindRef(UserId);
+		Bound.GenericUserRelevance[UserIndex] = GenericUserIds.FindRef(UserId);
+	}
+
+	Bound.TagRelevance.SetNumZeroed(Entries.NumTags());
+	Bound.GenericTagRelevance.SetNumZeroed(Entries.NumTags());
+	for (int32 TagIndex = 0; TagIndex < Entries.NumTags(); ++TagIndex)
+	{
+		const FGuid& TagId = Entries.GetInternedTagId(TagIndex);
+		Bound.TagRelevance[TagIndex] = TagClause.Ids.FindRef(TagId);
+		Bound.GenericTagRelevance[TagIndex] = GenericTagIds.FindRef(TagId);
+	}
+
+	Bound.TagMask = MakeTagMask(Entries, TagClause.Ids);
+	Bound.GenericTagMask = MakeTagMask(Entries, GenericTagIds);
+	Bound.ExcludedTagMask = MakeTagMask(Entries, ExcludedTagClause.Ids);
+	for (const FIdClause& Clause : RequiredTagClauses)
+	{
+		Bound.RequiredTagMasks.Add(MakeTagMask(Entries, Clause.Ids));
+	}
+	return Bound;
+}
+
+TArray<uint64> FDevNoteQuery::MakeTagMask(const FDevNoteSearchEntries& Entries, const TMap<FGuid, float>& TagIds)
+{
+	TArray<uint64> Mask;
+	Mask.SetNumZeroed(Entries.GetTagWordsPerRow());
+	for (int32 TagIndex = 0; TagIndex < Entries.NumTags(); ++TagIndex)
+	{
+		if (TagIds.FindRef(Entries.GetInternedTagId(TagIndex)) > 0.0f)
+		{
+			Mask[TagIndex / 64] |= uint64(1) << (TagIndex % 64);
+		}
+	}
+	return Mask;
+}
+
+bool FDevNoteQuery::HasAnyTag(TArrayView<const uint64> NoteTags, const TArray<uint64>& Mask)
+{
+	// Rows are only a few words wide, so this stays branch free rather than stopping at the first hit
+	uint64 Any = 0;
+	for (int32 Word = 0; Word < NoteTags.Num(); ++Word)
+	{
+		Any |= NoteTags[Word] & Mask[Word];
+	}
+	return Any != 0;
+}
+
+float FDevNoteQuery::GetScore(const FDevNoteSearchEntries& Entries, int32 EntryIndex) const
+{
+	return GetScore(Entries, Bind(Entries), EntryIndex);
+}
+
+float FDevNoteQuery::GetScore(const FDevNoteSearchEntries& Entries, const FBoundQuery& Bound, int32 EntryIndex) const
+{
+	const FGuid& Id = Entries.GetId(EntryIndex);
+	float Score = 0.0f;
+	if (const float* BodyScore = BodyClause.Scores.Find(Id))
+	{
+		Score += *BodyScore;
+	}
+	if (const float* TextScore = GenericTextScores.Find(Id))
+	{
+		Score += *TextScore;
+	}
+
+	if (bFuzzy)
+	{
+		auto Penalize = [&Score](float Relevance)
+		{
+			Score -= (1.0f - Relevance) * DevNoteQuery::FuzzyPenalty;
+		};
+
+		const int32 LevelIndex = Entries.GetLevelIndex(EntryIndex);
+		const int32 AuthorIndex = Entries.GetAuthorIndex(EntryIndex);
+		const TArrayView<const uint16> Tags = Entries.GetTagIndices(EntryIndex);
+		if (NameClause.bActive) Penalize(NameClause.Relevance(Entries.GetTitleLower(EntryIndex)));
+		if (MapClause.bActive) Penalize(Bound.MapRelevance[LevelIndex]);
+		if (UserClause.bActive) Penalize(Bound.UserRelevance[AuthorIndex]);
+		if (TagClause.bActive) Penalize(BestTagIn(Tags, Bound.TagRelevance));
+		if (GenericClause.bActive)
+		{
+			const float TextRelevance = GenericTextScores.Contains(Id) ? 1.0f : 0.0f;
+			Penalize(FMath::Max(
+				FMath::Max(TextRelevance, Bound.GenericUserRelevance[AuthorIndex]),
+				FMath::Max3(BestTagIn(Tags, Bound.GenericTagRelevance), GenericClause.Relevance(Entries.GetTitleLower(EntryIndex)), Bound.GenericLevelRelevance[LevelIndex])));
+		}
+	}
+	return Score;
+}
+
+bool FDevNoteQuery::FTextClause::Matches(FStringView Lower) const
+{
+	for (const FString& Term : Terms)
+	{
+		if (UE::String::FindFirst(Lower, Term, ESearchCase::CaseSensitive) != INDEX_NONE)
+		{
+			return true;
+		}
+	}
+	for (const FDevNoteTrigramIndex::FMatch& Correction : FuzzyTerms)
+	{
+		if (UE::String::FindFirst(Lower, Correction.Word, ESearchCase::CaseSensitive) != INDEX_NONE)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+float FDevNoteQuery::FTextClause::Relevance(FStringView Lower) const
+{
+	for (const FString& Term : Terms)
+	{
+		if (UE::String::FindFirst(Lower, Term, ESearchCase::CaseSensitive) != INDEX_NONE)
+		{
+			return 1.0f;
+		}
+	}
+
+	// Corrections are sorted best first
+	for (const FDevNoteTrigramIndex::FMatch& Correction : FuzzyTerms)
+	{
+		if (UE::String::FindFirst(Lower, Correction.Word, ESearchCase::CaseSensitive) != INDEX_NONE)
+		{
+			return Correction.Similarity;
+		}
+	}
+	return 0.0f;
+}
+
+float FDevNoteQuery::BestTagIn(TArrayView<const uint16> NoteTags, const TArray<float>& TagRelevance)
+{
+	float Best = 0.0f;
+	for (const uint16 TagIndex : NoteTags)
+	{
+		Best = FMath::Max(Best, TagRelevance[TagIndex]);
+	}
+	return Best;
+}
+
+bool FDevNoteQuery::Matches(const FDevNoteSearchEntries& Entries, int32 EntryIndex) const
+{
+	return Matches(Entries, Bind(Entries), EntryIndex);
+}
+
+bool FDevNoteQuery::Matches(const FDevNoteSearchEntries& Entries, const FBoundQuery& Bound, int32 EntryIndex) const
+{
+	// Cheapest clauses first
+	if (CreatedClause.bActive && !CreatedClause.Contains(Entries.GetCreatedTicks(EntryIndex)))
+	{
+		return false;
+	}
+	if (EditedClause.bActive && !EditedClause.Contains(Entries.GetLastEditedTicks(EntryIndex)))
+	{
+		return false;
+	}
+	if (UserClause.bActive && Bound.UserRelevance[Entries.GetAuthorIndex(EntryIndex)] <= 0.0f)
+	{
+		return false;
+	}
+	const TArrayView<const uint64> TagBits = Entries.GetTagBits(EntryIndex);
+	if (TagClause.bActive && !HasAnyTag(TagBits, Bound.TagMask))
+	{
+		return false;
+	}
+	if (ExcludedTagClause.bActive && HasAnyTag(TagBits, Bound.ExcludedTagMask))
+	{
+		return false;
+	}
+	for (const TArray<uint64>& RequiredMask : Bound.RequiredTagMasks)
+	{
+		if (!HasAnyTag(TagBits, RequiredMask))
+		{
+			return false;
+		}
+	}
+	if (MapClause.bActive && Bound.MapRelevance[Entries.GetLevelIndex(EntryIndex)] <= 0.0f)
+	{
+		return false;
+	}
+	if (NameClause.bActive && !NameClause.Matches(Entries.GetTitleLower(EntryIndex)))
+	{
+		return false;
+	}
+	if (BodyClause.bActive && !BodyClause.Scores.Contains(Entries.GetId(EntryIndex)))
+	{
+		return false;
+	}
+
+	// Generic/wildcard terms: title, body, level, user or any tag
+	if (GenericClause.bActive)
+	{
+		const bool bAnyGeneric =
+			Bound.GenericUserRelevance[Entries.GetAuthorIndex(EntryIndex)] > 0.0f ||
+			Bound.GenericLevelRelevance[Entries.GetLevelIndex(EntryIndex)] > 0.0f ||
+			HasAnyTag(TagBits, Bound.GenericTagMask) ||
+			GenericTextScores.Contains(Entries.GetId(EntryIndex)) ||
+			GenericClause.Matches(Entries.GetTitleLower(EntryIndex));
+
+		if (!bAnyGeneric)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FDevNoteQuery::Evaluate(const FDevNoteSearchEntries& Entries, const TArray<int32>* Candidates, TArray<int32>& OutMatches, const std::atomic<bool>* bCancelled) const
+{
+	TArray<int32> TimeCandidates;
+	if (!Candidates && FindTimeCandidates(Entries, TimeCandidates))
+	{
+		Candidates = &TimeCandidates;
+	}
+
+	const int32 Num = Candidates ? Candidates->Num() : Entries.Num();
+	const FBoundQuery Bound = Bind(Entries);
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, EvaluateChunkSize);
+
+	// Each chunk collects its own matches, concatenated afterwards so results keep the entry order
+	TArray<TArray<int32>> ChunkMatches;
+	ChunkMatches.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		if (bCancelled && bCancelled->load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		const int32 Begin = ChunkIndex * EvaluateChunkSize;
+		const int32 End = FMath::Min(Begin + EvaluateChunkSize, Num);
+		TArray<int32>& Local = ChunkMatches[ChunkIndex];
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const int32 EntryIndex = Candidates ? (*Candidates)[i] : i;
+			if (Entries.IsValidIndex(EntryIndex) && Matches(Entries, Bound, EntryIndex))
+			{
+				Local.Add(EntryIndex);
+			}
+		}
+	}, NumChunks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	if (bCancelled && bCancelled->load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	int32 Total = 0;
+	for (const TArray<int32>& Local : ChunkMatches)
+	{
+		Total += Local.Num();
+	}
+	OutMatches.Reset(Total);
+	for (const TArray<int32>& Local : ChunkMatches)
+	{
+		OutMatches.Append(Local);
+	}
+	return true;
+}
+
+void FDevNoteQuery::SortByScore(const FDevNoteSearchEntries& Entries, TArray<int32>& InOutMatches) const
+{
+	// Scores are looked up once, not per comparison
+	const FBoundQuery Bound = Bind(Entries);
+	TArray<TPair<float, int32>> Ranked;
+	Ranked.Reserve(InOutMatches.Num());
+	for (const int32 EntryIndex : InOutMatches)
+	{
+		Ranked.Emplace(GetScore(Entries, Bound, EntryIndex), EntryIndex);
+	}
+
+	Algo::StableSort(Ranked, [](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	for (int32 i = 0; i < Ranked.Num(); ++i)
+	{
+		InOutMatches[i] = Ranked[i].Value;
+	}
+}
+
+bool FDevNoteQuery::IsNarrowingOf(const FDevNoteQuery& Previous) const
+{
+	// Every clause must match no more than Previous' one did. Corrections of a longer term can be words the shorter one never matched
+	if (bFuzzy || Previous.bFuzzy)
+	{
+		return false;
+	}
+
+	if (!NameClause.IsNarrowingOf(Previous.NameClause) || !MapClause.IsNarrowingOf(Previous.MapClause)
+		|| !UserClause.IsNarrowingOf(Previous.UserClause) || !TagClause.IsNarrowingOf(Previous.TagClause)
+		|| !BodyClause.IsNarrowingOf(Previous.BodyClause)
+		|| !CreatedClause.IsNarrowingOf(Previous.CreatedClause) || !EditedClause.IsNarrowingOf(Previous.EditedClause))
+	{
+		return false;
+	}
+
+	// Excluding more tags hides more notes, so the exclusions have to be a superset
+	if (Previous.ExcludedTagClause.bActive
+		&& (!ExcludedTagClause.bActive || !DevNoteQuery::IsKeySubset(Previous.ExcludedTagClause.Ids, ExcludedTagClause.Ids)))
+	{
+		return false;
+	}
+
+	for (const FIdClause& PreviousRequired : Previous.RequiredTagClauses)
+	{
+		if (!RequiredTagClauses.ContainsByPredicate([&PreviousRequired](const FIdClause& Required) { return Required.IsNarrowingOf(PreviousRequired); }))
+		{
+			return false;
+		}
+	}
+
+	// A generic term matches through any of its alternatives, each of which has to narrow
+	if (Previous.GenericClause.bActive)
+	{
+		if (!GenericClause.IsNarrowingOf(Previous.GenericClause)
+			|| !DevNoteQuery::IsKeySubset(GenericUserIds, Previous.GenericUserIds)
+			|| !DevNoteQuery::IsKeySubset(GenericTagIds, Previous.GenericTagIds)
+			|| !DevNoteQuery::IsKeySubset(GenericTextScores, Previous.GenericTextScores))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FDevNoteQuery::FTextClause::IsNarrowingOf(const FTextClause& Previous) const
+{
+	if (!Previous.bActive)
+	{
+		return true;
+	}
+	if (!bActive)
+	{
+		return false;
+	}
+
+	// Any text containing a longer term also contains the term it extends
+	for (const FString& Term : Terms)
+	{
+		if (!Previous.Terms.ContainsByPredicate([&Term](const FString& PreviousTerm) { return Term.Contains(PreviousTerm, ESearchCase::CaseSensitive); }))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FDevNoteQuery::FIdClause::IsNarrowingOf(const FIdClause& Previous) const
+{
+	return !Previous.bActive || (bActive && DevNoteQuery::IsKeySubset(Ids, Previous.Ids));
+}
+
+bool FDevNoteQuery::FScoreClause::IsNarrowingOf(const FScoreClause& Previous) const
+{
+	return !Previous.bActive || (bActive && DevNoteQuery::IsKeySubset(Scores, Previous.Scores));
+}
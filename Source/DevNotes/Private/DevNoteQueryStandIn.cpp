@@ -0,0 +1,141 @@
+#include "DevNoteServerQuery.h"
+#include "DevNoteSubsystem.h"
+#include "DevNotesLog.h"
+#include "FDevNoteTag.h"
+#include "FDevNoteUser.h"
+#include "HAL/IConsoleManager.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * A local stand-in for the server's POST /notes/query endpoint, answering from the notes this editor has synced.
+ * Only the query endpoint is served: set Query Server Address to http://localhost:<Port> to try server side filtering
+ * against it while everything else still goes to the real server.
+ */
+namespace DevNoteQueryStandIn
+{
+	static constexpr uint32 DefaultPort = 7125;
+
+	static TSharedPtr<IHttpRouter> Router;
+	static FHttpRouteHandle RouteHandle;
+
+	static bool HandleQuery(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		const FUTF8ToTCHAR Body(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Body.Length(), Body.Get()));
+		TSharedPtr<FJsonObject> QueryJson;
+		FDevNoteServerQuery Query;
+		if (!FJsonSerializer::Deserialize(Reader, QueryJson) || !FDevNoteServerQuery::FromJson(QueryJson, Query))
+		{
+			OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("InvalidQuery"), TEXT("Expected a note query object")));
+			return true;
+		}
+
+		UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+		if (!Subsystem)
+		{
+			OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::ServiceUnavail));
+			return true;
+		}
+
+		const FDevNoteSnapshotRef Snapshot = Subsystem->GetSnapshot();
+
+		// Summary syncs leave bodies out, so body words can't be matched and the answer would silently be incomplete
+		if (Query.ReadsBody())
+		{
+			int32 NumWithoutBody = 0;
+			Snapshot->ForEachNote([&NumWithoutBody](const FDevNote& Note) { NumWithoutBody += Note.bBodyLoaded ? 0 : 1; });
+			if (NumWithoutBody > 0)
+			{
+				UE_LOG(LogDevNotes, Verbose, TEXT("Query stand-in can't match bodies, %d notes were synced without one"), NumWithoutBody);
+				OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::NotImplemented, TEXT("BodiesNotSynced"),
+					TEXT("Body words and bare terms need full note sync, turn summary sync off")));
+				return true;
+			}
+		}
+
+		TMap<FGuid, FString> TagNamesLower;
+		for (const FDevNoteTag& Tag : Snapshot->Tags)
+		{
+			TagNamesLower.Add(Tag.Id, Tag.Name.ToLower());
+		}
+		TMap<FGuid, FString> UserNamesLower;
+		for (const FDevNoteUser& User : Snapshot->Users)
+		{
+			UserNamesLower.Add(User.Id, User.Name.ToLower());
+		}
+
+		TArray<TSharedPtr<FJsonValue>> NotesJson;
+		Snapshot->ForEachNote([&](const FDevNote& Note)
+		{
+			if (!Query.Matches(Note, TagNamesLower, UserNamesLower))
+			{
+				return;
+			}
+
+			TSharedPtr<FJsonObject> NoteJson = UDevNoteSubsystem::ConvertNoteToJsonObject(Note);
+			NoteJson->SetStringField(TEXT("lastEdited"), Note.LastEdited.ToIso8601());
+			if (Query.bSummary || !Note.bBodyLoaded)
+			{
+				NoteJson->RemoveField(TEXT("body"));
+			}
+			NotesJson.Add(MakeShared<FJsonValueObject>(NoteJson));
+		});
+
+		FString ResponseString;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
+		FJsonSerializer::Serialize(NotesJson, Writer);
+
+		UE_LOG(LogDevNotes, Verbose, TEXT("Query stand-in matched %d of %d notes"), NotesJson.Num(), Snapshot->NumNotes());
+		OnComplete(FHttpServerResponse::Create(ResponseString, TEXT("application/json")));
+		return true;
+	}
+
+	static void Stop()
+	{
+		if (Router.IsValid())
+		{
+			Router->UnbindRoute(RouteHandle);
+			Router.Reset();
+			RouteHandle.Reset();
+			UE_LOG(LogDevNotes, Display, TEXT("Query stand-in stopped"));
+		}
+	}
+
+	static void Start(const TArray<FString>& Args)
+	{
+		Stop();
+
+		const uint32 Port = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : DefaultPort;
+		FHttpServerModule& HttpServer = FHttpServerModule::Get();
+		Router = HttpServer.GetHttpRouter(Port, /* bFailOnBindFailure */ true);
+		if (!Router.IsValid())
+		{
+			UE_LOG(LogDevNotes, Error, TEXT("Query stand-in could not listen on port %u"), Port);
+			return;
+		}
+
+		RouteHandle = Router->BindRoute(FHttpPath(TEXT("/notes/query")), EHttpServerRequestVerbs::VERB_POST,
+			FHttpRequestHandler::CreateStatic(&HandleQuery));
+		HttpServer.StartAllListeners();
+		UE_LOG(LogDevNotes, Display, TEXT("Query stand-in serving POST http://localhost:%u/notes/query"), Port);
+	}
+}
+
+static FAutoConsoleCommand GDevNotesQueryStandInStartCommand(
+	TEXT("DevNotes.QueryStandIn.Start"),
+	TEXT("Serves the note query endpoint locally from the synced notes, for trying server side filtering.\n")
+	TEXT("Usage: DevNotes.QueryStandIn.Start [Port=7125]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DevNoteQueryStandIn::Start));
+
+static FAutoConsoleCommand GDevNotesQueryStandInStopCommand(
+	TEXT("DevNotes.QueryStandIn.Stop"),
+	TEXT("Stops the local note query endpoint."),
+	FConsoleCommandDelegate::CreateStatic(&DevNoteQueryStandIn::Stop));
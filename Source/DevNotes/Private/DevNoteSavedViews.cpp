@@ -0,0 +1,111 @@
+#include "DevNoteSavedViews.h"
+
+#include "DevNoteChangeSet.h"
+#include "DevNoteQuery.h"
+#include "DevNoteSearchIndex.h"
+
+void FDevNoteSavedViews::SetViews(TArray<FDevNoteSavedView>&& InViews, const FDevNoteSearchIndex& Index)
+{
+	Views = MoveTemp(InViews);
+	Rebuild(Index);
+}
+
+void FDevNoteSavedViews::Rebuild(const FDevNoteSearchIndex& Index)
+{
+	for (FDevNoteSavedView& View : Views)
+	{
+		Evaluate(Index, FDevNoteQuery::Compile(View.QueryString, Index), View);
+	}
+	IndexVersion = Index.GetVersion();
+}
+
+bool FDevNoteSavedViews::RefreshTimedViews(const FDevNoteSearchIndex& Index)
+{
+	bool bAnyTimed = false;
+	for (FDevNoteSavedView& View : Views)
+	{
+		const FDevNoteQuery Query = FDevNoteQuery::Compile(View.QueryString, Index);
+		if (Query.HasTimeClause())
+		{
+			Evaluate(Index, Query, View);
+			bAnyTimed = true;
+		}
+	}
+	return bAnyTimed;
+}
+
+void FDevNoteSavedViews::Evaluate(const FDevNoteSearchIndex& Index, const FDevNoteQuery& Query, FDevNoteSavedView& View) const
+{
+	const FDevNoteSearchEntries& Entries = Index.GetEntries();
+
+	TArray<int32> Matches;
+	Query.Evaluate(Entries, nullptr, Matches);
+
+	View.NoteIds.Reset();
+	View.NoteIds.Reserve(Matches.Num());
+	for (const int32 EntryIndex : Matches)
+	{
+		View.NoteIds.Add(Entries.GetId(EntryIndex));
+	}
+}
+
+void FDevNoteSavedViews::ApplyNoteChanges(const FDevNoteSearchIndex& Index, const FDevNoteChangeSet& Changes)
+{
+	const FDevNoteSearchEntries& Entries = Index.GetEntries();
+
+	TArray<int32> Candidates;
+	Candidates.Reserve(Changes.Added.Num() + Changes.Changed.Num());
+	for (const TArray<FGuid>* Ids : { &Changes.Added, &Changes.Changed })
+	{
+		for (const FGuid& NoteId : *Ids)
+		{
+			const int32 EntryIndex = Index.FindEntryIndex(NoteId);
+			if (EntryIndex != INDEX_NONE)
+			{
+				Candidates.Add(EntryIndex);
+			}
+		}
+	}
+
+	TArray<int32> Matches;
+	for (FDevNoteSavedView& View : Views)
+	{
+		for (const TArray<FGuid>* Ids : { &Changes.Changed, &Changes.Removed })
+		{
+			for (const FGuid& NoteId : *Ids)
+			{
+				View.NoteIds.Remove(NoteId);
+			}
+		}
+
+		if (Candidates.IsEmpty())
+		{
+			continue;
+		}
+
+		// Text terms resolve against the text index when compiled, which the sync just updated
+		const FDevNoteQuery Query = FDevNoteQuery::Compile(View.QueryString, Index);
+		Matches.Reset();
+		Query.Evaluate(Entries, &Candidates, Matches);
+		for (const int32 EntryIndex : Matches)
+		{
+			View.NoteIds.Add(Entries.GetId(EntryIndex));
+		}
+	}
+	IndexVersion = Index.GetVersion();
+}
+
+const FDevNoteSavedView* FDevNoteSavedViews::FindByName(const FString& Name) const
+{
+	return Views.FindByPredicate([&Name](const FDevNoteSavedView& View) { return View.Name.Equals(Name, ESearchCase::IgnoreCase); });
+}
+
+const FDevNoteSavedView* FDevNoteSavedViews::FindByQuery(const FString& QueryString) const
+{
+	return Views.FindByPredicate([&QueryString](const FDevNoteSavedView& View) { return View.QueryString.Equals(QueryString, ESearchCase::CaseSensitive); });
+}
+
+bool FDevNoteSavedViews::IsCurrent(const FDevNoteSearchIndex& Index) const
+{
+	return IndexVersion == Index.GetVersion();
+}
@@ -0,0 +1,261 @@
+#include "DevNoteSearchEntries.h"
+
+#include "Algo/BinarySearch.h"
+
+FDevNoteSearchEntry FDevNoteSearchEntry::Make(const TSharedPtr<FDevNote>& InNote)
+{
+	FDevNoteSearchEntry Entry;
+	Entry.Note = InNote;
+	if (InNote.IsValid())
+	{
+		Entry.Id = InNote->Id;
+		Entry.CreatedById = InNote->CreatedById;
+		Entry.Tags = InNote->Tags;
+		Entry.TitleLower = InNote->Title.ToLower();
+		Entry.LevelLower = InNote->LevelPath.ToString().ToLower();
+		Entry.LevelName = InNote->LevelPath.GetAssetName();
+		Entry.CreatedAt = InNote->CreatedAt;
+		Entry.LastEdited = InNote->LastEdited;
+		Entry.WorldPosition = InNote->WorldPosition;
+	}
+	return Entry;
+}
+
+void FDevNoteSearchEntries::Reserve(int32 NumRows)
+{
+	Notes.Reserve(NumRows);
+	Ids.Reserve(NumRows);
+	TitlesLower.Reserve(NumRows, NumRows * 32);
+	LevelIndices.Reserve(NumRows);
+	AuthorIndices.Reserve(NumRows);
+	TagIndices.Reserve(NumRows, NumRows * 2);
+	TagBits.Reserve(NumRows * TagWordsPerRow);
+	CreatedTicks.Reserve(NumRows);
+	LastEditedTicks.Reserve(NumRows);
+	WorldPositions.Reserve(NumRows);
+	RowsByCreated.Reserve(NumRows);
+	RowsByLastEdited.Reserve(NumRows);
+}
+
+int32 FDevNoteSearchEntries::Add(const FDevNoteSearchEntry& Entry)
+{
+	const int32 Row = AddRow(Entry);
+	InsertTimeOrder(Row);
+	return Row;
+}
+
+void FDevNoteSearchEntries::Append(TArrayView<const FDevNoteSearchEntry> NewEntries)
+{
+	Reserve(Num() + NewEntries.Num());
+	for (const FDevNoteSearchEntry& Entry : NewEntries)
+	{
+		const int32 Row = AddRow(Entry);
+		RowsByCreated.Add(Row);
+		RowsByLastEdited.Add(Row);
+	}
+
+	RowsByCreated.Sort([this](int32 A, int32 B) { return CreatedTicks[A] < CreatedTicks[B]; });
+	RowsByLastEdited.Sort([this](int32 A, int32 B) { return LastEditedTicks[A] < LastEditedTicks[B]; });
+}
+
+int32 FDevNoteSearchEntries::AddRow(const FDevNoteSearchEntry& Entry)
+{
+	TArray<uint16, TInlineAllocator<16>> Tags;
+	InternTags(Entry.Tags, Tags);
+
+	const int32 Row = Ids.Add(Entry.Id);
+	Notes.Add(Entry.Note);
+	TitlesLower.Add(MakeArrayView(*Entry.TitleLower, Entry.TitleLower.Len()));
+	LevelIndices.Add(InternLevel(Entry));
+	AuthorIndices.Add(InternUser(Entry.CreatedById, Entry.AuthorName));
+	TagIndices.Add(Tags);
+	TagBits.AddZeroed(TagWordsPerRow);
+	SetTagBits(Row, Tags);
+	CreatedTicks.Add(Entry.CreatedAt.GetTicks());
+	LastEditedTicks.Add(Entry.LastEdited.GetTicks());
+	WorldPositions.Add(FVector3f(Entry.WorldPosition));
+	return Row;
+}
+
+void FDevNoteSearchEntries::Set(int32 Row, const FDevNoteSearchEntry& Entry)
+{
+	TArray<uint16, TInlineAllocator<16>> Tags;
+	InternTags(Entry.Tags, Tags);
+
+	RemoveTimeOrder(Row);
+	Ids[Row] = Entry.Id;
+	Notes[Row] = Entry.Note;
+	TitlesLower.Set(Row, MakeArrayView(*Entry.TitleLower, Entry.TitleLower.Len()));
+	LevelIndices[Row] = InternLevel(Entry);
+	AuthorIndices[Row] = InternUser(Entry.CreatedById, Entry.AuthorName);
+	TagIndices.Set(Row, Tags);
+	SetTagBits(Row, Tags);
+	CreatedTicks[Row] = Entry.CreatedAt.GetTicks();
+	LastEditedTicks[Row] = Entry.LastEdited.GetTicks();
+	WorldPositions[Row] = FVector3f(Entry.WorldPosition);
+	InsertTimeOrder(Row);
+}
+
+void FDevNoteSearchEntries::RemoveAtSwap(int32 Row)
+{
+	// The last row is renamed to Row in the time orders, its time doesn't change
+	RemoveTimeOrder(Row);
+	const int32 LastRowBefore = Ids.Num() - 1;
+	if (Row != LastRowBefore)
+	{
+		RowsByCreated[FindInTimeOrder(RowsByCreated, CreatedTicks, LastRowBefore)] = Row;
+		RowsByLastEdited[FindInTimeOrder(RowsByLastEdited, LastEditedTicks, LastRowBefore)] = Row;
+	}
+
+	Ids.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+	Notes.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+	TitlesLower.RemoveAtSwap(Row);
+	LevelIndices.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+	AuthorIndices.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+	TagIndices.RemoveAtSwap(Row);
+	const int32 LastRow = Ids.Num();
+	if (Row != LastRow)
+	{
+		FMemory::Memcpy(TagBits.GetData() + Row * TagWordsPerRow, TagBits.GetData() + LastRow * TagWordsPerRow, TagWordsPerRow * sizeof(uint64));
+	}
+	TagBits.SetNum(LastRow * TagWordsPerRow, EAllowShrinking::No);
+	CreatedTicks.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+	LastEditedTicks.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+	WorldPositions.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+}
+
+TArrayView<const int32> FDevNoteSearchEntries::GetRowsInTimeRange(EDevNoteTimeField Field, int64 MinTicks, int64 MaxTicks) const
+{
+	const TArray<int32>& Order = Field == EDevNoteTimeField::Created ? RowsByCreated : RowsByLastEdited;
+	const TArray<int64>& Ticks = Field == EDevNoteTimeField::Created ? CreatedTicks : LastEditedTicks;
+	auto TicksOf = [&Ticks](int32 Row) { return Ticks[Row]; };
+
+	const int32 Begin = Algo::LowerBoundBy(Order, MinTicks, TicksOf);
+	const int32 End = Algo::LowerBoundBy(Order, MaxTicks, TicksOf);
+	return End > Begin ? TArrayView<const int32>(Order.GetData() + Begin, End - Begin) : TArrayView<const int32>();
+}
+
+void FDevNoteSearchEntries::SetUserNames(const TMap<FGuid, FString>& Names)
+{
+	for (int32 UserIndex = 0; UserIndex < UserIds.Num(); ++UserIndex)
+	{
+		UserNames[UserIndex] = Names.FindRef(UserIds[UserIndex]);
+	}
+}
+
+SIZE_T FDevNoteSearchEntries::GetAllocatedSize() const
+{
+	SIZE_T Size = Notes.GetAllocatedSize() + Ids.GetAllocatedSize() + TitlesLower.GetAllocatedSize()
+		+ LevelIndices.GetAllocatedSize() + AuthorIndices.GetAllocatedSize() + TagIndices.GetAllocatedSize() + TagBits.GetAllocatedSize()
+		+ CreatedTicks.GetAllocatedSize() + LastEditedTicks.GetAllocatedSize() + WorldPositions.GetAllocatedSize()
+		+ RowsByCreated.GetAllocatedSize() + RowsByLastEdited.GetAllocatedSize();
+
+	Size += LevelsLower.GetAllocatedSize() + LevelNames.GetAllocatedSize() + LevelIndexByPath.GetAllocatedSize();
+	for (int32 LevelIndex = 0; LevelIndex < LevelsLower.Num(); ++LevelIndex)
+	{
+		// The map key is a second copy of the path
+		Size += LevelsLower[LevelIndex].GetAllocatedSize() * 2 + LevelNames[LevelIndex].GetAllocatedSize();
+	}
+
+	Size += UserIds.GetAllocatedSize() + UserNames.GetAllocatedSize() + UserIndexById.GetAllocatedSize();
+	for (const FString& Name : UserNames)
+	{
+		Size += Name.GetAllocatedSize();
+	}
+
+	Size += TagIds.GetAllocatedSize() + TagIndexById.GetAllocatedSize();
+	return Size;
+}
+
+int32 FDevNoteSearchEntries::InternLevel(const FDevNoteSearchEntry& Entry)
+{
+	if (const int32* Existing = LevelIndexByPath.Find(Entry.LevelLower))
+	{
+		return *Existing;
+	}
+	LevelNames.Add(Entry.LevelName);
+	const int32 LevelIndex = LevelsLower.Add(Entry.LevelLower);
+	LevelIndexByPath.Add(Entry.LevelLower, LevelIndex);
+	return LevelIndex;
+}
+
+int32 FDevNoteSearchEntries::InternUser(const FGuid& UserId, const FString& Name)
+{
+	if (const int32* Existing = UserIndexById.Find(UserId))
+	{
+		return *Existing;
+	}
+	UserNames.Add(Name);
+	const int32 UserIndex = UserIds.Add(UserId);
+	UserIndexById.Add(UserId, UserIndex);
+	return UserIndex;
+}
+
+void FDevNoteSearchEntries::InternTags(const TArray<FGuid>& Tags, TArray<uint16, TInlineAllocator<16>>& OutIndices)
+{
+	OutIndices.Reset(Tags.Num());
+	for (const FGuid& TagId : Tags)
+	{
+		const int32* Existing = TagIndexById.Find(TagId);
+		int32 TagIndex = Existing ? *Existing : INDEX_NONE;
+		if (!Existing)
+		{
+			if (!ensureMsgf(TagIds.Num() <= MAX_uint16, TEXT("More distinct tags than a note row can refer to, ignoring %s"), *TagId.ToString()))
+			{
+				continue;
+			}
+			TagIndex = TagIds.Add(TagId);
+			TagIndexById.Add(TagId, TagIndex);
+			if (TagIndex >= TagWordsPerRow * 64)
+			{
+				WidenTagBits(TagWordsPerRow + 1);
+			}
+		}
+		// A note lists each tag once, so group lists built from rows never see the same row twice under one tag
+		OutIndices.AddUnique(static_cast<uint16>(TagIndex));
+	}
+}
+
+void FDevNoteSearchEntries::InsertTimeOrder(int32 Row)
+{
+	RowsByCreated.Insert(Row, Algo::UpperBoundBy(RowsByCreated, CreatedTicks[Row], [this](int32 Other) { return CreatedTicks[Other]; }));
+	RowsByLastEdited.Insert(Row, Algo::UpperBoundBy(RowsByLastEdited, LastEditedTicks[Row], [this](int32 Other) { return LastEditedTicks[Other]; }));
+}
+
+void FDevNoteSearchEntries::RemoveTimeOrder(int32 Row)
+{
+	RowsByCreated.RemoveAt(FindInTimeOrder(RowsByCreated, CreatedTicks, Row), 1, EAllowShrinking::No);
+	RowsByLastEdited.RemoveAt(FindInTimeOrder(RowsByLastEdited, LastEditedTicks, Row), 1, EAllowShrinking::No);
+}
+
+int32 FDevNoteSearchEntries::FindInTimeOrder(const TArray<int32>& Order, const TArray<int64>& Ticks, int32 Row)
+{
+	int32 Position = Algo::LowerBoundBy(Order, Ticks[Row], [&Ticks](int32 Other) { return Ticks[Other]; });
+	while (Order[Position] != Row)
+	{
+		++Position;
+	}
+	return Position;
+}
+
+void FDevNoteSearchEntries::SetTagBits(int32 Row, TArrayView<const uint16> Tags)
+{
+	uint64* Words = TagBits.GetData() + Row * TagWordsPerRow;
+	FMemory::Memzero(Words, TagWordsPerRow * sizeof(uint64));
+	for (const uint16 TagIndex : Tags)
+	{
+		Words[TagIndex / 64] |= uint64(1) << (TagIndex % 64);
+	}
+}
+
+void FDevNoteSearchEntries::WidenTagBits(int32 NewWordsPerRow)
+{
+	TArray<uint64> Widened;
+	Widened.SetNumZeroed(Ids.Num() * NewWordsPerRow);
+	for (int32 Row = 0; Row < Ids.Num(); ++Row)
+	{
+		FMemory::Memcpy(Widened.GetData() + Row * NewWordsPerRow, TagBits.GetData() + Row * TagWordsPerRow, TagWordsPerRow * sizeof(uint64));
+	}
+	TagBits = MoveTemp(Widened);
+	TagWordsPerRow = NewWordsPerRow;
+}
@@ -0,0 +1,384 @@
+﻿#include "DevNoteSearchIndex.h"
+
+#include "FDevNoteTag.h"
+#include "FDevNoteUser.h"
+#include "Algo/AllOf.h"
+#include "Algo/Sort.h"
+
+FDevNoteSearchIndex::FDevNoteSearchIndex()
+	: Entries(MakeShared<FDevNoteSearchEntries, ESPMode::ThreadSafe>())
+{
+}
+
+void FDevNoteSearchIndex::RebuildNotes(const TArray<TSharedPtr<FDevNote>>& Notes)
+{
+	TArray<FDevNoteSearchEntry> Rows;
+	Rows.Reserve(Notes.Num());
+	for (const TSharedPtr<FDevNote>& Note : Notes)
+	{
+		if (Note.IsValid())
+		{
+			Rows.Add(MakeEntry(Note));
+		}
+	}
+
+	TSharedRef<FDevNoteSearchEntries, ESPMode::ThreadSafe> NewEntries = MakeShared<FDevNoteSearchEntries, ESPMode::ThreadSafe>();
+	NewEntries->Append(Rows);
+	Rows.Empty();
+
+	TMap<FGuid, int32> OldEntryIndexById = MoveTemp(EntryIndexById);
+	EntryIndexById.Reset();
+	EntryIndexById.Reserve(NewEntries->Num());
+
+	for (int32 EntryIndex = 0; EntryIndex < NewEntries->Num(); ++EntryIndex)
+	{
+		const FGuid& NoteId = NewEntries->GetId(EntryIndex);
+		EntryIndexById.Add(NoteId, EntryIndex);
+
+		// Only re-tokenize notes whose title or level changed
+		int32 OldEntryIndex = INDEX_NONE;
+		if (OldEntryIndexById.RemoveAndCopyValue(NoteId, OldEntryIndex))
+		{
+			if (Entries->GetTitleLower(OldEntryIndex).Equals(NewEntries->GetTitleLower(EntryIndex), ESearchCase::CaseSensitive)
+				&& Entries->GetLevelLower(OldEntryIndex).Equals(NewEntries->GetLevelLower(EntryIndex), ESearchCase::CaseSensitive))
+			{
+				continue;
+			}
+			RemoveEntryWords(*Entries, OldEntryIndex);
+		}
+		AddEntryWords(*NewEntries, EntryIndex);
+	}
+
+	// Whatever is left wasn't in this sync
+	for (const TPair<FGuid, int32>& Removed : OldEntryIndexById)
+	{
+		RemoveEntryWords(*Entries, Removed.Value);
+	}
+	Entries = NewEntries;
+
+	EntriesByLevel.Reset();
+	EntriesByTag.Reset();
+	NoteCountByUser.Reset();
+	for (int32 EntryIndex = 0; EntryIndex < Entries->Num(); ++EntryIndex)
+	{
+		AddToGroups(EntryIndex);
+	}
+
+	// The new entries interned their levels from scratch
+	LevelTrie.Empty();
+	NumLevelsInTrie = 0;
+	SyncLevelTrie();
+
+	// Only notes whose title or body changed get re-tokenized
+	TextIndex.SyncNotes(Notes);
+	++Version;
+}
+
+void FDevNoteSearchIndex::UpdateNote(const TSharedPtr<FDevNote>& Note)
+{
+	if (!Note.IsValid()) return;
+
+	// Someone is still filtering the old entries, leave those alone
+	if (!Entries.IsUnique())
+	{
+		Entries = MakeShared<FDevNoteSearchEntries, ESPMode::ThreadSafe>(*Entries);
+	}
+
+	if (const int32* Existing = EntryIndexById.Find(Note->Id))
+	{
+		RemoveEntryWords(*Entries, *Existing);
+		RemoveFromGroups(*Existing);
+		Entries->Set(*Existing, MakeEntry(Note));
+		AddEntryWords(*Entries, *Existing);
+		AddToGroups(*Existing);
+	}
+	else
+	{
+		const int32 EntryIndex = Entries->Add(MakeEntry(Note));
+		EntryIndexById.Add(Note->Id, EntryIndex);
+		AddEntryWords(*Entries, EntryIndex);
+		AddToGroups(EntryIndex);
+	}
+	SyncLevelTrie();
+	TextIndex.UpdateNote(*Note);
+	++Version;
+}
+
+void FDevNoteSearchIndex::RemoveNote(const FGuid& NoteId)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!EntryIndexById.RemoveAndCopyValue(NoteId, EntryIndex))
+	{
+		return;
+	}
+
+	if (!Entries.IsUnique())
+	{
+		Entries = MakeShared<FDevNoteSearchEntries, ESPMode::ThreadSafe>(*Entries);
+	}
+
+	RemoveEntryWords(*Entries, EntryIndex);
+	RemoveFromGroups(EntryIndex);
+
+	const int32 LastIndex = Entries->Num() - 1;
+	if (EntryIndex != LastIndex)
+	{
+		RemoveFromGroups(LastIndex);
+	}
+	Entries->RemoveAtSwap(EntryIndex);
+	if (EntryIndex != LastIndex)
+	{
+		EntryIndexById.Add(Entries->GetId(EntryIndex), EntryIndex);
+		AddToGroups(EntryIndex);
+	}
+
+	TextIndex.RemoveNote(NoteId);
+	++Version;
+}
+
+void FDevNoteSearchIndex::SetTags(const TArray<FDevNoteTag>& Tags)
+{
+	for (const TPair<FGuid, FString>& Pair : TagNamesLower)
+	{
+		Vocabulary.RemoveText(Pair.Value);
+	}
+
+	TagNamesLower.Reset();
+	TagNamesLower.Reserve(Tags.Num());
+	TagTrie.Empty();
+	TagTrieItems.Reset(Tags.Num());
+	for (const FDevNoteTag& Tag : Tags)
+	{
+		const FString& NameLower = TagNamesLower.Add(Tag.Id, Tag.Name.ToLower());
+		Vocabulary.AddText(NameLower);
+		TagTrie.Add(NameLower, TagTrieItems.Emplace(Tag.Id, Tag.Name));
+	}
+	++Version;
+}
+
+void FDevNoteSearchIndex::SetUsers(const TArray<FDevNoteUser>& Users)
+{
+	// Users are polled with every sync and rarely change. Same users, same names: nothing to copy
+	const bool bUnchanged = UserNames.Num() == Users.Num() && Algo::AllOf(Users, [this](const FDevNoteUser& User)
+	{
+		const FString* Name = UserNames.Find(User.Id);
+		return Name && Name->Equals(User.Name, ESearchCase::CaseSensitive);
+	});
+	if (bUnchanged)
+	{
+		return;
+	}
+
+	for (const TPair<FGuid, FString>& Pair : UserNamesLower)
+	{
+		Vocabulary.RemoveText(Pair.Value);
+	}
+
+	UserNamesLower.Reset();
+	UserNamesLower.Reserve(Users.Num());
+	UserNames.Reset();
+	UserNames.Reserve(Users.Num());
+	UserTrie.Empty();
+	UserTrieItems.Reset(Users.Num());
+	for (const FDevNoteUser& User : Users)
+	{
+		const FString& NameLower = UserNamesLower.Add(User.Id, User.Name.ToLower());
+		Vocabulary.AddText(NameLower);
+		UserNames.Add(User.Id, User.Name);
+		UserTrie.Add(NameLower, UserTrieItems.Emplace(User.Id, User.Name));
+	}
+
+	// Authors are resolved into the entries, which a filter task may still be reading
+	TSharedRef<FDevNoteSearchEntries, ESPMode::ThreadSafe> NewEntries = MakeShared<FDevNoteSearchEntries, ESPMode::ThreadSafe>(*Entries);
+	NewEntries->SetUserNames(UserNames);
+	Entries = NewEntries;
+	++Version;
+}
+
+void FDevNoteSearchIndex::Empty()
+{
+	Entries = MakeShared<FDevNoteSearchEntries, ESPMode::ThreadSafe>();
+	EntryIndexById.Empty();
+	TagNamesLower.Empty();
+	UserNamesLower.Empty();
+	UserNames.Empty();
+	TextIndex.Empty();
+	Vocabulary.Empty();
+	EntriesByLevel.Empty();
+	EntriesByTag.Empty();
+	NoteCountByUser.Empty();
+	TagTrie.Empty();
+	UserTrie.Empty();
+	LevelTrie.Empty();
+	TagTrieItems.Empty();
+	UserTrieItems.Empty();
+	NumLevelsInTrie = 0;
+	++Version;
+}
+
+FDevNoteSearchEntry FDevNoteSearchIndex::MakeEntry(const TSharedPtr<FDevNote>& Note) const
+{
+	FDevNoteSearchEntry Entry = FDevNoteSearchEntry::Make(Note);
+	Entry.AuthorName = UserNames.FindRef(Entry.CreatedById);
+	return Entry;
+}
+
+void FDevNoteSearchIndex::AddEntryWords(const FDevNoteSearchEntries& InEntries, int32 EntryIndex)
+{
+	Vocabulary.AddText(FString(InEntries.GetTitleLower(EntryIndex)));
+	Vocabulary.AddText(InEntries.GetLevelLower(EntryIndex));
+}
+
+void FDevNoteSearchIndex::RemoveEntryWords(const FDevNoteSearchEntries& InEntries, int32 EntryIndex)
+{
+	Vocabulary.RemoveText(FString(InEntries.GetTitleLower(EntryIndex)));
+	Vocabulary.RemoveText(InEntries.GetLevelLower(EntryIndex));
+}
+
+void FDevNoteSearchIndex::AddToGroups(int32 EntryIndex)
+{
+	EntriesByLevel.FindOrAdd(Entries->GetLevelLower(EntryIndex)).Add(EntryIndex);
+	++NoteCountByUser.FindOrAdd(Entries->GetAuthorId(EntryIndex));
+	const TArrayView<const uint16> Tags = Entries->GetTagIndices(EntryIndex);
+	if (Tags.IsEmpty())
+	{
+		EntriesByTag.FindOrAdd(FGuid()).Add(EntryIndex);
+	}
+	for (const uint16 TagIndex : Tags)
+	{
+		EntriesByTag.FindOrAdd(Entries->GetInternedTagId(TagIndex)).Add(EntryIndex);
+	}
+}
+
+void FDevNoteSearchIndex::RemoveFromGroups(int32 EntryIndex)
+{
+	auto RemoveFrom = [EntryIndex](auto& Groups, const auto& Key)
+	{
+		if (TArray<int32>* Group = Groups.Find(Key))
+		{
+			Group->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+			if (Group->IsEmpty())
+			{
+				Groups.Remove(Key);
+			}
+		}
+	};
+
+	RemoveFrom(EntriesByLevel, Entries->GetLevelLower(EntryIndex));
+
+	const FGuid& AuthorId = Entries->GetAuthorId(EntryIndex);
+	if (int32* Count = NoteCountByUser.Find(AuthorId))
+	{
+		if (--*Count == 0)
+		{
+			NoteCountByUser.Remove(AuthorId);
+		}
+	}
+
+	const TArrayView<const uint16> Tags = Entries->GetTagIndices(EntryIndex);
+	if (Tags.IsEmpty())
+	{
+		RemoveFrom(EntriesByTag, FGuid());
+	}
+	for (const uint16 TagIndex : Tags)
+	{
+		RemoveFrom(EntriesByTag, Entries->GetInternedTagId(TagIndex));
+	}
+}
+
+int32 FDevNoteSearchIndex::FindEntryIndex(const FGuid& NoteId) const
+{
+	const int32* Index = EntryIndexById.Find(NoteId);
+	return Index ? *Index : INDEX_NONE;
+}
+
+void FDevNoteSearchIndex::SyncLevelTrie()
+{
+	for (; NumLevelsInTrie < Entries->NumLevels(); ++NumLevelsInTrie)
+	{
+		LevelTrie.Add(Entries->GetInternedLevelName(NumLevelsInTrie).ToLower(), NumLevelsInTrie);
+	}
+}
+
+void FDevNoteSearchIndex::Suggest(EDevNoteSuggestionField Field, FStringView PrefixLower, int32 MaxSuggestions,
+	TArray<FDevNoteSuggestion>& OutSuggestions) const
+{
+	if (MaxSuggestions <= 0)
+	{
+		return;
+	}
+
+	const FDevNotePrefixTrie& Trie = Field == EDevNoteSuggestionField::Tag ? TagTrie
+		: Field == EDevNoteSuggestionField::User ? UserTrie
+		: LevelTrie;
+	TArray<int32> Items;
+	Trie.Find(PrefixLower, Items);
+
+	// Every match is counted before any is dropped, a popular name can sit anywhere in the trie
+	TArray<FDevNoteSuggestion> Candidates;
+	Candidates.Reserve(Items.Num());
+	TMap<FString, int32> LevelCandidateByName;
+	for (const int32 Item : Items)
+	{
+		FDevNoteSuggestion Suggestion;
+		Suggestion.Field = Field;
+		switch (Field)
+		{
+		case EDevNoteSuggestionField::Tag:
+			if (const TArray<int32>* Group = EntriesByTag.Find(TagTrieItems[Item].Key))
+			{
+				Suggestion.Value = TagTrieItems[Item].Value;
+				Suggestion.NoteCount = Group->Num();
+			}
+			break;
+		case EDevNoteSuggestionField::User:
+			Suggestion.Value = UserTrieItems[Item].Value;
+			Suggestion.NoteCount = NoteCountByUser.FindRef(UserTrieItems[Item].Key);
+			break;
+		case EDevNoteSuggestionField::Level:
+			if (const TArray<int32>* Group = EntriesByLevel.Find(Entries->GetInternedLevelLower(Item)))
+			{
+				// Map= matches paths by substring, so levels of the same name in different folders complete to one value.
+				// FString keys compare case-insensitively
+				const FString& LevelName = Entries->GetInternedLevelName(Item);
+				if (const int32* SameName = LevelCandidateByName.Find(LevelName))
+				{
+					Candidates[*SameName].NoteCount += Group->Num();
+					continue;
+				}
+				LevelCandidateByName.Add(LevelName, Candidates.Num());
+				Suggestion.Value = LevelName;
+				Suggestion.NoteCount = Group->Num();
+			}
+			break;
+		}
+
+		if (Suggestion.NoteCount > 0)
+		{
+			Candidates.Add(MoveTemp(Suggestion));
+		}
+	}
+
+	// Keep the best MaxSuggestions in a heap with the worst kept one on top
+	auto IsWorse = [](const FDevNoteSuggestion& A, const FDevNoteSuggestion& B)
+	{
+		return A.NoteCount != B.NoteCount ? A.NoteCount < B.NoteCount : A.Value > B.Value;
+	};
+	TArray<FDevNoteSuggestion> Best;
+	Best.Reserve(FMath::Min(MaxSuggestions, Candidates.Num()) + 1);
+	for (FDevNoteSuggestion& Candidate : Candidates)
+	{
+		if (Best.Num() < MaxSuggestions)
+		{
+			Best.HeapPush(MoveTemp(Candidate), IsWorse);
+		}
+		else if (IsWorse(Best.HeapTop(), Candidate))
+		{
+			Best.HeapPopDiscard(IsWorse, EAllowShrinking::No);
+			Best.HeapPush(MoveTemp(Candidate), IsWorse);
+		}
+	}
+
+	Algo::Sort(Best, [&IsWorse](const FDevNoteSuggestion& A, const FDevNoteSuggestion& B) { return IsWorse(B, A); });
+	OutSuggestions.Append(MoveTemp(Best));
+}
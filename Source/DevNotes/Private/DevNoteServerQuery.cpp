@@ -0,0 +1,349 @@
+#include "DevNoteServerQuery.h"
+
+#include "DevNoteQuery.h"
+#include "Algo/AllOf.h"
+#include "Algo/AnyOf.h"
+#include "Algo/NoneOf.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace DevNoteServerQuery
+{
+	// Fields a clause may name, in the order clauses are sent
+	static const TCHAR* const AnyFields[] = { TEXT("name"), TEXT("map"), TEXT("user"), TEXT("tag"), TEXT("body") };
+
+	static const TCHAR* MatchToString(FDevNoteServerQuery::EMatch Match)
+	{
+		switch (Match)
+		{
+		case FDevNoteServerQuery::EMatch::All: return TEXT("all");
+		case FDevNoteServerQuery::EMatch::None: return TEXT("none");
+		default: return TEXT("any");
+		}
+	}
+
+	static bool MatchFromString(const FString& String, FDevNoteServerQuery::EMatch& OutMatch)
+	{
+		if (String == TEXT("any")) { OutMatch = FDevNoteServerQuery::EMatch::Any; return true; }
+		if (String == TEXT("all")) { OutMatch = FDevNoteServerQuery::EMatch::All; return true; }
+		if (String == TEXT("none")) { OutMatch = FDevNoteServerQuery::EMatch::None; return true; }
+		return false;
+	}
+
+	// Lowercase the values. Like the local query, empty values (still being typed) are skipped
+	static bool NormalizeValues(const TArray<FString>& InValues, TArray<FString>& OutValues)
+	{
+		OutValues.Reset(InValues.Num());
+		for (const FString& Value : InValues)
+		{
+			if (!Value.IsEmpty())
+			{
+				OutValues.Add(Value.ToLower());
+			}
+		}
+		return OutValues.Num() > 0;
+	}
+
+	static void RangeToJson(const FDevNoteServerQuery::FRange& Range, const TCHAR* Name, FJsonObject& Json)
+	{
+		if (!Range.IsSet())
+		{
+			return;
+		}
+
+		TSharedRef<FJsonObject> RangeJson = MakeShared<FJsonObject>();
+		if (Range.MinTicks != MIN_int64)
+		{
+			RangeJson->SetStringField(TEXT("from"), FDateTime(Range.MinTicks).ToIso8601());
+		}
+		if (Range.MaxTicks != MAX_int64)
+		{
+			RangeJson->SetStringField(TEXT("to"), FDateTime(Range.MaxTicks).ToIso8601());
+		}
+		Json.SetObjectField(Name, RangeJson);
+	}
+
+	static bool RangeFromJson(const FJsonObject& Json, const TCHAR* Name, FDevNoteServerQuery::FRange& OutRange)
+	{
+		const TSharedPtr<FJsonObject>* RangeJson = nullptr;
+		if (!Json.TryGetObjectField(Name, RangeJson))
+		{
+			return true;
+		}
+
+		FString Time;
+		FDateTime Parsed;
+		if ((*RangeJson)->TryGetStringField(TEXT("from"), Time))
+		{
+			if (!FDateTime::ParseIso8601(*Time, Parsed)) return false;
+			OutRange.MinTicks = Parsed.GetTicks();
+		}
+		if ((*RangeJson)->TryGetStringField(TEXT("to"), Time))
+		{
+			if (!FDateTime::ParseIso8601(*Time, Parsed)) return false;
+			OutRange.MaxTicks = Parsed.GetTicks();
+		}
+		return true;
+	}
+
+	// Does a word of Text start with Prefix? Both lowercased
+	static bool ContainsWordPrefix(const FString& Text, const FString& Prefix)
+	{
+		for (int32 Start = Text.Find(Prefix, ESearchCase::CaseSensitive); Start != INDEX_NONE;
+			Start = Text.Find(Prefix, ESearchCase::CaseSensitive, ESearchDir::FromStart, Start + 1))
+		{
+			if (Start == 0 || !FChar::IsAlnum(Text[Start - 1]))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+bool FDevNoteServerQuery::IsEmpty() const
+{
+	return Clauses.IsEmpty() && Terms.IsEmpty() && !Created.IsSet() && !Edited.IsSet();
+}
+
+bool FDevNoteServerQuery::ReadsBody() const
+{
+	return !Terms.IsEmpty() || Clauses.ContainsByPredicate([](const FClause& Clause) { return Clause.Field == TEXT("body"); });
+}
+
+FDevNoteServerQuery FDevNoteServerQuery::Translate(const FString& QueryString, const FDateTime& UtcNow)
+{
+	FDevNoteServerQuery Query;
+
+	TArray<FString> Tokens;
+	FDevNoteQuery::Tokenize(QueryString, Tokens);
+
+	TMap<FString, TArray<FString>> FieldValues;
+	TArray<FString> GenericTerms;
+	for (const FString& Token : Tokens)
+	{
+		TOptional<FDevNoteQuery::FTimeBound> Bound;
+		if (FDevNoteQuery::ParseTimeBound(Token, UtcNow, Bound))
+		{
+			if (Bound.IsSet())
+			{
+				FRange& Range = Bound->Field == EDevNoteTimeField::Created ? Query.Created : Query.Edited;
+				if (Bound->bUpper)
+				{
+					Range.MaxTicks = FMath::Min(Range.MaxTicks, Bound->Ticks);
+				}
+				else
+				{
+					Range.MinTicks = FMath::Max(Range.MinTicks, Bound->Ticks);
+				}
+			}
+			continue;
+		}
+
+		FString Key, Value;
+		if (Token.Split(TEXT("="), &Key, &Value))
+		{
+			FieldValues.FindOrAdd(Key.ToLower().TrimStartAndEnd()).Add(Value.TrimQuotes().TrimStartAndEnd());
+		}
+		else
+		{
+			GenericTerms.Add(Token.TrimQuotes().TrimStartAndEnd());
+		}
+	}
+
+	// Repeating a field ORs its values
+	TArray<FString> Values;
+	for (const TCHAR* Field : DevNoteServerQuery::AnyFields)
+	{
+		const TArray<FString>* FieldTerms = FieldValues.Find(Field);
+		if (FieldTerms && DevNoteServerQuery::NormalizeValues(*FieldTerms, Values))
+		{
+			Query.Clauses.Add({ Field, EMatch::Any, Values });
+		}
+	}
+
+	// Each +tag stands on its own, so one still being typed doesn't drop the others
+	if (const TArray<FString>* RequiredTags = FieldValues.Find(TEXT("+tag")))
+	{
+		FClause Clause{ TEXT("tag"), EMatch::All, {} };
+		for (const FString& Value : *RequiredTags)
+		{
+			if (!Value.IsEmpty())
+			{
+				Clause.Values.Add(Value.ToLower());
+			}
+		}
+		if (!Clause.Values.IsEmpty())
+		{
+			Query.Clauses.Add(MoveTemp(Clause));
+		}
+	}
+	if (const TArray<FString>* ExcludedTags = FieldValues.Find(TEXT("-tag")))
+	{
+		if (DevNoteServerQuery::NormalizeValues(*ExcludedTags, Values))
+		{
+			Query.Clauses.Add({ TEXT("tag"), EMatch::None, Values });
+		}
+	}
+
+	if (DevNoteServerQuery::NormalizeValues(GenericTerms, Values))
+	{
+		Query.Terms = Values;
+	}
+	return Query;
+}
+
+TSharedRef<FJsonObject> FDevNoteServerQuery::ToJson() const
+{
+	TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+
+	TArray<TSharedPtr<FJsonValue>> ClausesJson;
+	for (const FClause& Clause : Clauses)
+	{
+		TSharedRef<FJsonObject> ClauseJson = MakeShared<FJsonObject>();
+		ClauseJson->SetStringField(TEXT("field"), Clause.Field);
+		ClauseJson->SetStringField(TEXT("match"), DevNoteServerQuery::MatchToString(Clause.Match));
+
+		TArray<TSharedPtr<FJsonValue>> ValuesJson;
+		for (const FString& Value : Clause.Values)
+		{
+			ValuesJson.Add(MakeShared<FJsonValueString>(Value));
+		}
+		ClauseJson->SetArrayField(TEXT("values"), ValuesJson);
+		ClausesJson.Add(MakeShared<FJsonValueObject>(ClauseJson));
+	}
+	Json->SetArrayField(TEXT("clauses"), ClausesJson);
+
+	TArray<TSharedPtr<FJsonValue>> TermsJson;
+	for (const FString& Term : Terms)
+	{
+		TermsJson.Add(MakeShared<FJsonValueString>(Term));
+	}
+	Json->SetArrayField(TEXT("terms"), TermsJson);
+
+	DevNoteServerQuery::RangeToJson(Created, TEXT("created"), *Json);
+	DevNoteServerQuery::RangeToJson(Edited, TEXT("edited"), *Json);
+	Json->SetBoolField(TEXT("summary"), bSummary);
+	return Json;
+}
+
+FString FDevNoteServerQuery::ToJsonString() const
+{
+	FString OutputString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(ToJson(), Writer);
+	return OutputString;
+}
+
+bool FDevNoteServerQuery::FromJson(const TSharedPtr<FJsonObject>& Json, FDevNoteServerQuery& OutQuery)
+{
+	OutQuery = FDevNoteServerQuery();
+	if (!Json.IsValid())
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* ClausesJson = nullptr;
+	if (Json->TryGetArrayField(TEXT("clauses"), ClausesJson))
+	{
+		for (const TSharedPtr<FJsonValue>& ClauseValue : *ClausesJson)
+		{
+			const TSharedPtr<FJsonObject>* ClauseJson = nullptr;
+			FString MatchString;
+			const TArray<TSharedPtr<FJsonValue>>* ValuesJson = nullptr;
+			FClause& Clause = OutQuery.Clauses.AddDefaulted_GetRef();
+			if (!ClauseValue->TryGetObject(ClauseJson)
+				|| !(*ClauseJson)->TryGetStringField(TEXT("field"), Clause.Field)
+				|| !(*ClauseJson)->TryGetStringField(TEXT("match"), MatchString)
+				|| !DevNoteServerQuery::MatchFromString(MatchString, Clause.Match)
+				|| !(*ClauseJson)->TryGetArrayField(TEXT("values"), ValuesJson))
+			{
+				return false;
+			}
+			for (const TSharedPtr<FJsonValue>& Value : *ValuesJson)
+			{
+				Clause.Values.Add(Value->AsString().ToLower());
+			}
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* TermsJson = nullptr;
+	if (Json->TryGetArrayField(TEXT("terms"), TermsJson))
+	{
+		for (const TSharedPtr<FJsonValue>& Term : *TermsJson)
+		{
+			OutQuery.Terms.Add(Term->AsString().ToLower());
+		}
+	}
+
+	Json->TryGetBoolField(TEXT("summary"), OutQuery.bSummary);
+	return DevNoteServerQuery::RangeFromJson(*Json, TEXT("created"), OutQuery.Created)
+		&& DevNoteServerQuery::RangeFromJson(*Json, TEXT("edited"), OutQuery.Edited);
+}
+
+bool FDevNoteServerQuery::Matches(const FDevNote& Note, const TMap<FGuid, FString>& TagNamesLower, const TMap<FGuid, FString>& UserNamesLower) const
+{
+	if (!Created.Contains(Note.CreatedAt.GetTicks()) || !Edited.Contains(Note.LastEdited.GetTicks()))
+	{
+		return false;
+	}
+
+	const FString TitleLower = Note.Title.ToLower();
+	const FString LevelLower = Note.LevelPath.ToString().ToLower();
+	const FString BodyLower = Note.Body.ToLower();
+	const FString* AuthorLower = UserNamesLower.Find(Note.CreatedById);
+	TArray<const FString*, TInlineAllocator<8>> TagsLower;
+	for (const FGuid& TagId : Note.Tags)
+	{
+		if (const FString* TagLower = TagNamesLower.Find(TagId))
+		{
+			TagsLower.Add(TagLower);
+		}
+	}
+
+	auto AnyTagContains = [&TagsLower](const FString& Value)
+	{
+		return TagsLower.ContainsByPredicate([&Value](const FString* Tag) { return Tag->Contains(Value, ESearchCase::CaseSensitive); });
+	};
+	auto FieldMatches = [&](const FString& Field, const FString& Value)
+	{
+		if (Field == TEXT("name")) return TitleLower.Contains(Value, ESearchCase::CaseSensitive);
+		if (Field == TEXT("map")) return LevelLower.Contains(Value, ESearchCase::CaseSensitive);
+		if (Field == TEXT("user")) return AuthorLower && AuthorLower->Contains(Value, ESearchCase::CaseSensitive);
+		if (Field == TEXT("tag")) return AnyTagContains(Value);
+		if (Field == TEXT("body")) return DevNoteServerQuery::ContainsWordPrefix(BodyLower, Value);
+		return false;
+	};
+
+	for (const FClause& Clause : Clauses)
+	{
+		auto ValueMatches = [&FieldMatches, &Clause](const FString& Value) { return FieldMatches(Clause.Field, Value); };
+		const bool bMatches = Clause.Match == EMatch::All ? Algo::AllOf(Clause.Values, ValueMatches)
+			: Clause.Match == EMatch::None ? Algo::NoneOf(Clause.Values, ValueMatches)
+			: Algo::AnyOf(Clause.Values, ValueMatches);
+		if (!bMatches)
+		{
+			return false;
+		}
+	}
+
+	if (Terms.IsEmpty())
+	{
+		return true;
+	}
+	for (const FString& Term : Terms)
+	{
+		if (TitleLower.Contains(Term, ESearchCase::CaseSensitive)
+			|| LevelLower.Contains(Term, ESearchCase::CaseSensitive)
+			|| DevNoteServerQuery::ContainsWordPrefix(BodyLower, Term)
+			|| (AuthorLower && AuthorLower->Contains(Term, ESearchCase::CaseSensitive))
+			|| AnyTagContains(Term))
+		{
+			return true;
+		}
+	}
+	return false;
+}
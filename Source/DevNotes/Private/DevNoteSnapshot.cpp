@@ -0,0 +1,95 @@
+#include "DevNoteSnapshot.h"
+
+#include "DevNoteChangeSet.h"
+
+const FDevNote* FDevNoteSnapshot::FindNote(const FGuid& NoteId) const
+{
+	if (Buckets.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	const FBucket& Bucket = *Buckets[GetBucketIndex(NoteId)];
+	const int32* Index = Bucket.NoteIndexById.Find(NoteId);
+	return Index ? &Bucket.Notes[*Index].Get() : nullptr;
+}
+
+FDevNoteSnapshotRef FDevNoteSnapshot::MakeNext(const FDevNoteSnapshot& Previous,
+	const TMap<FGuid, TSharedPtr<FDevNote>>& CachedNotesById, const FDevNoteChangeSet& NoteChanges,
+	const TArray<FDevNoteTag>* CachedTags, const TArray<FDevNoteUser>* CachedUsers)
+{
+	TSharedRef<FDevNoteSnapshot, ESPMode::ThreadSafe> Next = MakeShared<FDevNoteSnapshot, ESPMode::ThreadSafe>();
+	Next->Version = Previous.Version + 1;
+	Next->Tags = CachedTags ? *CachedTags : Previous.Tags;
+	Next->Users = CachedUsers ? *CachedUsers : Previous.Users;
+	Next->NumNoteRefs = Previous.NumNoteRefs;
+	Next->Buckets = Previous.Buckets;
+	if (Next->Buckets.IsEmpty())
+	{
+		Next->Buckets.Init(MakeShared<const FBucket, ESPMode::ThreadSafe>(), NumBuckets);
+	}
+
+	// Each touched bucket is copied once, however many of its notes changed
+	TArray<TSharedPtr<FBucket, ESPMode::ThreadSafe>> Copies;
+	Copies.SetNum(NumBuckets);
+	auto GetCopy = [&Next, &Copies](const FGuid& NoteId) -> FBucket&
+	{
+		const int32 BucketIndex = GetBucketIndex(NoteId);
+		if (!Copies[BucketIndex].IsValid())
+		{
+			Copies[BucketIndex] = MakeShared<FBucket, ESPMode::ThreadSafe>(*Next->Buckets[BucketIndex]);
+		}
+		return *Copies[BucketIndex];
+	};
+
+	for (const FGuid& NoteId : NoteChanges.Removed)
+	{
+		FBucket& Bucket = GetCopy(NoteId);
+		int32 Index = INDEX_NONE;
+		if (!Bucket.NoteIndexById.RemoveAndCopyValue(NoteId, Index))
+		{
+			continue;
+		}
+		Bucket.Notes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		if (Bucket.Notes.IsValidIndex(Index))
+		{
+			Bucket.NoteIndexById.Add(Bucket.Notes[Index]->Id, Index);
+		}
+		--Next->NumNoteRefs;
+	}
+
+	// Changed notes get a fresh immutable copy, the old one stays with the snapshots that hold it
+	for (const TArray<FGuid>* Ids : { &NoteChanges.Added, &NoteChanges.Changed })
+	{
+		for (const FGuid& NoteId : *Ids)
+		{
+			const TSharedPtr<FDevNote>* Cached = CachedNotesById.Find(NoteId);
+			if (!Cached || !Cached->IsValid())
+			{
+				continue;
+			}
+
+			FBucket& Bucket = GetCopy(NoteId);
+			const FNoteRef Note = MakeShared<const FDevNote, ESPMode::ThreadSafe>(**Cached);
+			if (const int32* Index = Bucket.NoteIndexById.Find(NoteId))
+			{
+				Bucket.Notes[*Index] = Note;
+			}
+			else
+			{
+				Bucket.NoteIndexById.Add(NoteId, Bucket.Notes.Add(Note));
+				++Next->NumNoteRefs;
+			}
+		}
+	}
+
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+	{
+		if (Copies[BucketIndex].IsValid())
+		{
+			Next->Buckets[BucketIndex] = Copies[BucketIndex].ToSharedRef();
+		}
+	}
+
+	return Next;
+}
@@ -4,6 +4,8 @@
 #include "DevNoteSubsystem.h"
 
 #include "DevNotesLog.h"
+#include "DevNotesStats.h"
+#include "DevNoteServerQuery.h"
 #include "EngineUtils.h"
 #include "FDevNoteTag.h"
 #include "FileHelpers.h"
@@ -12,8 +14,11 @@
 #include "JsonObjectConverter.h"
 #include "LevelEditorSubsystem.h"
 #include "LevelEditorViewport.h"
+#include "Misc/ScopeRWLock.h"
+#include "ProfilingDebugging/MiscTrace.h"
 #include "Selection.h"
 #include "DevNotesDeveloperSettings.h"
+#include "DevNotesUserSettings.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 
@@ -56,6 +61,13 @@ FVector GetEditorViewportCameraLocation()
 }
 
 
+// Past a quarter of the notes, rebuilding search structures in one pass beats patching them note by note
+static bool IsLargeNoteChange(const FDevNoteChangeSet& Changes, int32 NumNotes)
+{
+	return Changes.Num() * 4 > NumNotes;
+}
+
+
 void UDevNoteSubsystem::OnPollNotesTimerTimeout()
 {
 	// Only run if we are logged in
@@ -73,8 +85,17 @@ void UDevNoteSubsystem::OnPollNotesTimerTimeout()
 
 }
 
+void UDevNoteSubsystem::OnRefreshTimedViewsTimerTimeout()
+{
+	if (SavedViews.RefreshTimedViews(SearchIndex))
+	{
+		OnSavedViewsUpdated.Broadcast();
+	}
+}
+
 bool UDevNoteSubsystem::TryAutoSignIn()
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	const FString SavedToken = LoadSessionTokenFromFile();
 	if (SavedToken.IsEmpty())
 	{
@@ -147,7 +168,7 @@ bool UDevNoteSubsystem::TryAutoSignIn()
 			}
 		});
 
-	Request->ProcessRequest();
+	ProcessRequest(Request);
 	return true;
 }
 
@@ -173,7 +194,16 @@ const FDevNoteUser& UDevNoteSubsystem::GetCurrentUser()
 void UDevNoteSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+
+	const UDevNotesDeveloperSettings* Settings = GetDefault<UDevNotesDeveloperSettings>();
+	BodyCache.SetMaxBytes(static_cast<int64>(Settings->NoteBodyCacheSizeKB) * 1024);
 	
+	ReloadSavedViews();
+	GetMutableDefault<UDevNotesUserSettings>()->OnSettingChanged().AddWeakLambda(this, [this](UObject*, FPropertyChangedEvent&)
+	{
+		ReloadSavedViews();
+	});
+
 	// Try to restore session from saved token
 	TryAutoSignIn();
 	
@@ -190,6 +220,12 @@ void UDevNoteSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 			&UDevNoteSubsystem::OnPollNotesTimerTimeout,
 			30.0f,
 			true);
+		GEditor->GetTimerManager()->SetTimer(
+			RefreshTimedViewsTimerHandle,
+			this,
+			&UDevNoteSubsystem::OnRefreshTimedViewsTimerTimeout,
+			60.0f,
+			true);
 	});
 }
 
@@ -197,19 +233,22 @@ void UDevNoteSubsystem::RequestNotesFromServer()
 {
 	RequestTagsFromServer();
 	RequestUsersFromServer();
+
+	DEVNOTES_SCOPE(BuildRequest);
 	FHttpModule* Http = &FHttpModule::Get();
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
 	
 	Request->OnProcessRequestComplete().BindUObject(this, &UDevNoteSubsystem::HandleNotesResponse);
-	Request->SetURL(GetServerAddress() + TEXT("/notes"));
+	Request->SetURL(GetServerAddress() + (IsSummarySyncEnabled() ? TEXT("/notes?summary=true") : TEXT("/notes")));
 	Request->SetVerb("GET");
 	Request->SetHeader("Content-Type", "application/json");
 	Request->SetHeader(TEXT("X-Session-Token"), *SessionToken);
-	Request->ProcessRequest();
+	ProcessRequest(Request);
 }
 
 void UDevNoteSubsystem::PostNote(const FDevNote& Note)
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	FString JsonString = SerializeNoteToJsonString(Note);
 
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
@@ -241,11 +280,49 @@ void UDevNoteSubsystem::PostNote(const FDevNote& Note)
 		}
 	});
 
-	Request->ProcessRequest();
+	ProcessRequest(Request);
 }
 
 void UDevNoteSubsystem::UpdateNote(const FDevNote& Note)
 {
+	DEVNOTES_SCOPE(BuildRequest);
+	// The server replaces the whole note, so never send a summary without its body
+	if (!Note.bBodyLoaded)
+	{
+		FDevNote FullNote = Note;
+		if (BodyCache.TryGet(Note.Id, Note.LastEdited, FullNote.Body))
+		{
+			FullNote.bBodyLoaded = true;
+			UpdateNote(FullNote);
+		}
+		else
+		{
+			RequestNoteBody(Note.Id, [this, FullNote](bool bSuccess) mutable
+			{
+				if (!bSuccess)
+				{
+					UE_LOG(LogDevNotes, Error, TEXT("Failed to update note %s: could not fetch its body"), *FullNote.Id.ToString());
+					OnNoteUpdateFailed.Broadcast(FullNote.Id);
+					return;
+				}
+				
+				// A sync may have removed the note while its body was in flight
+				const TSharedPtr<FDevNote> Cached = FindCachedNote(FullNote.Id);
+				if (!Cached.IsValid() || !Cached->bBodyLoaded)
+				{
+					UE_LOG(LogDevNotes, Error, TEXT("Failed to update note %s: it is no longer in the cache"), *FullNote.Id.ToString());
+					OnNoteUpdateFailed.Broadcast(FullNote.Id);
+					return;
+				}
+
+				FullNote.Body = Cached->Body;
+				FullNote.bBodyLoaded = true;
+				UpdateNote(FullNote);
+			});
+		}
+		return;
+	}
+
 	FString JsonString = SerializeNoteToJsonString(Note);
 
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
@@ -255,17 +332,33 @@ void UDevNoteSubsystem::UpdateNote(const FDevNote& Note)
 	Request->SetHeader(TEXT("X-Session-Token"), *SessionToken);
 	Request->SetContentAsString(JsonString);
 
-	Request->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr Req, FHttpResponsePtr Response, bool bSuccess)
+	Request->OnProcessRequestComplete().BindLambda([this, NoteId = Note.Id](FHttpRequestPtr Req, FHttpResponsePtr Response, bool bSuccess)
 	{
 		HandleTokenInvalidation(Response);
 
 		if (bSuccess && Response->GetResponseCode() == EHttpResponseCodes::Ok)
 		{
 			UE_LOG(LogDevNotes, Log, TEXT("Note updated successfully."));
+			if (IsSummarySyncEnabled())
+			{
+				// Cache the body under the server's edit time, so later syncs compare like with like. Without one, drop the stale entry
+				FDevNote Updated;
+				TSharedPtr<FJsonObject> JsonObj;
+				const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+				if (FJsonSerializer::Deserialize(Reader, JsonObj) && ParseNoteFromJsonObject(JsonObj, Updated) && Updated.Id == NoteId)
+				{
+					BodyCache.Add(NoteId, Updated.Body, Updated.LastEdited);
+				}
+				else
+				{
+					BodyCache.Remove(NoteId);
+				}
+			}
 			RequestNotesFromServer();
 		}
 		else
 		{
+			OnNoteUpdateFailed.Broadcast(NoteId);
 			if (Response)
 			{
 				UE_LOG(LogDevNotes, Error, TEXT("Failed to update note: %s. \nError: %d \nReason:%hhd"), *Response->GetContentAsString(), Response->GetResponseCode(), Response->GetFailureReason());
@@ -277,11 +370,12 @@ void UDevNoteSubsystem::UpdateNote(const FDevNote& Note)
 		}
 	});
 
-	Request->ProcessRequest();
+	ProcessRequest(Request);
 }
 
 void UDevNoteSubsystem::DeleteNote(const FGuid& NoteId)
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
 	Request->SetURL(GetServerAddress() + "/notes/" + NoteId.ToString(EGuidFormats::DigitsWithHyphens));
 	Request->SetVerb("DELETE");
@@ -310,7 +404,7 @@ void UDevNoteSubsystem::DeleteNote(const FGuid& NoteId)
 		}
 	});
 
-	Request->ProcessRequest();
+	ProcessRequest(Request);
 }
 
 void UDevNoteSubsystem::PromptAndTeleportToNote(const FDevNote& note)
@@ -391,7 +485,7 @@ TSet<FString> UDevNoteSubsystem::GetLoadedLevelPaths()
 	return LoadedLevelPaths;
 }
 
-bool UDevNoteSubsystem::ParseNoteFromJsonObject(const TSharedPtr<FJsonObject>& JsonObj, FDevNote& OutNote)
+bool UDevNoteSubsystem::ParseNoteFromJsonObject(const TSharedPtr<FJsonObject>& JsonObj, FDevNote& OutNote, bool bSummary)
 {
 	if (!JsonObj.IsValid())
 	{
@@ -403,12 +497,18 @@ bool UDevNoteSubsystem::ParseNoteFromJsonObject(const TSharedPtr<FJsonObject>& J
 
 	if (!JsonObj->TryGetStringField(TEXT("id"), idString) ||
 		!JsonObj->TryGetStringField(TEXT("title"), OutNote.Title) ||
-		!JsonObj->TryGetStringField(TEXT("body"), OutNote.Body) ||
 		!JsonObj->TryGetStringField(TEXT("createdById"), createdByIDString))
 	{
 		return false; // Required fields missing
 	}
 
+	// Summary syncs leave the body out, it is fetched once the note is opened
+	OutNote.bBodyLoaded = JsonObj->TryGetStringField(TEXT("body"), OutNote.Body);
+	if (!OutNote.bBodyLoaded && !bSummary)
+	{
+		return false;
+	}
+
 	OutNote.Id = FGuid(idString);
 	OutNote.CreatedById = FGuid(createdByIDString);
 	
@@ -531,6 +631,14 @@ void UDevNoteSubsystem::CreateNewNoteAtEditorLocation()
 	newNote->WorldPosition = GetEditorViewportCameraLocation();
 
 	CachedNotes.Add(newNote);
+	CachedNotesById.Add(newNote->Id, newNote);
+	SearchIndex.UpdateNote(newNote);
+
+	FDevNoteChangeSet Changes;
+	Changes.Added.Add(newNote->Id);
+	PublishSnapshot(Changes, false, false);
+	UpdateSavedViews(Changes);
+
 	PostNote(*newNote);
 }
 
@@ -547,33 +655,175 @@ void UDevNoteSubsystem::SetEditorEditingState(bool bEditing)
 void UDevNoteSubsystem::HandleTagsResponse(TSharedPtr<IHttpRequest> HttpRequest, TSharedPtr<IHttpResponse> HttpResponse,
 	bool bWasSuccessful)
 {
-	CachedTags.Empty();
 	HandleTokenInvalidation(HttpResponse);
 
-	// Parse tags
-	if (bWasSuccessful && HttpResponse->GetResponseCode() == EHttpResponseCodes::Ok)
+	const bool bOk = bWasSuccessful && HttpResponse.IsValid() && HttpResponse->GetResponseCode() == EHttpResponseCodes::Ok;
+	ApplyTagsResponse(bOk ? HttpResponse->GetContentAsString() : FString(), bOk);
+}
+
+void UDevNoteSubsystem::ApplyTagsResponse(const FString& ResponseString, bool bSuccess)
+{
+	LLM_SCOPE_BYTAG(DevNotes);
+	TArray<FDevNoteTag> NewTags;
+
+	// Parse tags. A failed request clears them, a body that isn't a tag list leaves them as they are
+	if (bSuccess)
 	{
-		FString ResponseString = HttpResponse->GetContentAsString();
+		DEVNOTES_STAGE_SCOPE(Diagnostics, Parse);
 		TArray<TSharedPtr<FJsonValue>> JsonArray;
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseString);
-		if (FJsonSerializer::Deserialize(Reader, JsonArray))
+		if (!FJsonSerializer::Deserialize(Reader, JsonArray))
 		{
-			for (const auto& Item : JsonArray)
+			UE_LOG(LogDevNotes, Warning, TEXT("Ignoring a tags response that isn't a JSON array"));
+			return;
+		}
+		for (const auto& Item : JsonArray)
+		{
+			FDevNoteTag Tag;
+			if (ParseTagFromJsonObject(Item->AsObject(), Tag))
 			{
-				FDevNoteTag Tag;
-				if (ParseTagFromJsonObject(Item->AsObject(), Tag))
-				{
-					CachedTags.Add(Tag);
-				}
+				NewTags.Add(Tag);
 			}
 		}
 	}
-	
-	OnTagsUpdated.Broadcast();
+
+	// Diff against the previous sync so listeners only rebuild what changed
+	DEVNOTES_STAGE_SCOPE(Diagnostics, ApplyCache);
+	TMap<FGuid, int32> OldIndexById;
+	OldIndexById.Reserve(CachedTags.Num());
+	for (int32 i = 0; i < CachedTags.Num(); ++i)
+	{
+		OldIndexById.Add(CachedTags[i].Id, i);
+	}
+
+	FDevNoteChangeSet Changes;
+	for (const FDevNoteTag& Tag : NewTags)
+	{
+		int32 OldIndex = INDEX_NONE;
+		if (!OldIndexById.RemoveAndCopyValue(Tag.Id, OldIndex))
+		{
+			Changes.Added.Add(Tag.Id);
+		}
+		else if (!CachedTags[OldIndex].Name.Equals(Tag.Name, ESearchCase::CaseSensitive) || CachedTags[OldIndex].Colour != Tag.Colour)
+		{
+			Changes.Changed.Add(Tag.Id);
+		}
+	}
+	for (const TPair<FGuid, int32>& Removed : OldIndexById)
+	{
+		Changes.Removed.Add(Removed.Key);
+	}
+
+	CachedTags = MoveTemp(NewTags);
+	if (Changes.IsEmpty())
+	{
+		return;
+	}
+
+	SyncSharedTags(Changes);
+	SearchIndex.SetTags(CachedTags);
+	PublishSnapshot(FDevNoteChangeSet(), true, false);
+	RebuildSavedViews();
+	OnTagsChanged.Broadcast(Changes);
+}
+
+void UDevNoteSubsystem::SaveView(const FString& Name, const FString& Query)
+{
+	UDevNotesUserSettings* Settings = GetMutableDefault<UDevNotesUserSettings>();
+	FDevNoteSavedViewSettings* View = Settings->SavedViews.FindByPredicate([&Name](const FDevNoteSavedViewSettings& Existing)
+	{
+		return Existing.Name.Equals(Name, ESearchCase::IgnoreCase);
+	});
+	if (!View)
+	{
+		View = &Settings->SavedViews.AddDefaulted_GetRef();
+		View->Name = Name;
+	}
+	View->Query = Query;
+	Settings->SaveConfig();
+	ReloadSavedViews();
+}
+
+void UDevNoteSubsystem::DeleteView(const FString& Name)
+{
+	UDevNotesUserSettings* Settings = GetMutableDefault<UDevNotesUserSettings>();
+	Settings->SavedViews.RemoveAll([&Name](const FDevNoteSavedViewSettings& Existing) { return Existing.Name.Equals(Name, ESearchCase::IgnoreCase); });
+	Settings->SaveConfig();
+	ReloadSavedViews();
+}
+
+void UDevNoteSubsystem::ReloadSavedViews()
+{
+	TArray<FDevNoteSavedView> Views;
+	for (const FDevNoteSavedViewSettings& Settings : GetDefault<UDevNotesUserSettings>()->SavedViews)
+	{
+		if (Settings.Name.IsEmpty())
+		{
+			continue;
+		}
+
+		FDevNoteSavedView& View = Views.AddDefaulted_GetRef();
+		View.Name = Settings.Name;
+		View.QueryString = Settings.Query;
+		View.bShowInToolbar = Settings.bShowInToolbar;
+	}
+	SavedViews.SetViews(MoveTemp(Views), SearchIndex);
+	OnSavedViewsUpdated.Broadcast();
+}
+
+void UDevNoteSubsystem::UpdateSavedViews(const FDevNoteChangeSet& NoteChanges)
+{
+	if (SavedViews.GetViews().IsEmpty())
+	{
+		return;
+	}
+	if (IsLargeNoteChange(NoteChanges, SearchIndex.GetEntries().Num()))
+	{
+		SavedViews.Rebuild(SearchIndex);
+	}
+	else
+	{
+		SavedViews.ApplyNoteChanges(SearchIndex, NoteChanges);
+	}
+	OnSavedViewsUpdated.Broadcast();
+}
+
+void UDevNoteSubsystem::RebuildSavedViews()
+{
+	if (SavedViews.GetViews().IsEmpty())
+	{
+		return;
+	}
+	SavedViews.Rebuild(SearchIndex);
+	OnSavedViewsUpdated.Broadcast();
+}
+
+void UDevNoteSubsystem::SyncSharedTags(const FDevNoteChangeSet& Changes)
+{
+	for (const FGuid& TagId : Changes.Removed)
+	{
+		SharedTagsById.Remove(TagId);
+	}
+
+	SharedTags.Reset(CachedTags.Num());
+	for (const FDevNoteTag& Tag : CachedTags)
+	{
+		TSharedPtr<FDevNoteTag>& Shared = SharedTagsById.FindOrAdd(Tag.Id);
+		if (Shared.IsValid())
+		{
+			*Shared = Tag;
+		}
+		else
+		{
+			Shared = MakeShared<FDevNoteTag>(Tag);
+		}
+		SharedTags.Add(Shared);
+	}
 }
 
 void UDevNoteSubsystem::RequestTagsFromServer()
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	FHttpModule* Http = &FHttpModule::Get();
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
 
@@ -582,7 +832,221 @@ void UDevNoteSubsystem::RequestTagsFromServer()
 	Request->SetVerb("GET");
 	Request->SetHeader("Content-Type", "application/json");
 	Request->SetHeader(TEXT("X-Session-Token"), *SessionToken);
-	Request->ProcessRequest();
+	ProcessRequest(Request);
+}
+
+bool UDevNoteSubsystem::IsSummarySyncEnabled() const
+{
+	const UDevNotesDeveloperSettings* Settings = GetDefault<UDevNotesDeveloperSettings>();
+	return Settings && Settings->bSummaryNoteSync;
+}
+
+void UDevNoteSubsystem::RequestNoteBody(const FGuid& NoteId, TFunction<void(bool bSuccess)> Completion)
+{
+	DEVNOTES_SCOPE(BuildRequest);
+	TSharedPtr<FDevNote> Note = FindCachedNote(NoteId);
+	if (Note.IsValid() && Note->bBodyLoaded)
+	{
+		if (Completion) Completion(true);
+		return;
+	}
+
+	FString CachedBody;
+	if (Note.IsValid() && BodyCache.TryGet(NoteId, Note->LastEdited, CachedBody))
+	{
+		ApplyNoteBody(NoteId, CachedBody);
+		if (Completion) Completion(true);
+		return;
+	}
+
+	// Piggyback on a request that is already in flight
+	const bool bInFlight = PendingBodyRequests.Contains(NoteId);
+	TArray<TFunction<void(bool)>>& Waiters = PendingBodyRequests.FindOrAdd(NoteId);
+	if (Completion)
+	{
+		Waiters.Add(MoveTemp(Completion));
+	}
+	if (bInFlight)
+	{
+		return;
+	}
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(GetServerAddress() + "/notes/" + NoteId.ToString(EGuidFormats::DigitsWithHyphens));
+	Request->SetVerb("GET");
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetHeader(TEXT("X-Session-Token"), *SessionToken);
+	Request->OnProcessRequestComplete().BindWeakLambda(this, [this, NoteId](FHttpRequestPtr Req, FHttpResponsePtr Response, bool bSuccess)
+	{
+		HandleNoteBodyResponse(NoteId, Response, bSuccess);
+	});
+	ProcessRequest(Request);
+}
+
+void UDevNoteSubsystem::PrefetchNoteBodies(const TArray<FGuid>& NoteIds)
+{
+	if (!IsSummarySyncEnabled()) return;
+
+	for (const FGuid& NoteId : NoteIds)
+	{
+		RequestNoteBody(NoteId);
+	}
+}
+
+bool UDevNoteSubsystem::IsServerFilteringEnabled() const
+{
+	const UDevNotesDeveloperSettings* Settings = GetDefault<UDevNotesDeveloperSettings>();
+	return Settings && Settings->bServerSideFiltering && IsLoggedIn();
+}
+
+void UDevNoteSubsystem::QueryNotesOnServer(const FDevNoteServerQuery& Query, TFunction<void(bool bSuccess, const TArray<FGuid>& NoteIds)> Completion)
+{
+	DEVNOTES_SCOPE(BuildRequest);
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(GetQueryServerAddress() + TEXT("/notes/query"));
+	Request->SetVerb("POST");
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetHeader(TEXT("X-Session-Token"), *SessionToken);
+	Request->SetContentAsString(Query.ToJsonString());
+	Request->OnProcessRequestComplete().BindWeakLambda(this, [this, bSummary = Query.bSummary, Completion = MoveTemp(Completion)](FHttpRequestPtr Req, FHttpResponsePtr Response, bool bSuccess)
+	{
+		LLM_SCOPE_BYTAG(DevNotes);
+		HandleTokenInvalidation(Response);
+
+		// Offline, or a server without query support
+		TArray<FDevNote> ParsedNotes;
+		bool bParsed = false;
+		if (bSuccess && Response.IsValid() && Response->GetResponseCode() == EHttpResponseCodes::Ok)
+		{
+			DEVNOTES_STAGE_SCOPE(Diagnostics, Parse);
+			bParsed = ParseNotesFromJson(Response->GetContentAsString(), ParsedNotes, bSummary);
+		}
+		if (!bParsed)
+		{
+			UE_LOG(LogDevNotes, Warning, TEXT("Note query failed (code: %d), filtering locally"), Response.IsValid() ? Response->GetResponseCode() : 0);
+			Completion(false, {});
+			return;
+		}
+
+		// Only merge: notes the query didn't return still exist, they just don't match
+		FDevNoteChangeSet Changes;
+		TArray<FGuid> NoteIds;
+		NoteIds.Reserve(ParsedNotes.Num());
+		{
+			DEVNOTES_STAGE_SCOPE(Diagnostics, ApplyCache);
+			for (FDevNote& Parsed : ParsedNotes)
+			{
+				NoteIds.Add(Parsed.Id);
+
+				TSharedPtr<FDevNote> Note = FindCachedNote(Parsed.Id);
+				const bool bNew = !Note.IsValid();
+				MergeParsedNote(MoveTemp(Parsed), Note, Changes);
+				if (bNew)
+				{
+					CachedNotes.Add(Note);
+					CachedNotesById.Add(Note->Id, Note);
+				}
+			}
+			UpdateSearchIndex(Changes);
+
+			if (!Changes.IsEmpty())
+			{
+				PublishSnapshot(Changes, false, false);
+				UpdateSavedViews(Changes);
+			}
+		}
+
+		if (!Changes.IsEmpty())
+		{
+			ApplyWaypointChanges(Changes);
+			OnNotesChanged.Broadcast(Changes);
+		}
+		Completion(true, NoteIds);
+	});
+	ProcessRequest(Request);
+}
+
+void UDevNoteSubsystem::HandleNoteBodyResponse(FGuid NoteId, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	LLM_SCOPE_BYTAG(DevNotes);
+	HandleTokenInvalidation(Response);
+
+	TArray<TFunction<void(bool)>> Waiters;
+	PendingBodyRequests.RemoveAndCopyValue(NoteId, Waiters);
+
+	bool bSuccess = false;
+	if (bWasSuccessful && Response.IsValid() && Response->GetResponseCode() == EHttpResponseCodes::Ok)
+	{
+		FDevNote FullNote;
+		bool bParsed = false;
+		{
+			DEVNOTES_STAGE_SCOPE(Diagnostics, Parse);
+			TSharedPtr<FJsonObject> JsonObj;
+			const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+			bParsed = FJsonSerializer::Deserialize(Reader, JsonObj) && ParseNoteFromJsonObject(JsonObj, FullNote);
+		}
+		if (bParsed && FullNote.bBodyLoaded)
+		{
+			DevNotesStats::AddNotesParsed(1);
+			DEVNOTES_STAGE_SCOPE(Diagnostics, ApplyCache);
+			BodyCache.Add(NoteId, FullNote.Body, FullNote.LastEdited);
+			ApplyNoteBody(NoteId, FullNote.Body);
+			bSuccess = true;
+		}
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogDevNotes, Warning, TEXT("Failed to fetch body for note %s"), *NoteId.ToString());
+	}
+
+	for (TFunction<void(bool)>& Waiter : Waiters)
+	{
+		Waiter(bSuccess);
+	}
+}
+
+void UDevNoteSubsystem::ApplyNoteBody(const FGuid& NoteId, const FString& Body)
+{
+	if (TSharedPtr<FDevNote> Note = FindCachedNote(NoteId))
+	{
+		Note->Body = Body;
+		Note->bBodyLoaded = true;
+		SearchIndex.UpdateNote(Note);
+
+		FDevNoteChangeSet Changes;
+		Changes.Changed.Add(NoteId);
+		PublishSnapshot(Changes, false, false);
+		UpdateSavedViews(Changes);
+	}
+	OnNoteBodyLoaded.Broadcast(NoteId, Body);
+}
+
+TSharedPtr<FDevNote> UDevNoteSubsystem::FindCachedNote(const FGuid& NoteId) const
+{
+	return CachedNotesById.FindRef(NoteId);
+}
+
+FDevNoteSnapshotRef UDevNoteSubsystem::GetSnapshot() const
+{
+	FReadScopeLock Lock(SnapshotLock);
+	return Snapshot;
+}
+
+void UDevNoteSubsystem::PublishSnapshot(const FDevNoteChangeSet& NoteChanges, bool bTagsChanged, bool bUsersChanged)
+{
+	check(IsInGameThread());
+
+	// Only the game thread replaces the snapshot, so it can read the current one without the lock.
+	// The next one is built outside the lock, readers only ever wait for the pointer swap
+	FDevNoteSnapshotRef Next = FDevNoteSnapshot::MakeNext(*Snapshot, CachedNotesById, NoteChanges,
+		bTagsChanged ? &CachedTags : nullptr,
+		bUsersChanged ? &CachedUsers : nullptr);
+
+	FWriteScopeLock Lock(SnapshotLock);
+	Snapshot = Next;
+
+	SET_MEMORY_STAT(STAT_DevNotes_SearchEntriesMemory, SearchIndex.GetEntries().GetAllocatedSize());
 }
 
 UDevNoteSubsystem* UDevNoteSubsystem::Get()
@@ -594,30 +1058,150 @@ UDevNoteSubsystem* UDevNoteSubsystem::Get()
 	return nullptr;
 }
 
-void UDevNoteSubsystem::ParseAndCacheNotesFromJson(const FString& JsonString)
+FVector UDevNoteSubsystem::GetEditorCameraLocation()
+{
+	return GetEditorViewportCameraLocation();
+}
+
+// Whether a freshly synced note differs from the cached one. Bodies are only compared when the sync carried one
+static bool HasNoteChanged(const FDevNote& Old, const FDevNote& New)
+{
+	if (New.bBodyLoaded && (!Old.bBodyLoaded || !Old.Body.Equals(New.Body, ESearchCase::CaseSensitive)))
+	{
+		return true;
+	}
+
+	return !Old.Title.Equals(New.Title, ESearchCase::CaseSensitive)
+		|| Old.CreatedById != New.CreatedById
+		|| Old.CreatedAt != New.CreatedAt
+		|| Old.LastEdited != New.LastEdited
+		|| Old.LevelPath != New.LevelPath
+		|| Old.WorldPosition != New.WorldPosition
+		|| Old.Tags != New.Tags;
+}
+
+bool UDevNoteSubsystem::ParseNotesFromJson(const FString& JsonString, TArray<FDevNote>& OutNotes, bool bSummary)
 {
 	TArray<TSharedPtr<FJsonValue>> NotesArray;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, NotesArray))
+	{
+		return false;
+	}
 
-	if (FJsonSerializer::Deserialize(Reader, NotesArray))
+	OutNotes.Reserve(OutNotes.Num() + NotesArray.Num());
+	for (const TSharedPtr<FJsonValue>& Value : NotesArray)
 	{
-		CachedNotes.Empty();
+		FDevNote Parsed;
+		if (!ParseNoteFromJsonObject(Value->AsObject(), Parsed, bSummary))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to parse DevNote from JSON."));
+			continue;
+		}
+		OutNotes.Add(MoveTemp(Parsed));
+	}
+	DevNotesStats::AddNotesParsed(OutNotes.Num());
+	return true;
+}
 
-		for (const TSharedPtr<FJsonValue>& Value : NotesArray)
+FDevNoteChangeSet UDevNoteSubsystem::ParseAndCacheNotesFromJson(const FString& JsonString, bool bSummary)
+{
+	FDevNoteChangeSet Changes;
+
+	TArray<FDevNote> ParsedNotes;
+	bool bParsed = false;
+	{
+		DEVNOTES_STAGE_SCOPE(Diagnostics, Parse);
+		bParsed = ParseNotesFromJson(JsonString, ParsedNotes, bSummary);
+	}
+	if (!bParsed)
+	{
+		return Changes;
+	}
+
+	DEVNOTES_STAGE_SCOPE(Diagnostics, ApplyCache);
+	TMap<FGuid, TSharedPtr<FDevNote>> OldNotesById = MoveTemp(CachedNotesById);
+	CachedNotesById.Reset();
+	CachedNotesById.Reserve(ParsedNotes.Num());
+
+	TArray<TSharedPtr<FDevNote>> NewNotes;
+	NewNotes.Reserve(ParsedNotes.Num());
+
+	for (FDevNote& Parsed : ParsedNotes)
+	{
+		TSharedPtr<FDevNote> Note;
+		OldNotesById.RemoveAndCopyValue(Parsed.Id, Note);
+		MergeParsedNote(MoveTemp(Parsed), Note, Changes);
+
+		NewNotes.Add(Note);
+		CachedNotesById.Add(Note->Id, Note);
+	}
+
+	// Whatever is left wasn't in this sync
+	for (const TPair<FGuid, TSharedPtr<FDevNote>>& Removed : OldNotesById)
+	{
+		Changes.Removed.Add(Removed.Key);
+	}
+
+	CachedNotes = MoveTemp(NewNotes);
+	UpdateSearchIndex(Changes);
+	return Changes;
+}
+
+void UDevNoteSubsystem::UpdateSearchIndex(const FDevNoteChangeSet& Changes)
+{
+	if (Changes.IsEmpty())
+	{
+		return;
+	}
+
+	// A first sync, or one touching much of the cache, is indexed in one pass. Patching note by note keeps the
+	// time order and groups current after every note, which only pays off for small deltas
+	if (SearchIndex.GetEntries().Num() == 0 || IsLargeNoteChange(Changes, CachedNotes.Num()))
+	{
+		SearchIndex.RebuildNotes(CachedNotes);
+		return;
+	}
+
+	for (const FGuid& NoteId : Changes.Removed)
+	{
+		SearchIndex.RemoveNote(NoteId);
+	}
+	for (const TArray<FGuid>* Ids : { &Changes.Added, &Changes.Changed })
+	{
+		for (const FGuid& NoteId : *Ids)
 		{
-			TSharedPtr<FJsonObject> JsonObj = Value->AsObject();
-			TSharedPtr<FDevNote> Note = MakeShared<FDevNote>();
-			
-			if (ParseNoteFromJsonObject(JsonObj, *Note))
-			{
-				CachedNotes.Add(Note);
-			}
-			else
+			SearchIndex.UpdateNote(FindCachedNote(NoteId));
+		}
+	}
+}
+
+void UDevNoteSubsystem::MergeParsedNote(FDevNote&& Parsed, TSharedPtr<FDevNote>& Note, FDevNoteChangeSet& Changes)
+{
+	if (!Parsed.bBodyLoaded)
+	{
+		Parsed.bBodyLoaded = BodyCache.TryGet(Parsed.Id, Parsed.LastEdited, Parsed.Body);
+	}
+
+	if (Note.IsValid())
+	{
+		if (HasNoteChanged(*Note, Parsed))
+		{
+			// A body fetched for this very edit outlives a summary sync
+			if (!Parsed.bBodyLoaded && Note->bBodyLoaded && Note->LastEdited == Parsed.LastEdited)
 			{
-				UE_LOG(LogTemp, Warning, TEXT("Failed to parse DevNote from JSON."));
+				Parsed.Body = MoveTemp(Note->Body);
+				Parsed.bBodyLoaded = true;
 			}
+			*Note = MoveTemp(Parsed);
+			Changes.Changed.Add(Note->Id);
 		}
 	}
+	else
+	{
+		Note = MakeShared<FDevNote>(MoveTemp(Parsed));
+		Changes.Added.Add(Note->Id);
+	}
 }
 
 void UDevNoteSubsystem::HandleNotesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
@@ -630,23 +1214,95 @@ void UDevNoteSubsystem::HandleNotesResponse(FHttpRequestPtr Request, FHttpRespon
 		return;
 	}
 
-	TArray<TSharedPtr<FJsonValue>> JsonArray;
-	const FString ResponseString = Response->GetContentAsString();
-	
-	ParseAndCacheNotesFromJson(ResponseString);
-	OnNotesUpdated.Broadcast();
+	ApplyNotesResponse(Response->GetContentAsString(), Request.IsValid() && Request->GetURL().Contains(TEXT("summary=true")));
+}
 
-	// Delete all waypoints and recreate them
-	RefreshWaypointActors();
+void UDevNoteSubsystem::ApplyNotesResponse(const FString& ResponseString, bool bSummary)
+{
+	LLM_SCOPE_BYTAG(DevNotes);
+	const FDevNoteChangeSet Changes = ParseAndCacheNotesFromJson(ResponseString, bSummary);
+	if (Changes.IsEmpty())
+	{
+		return;
+	}
+
+	PublishSnapshot(Changes, false, false);
+	UpdateSavedViews(Changes);
+	ApplyWaypointChanges(Changes);
+	OnNotesChanged.Broadcast(Changes);
+}
+
+void UDevNoteSubsystem::ProcessRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request)
+{
+	DevNotesStats::AddBytesSent(Request->GetContentLength());
+	INC_DWORD_STAT(STAT_DevNotes_RequestsInFlight);
+	Diagnostics.BeginRequest();
+
+	FDevNoteRequestRecord Record;
+	Record.Verb = Request->GetVerb();
+	Record.Route = FDevNoteDiagnostics::GetRequestRoute(Request->GetURL());
+	Record.Endpoint = FDevNoteDiagnostics::ClassifyRequest(Record.Verb, Record.Route);
+	Record.BytesSent = Request->GetContentLength();
+	Record.bRetry = Diagnostics.DidLastAttemptFail(Record.Verb, Record.Route);
+	Record.StartTime = FPlatformTime::Seconds();
+
+	// The wait spans frames, so Insights shows it as a timing region rather than a CPU scope
+	const FString Region = FString::Printf(TEXT("DevNotes %s %s"), *Record.Verb, *Record.Route);
+	TRACE_BEGIN_REGION(*Region);
+
+	// Wrap whatever completion the caller bound, so every request is measured the same way
+	const FHttpRequestCompleteDelegate Completion = Request->OnProcessRequestComplete();
+	Request->OnProcessRequestComplete().BindWeakLambda(this, [this, Completion, Region, Record = MoveTemp(Record)](FHttpRequestPtr Req, FHttpResponsePtr Response, bool bSuccess) mutable
+	{
+		TRACE_END_REGION(*Region);
+		DEC_DWORD_STAT(STAT_DevNotes_RequestsInFlight);
+
+		Record.EndTime = FPlatformTime::Seconds();
+		Record.ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+		Record.BytesReceived = Response.IsValid() ? Response->GetContent().Num() : 0;
+		Record.bFailed = !bSuccess || !EHttpResponseCodes::IsOk(Record.ResponseCode);
+		SET_FLOAT_STAT(STAT_DevNotes_NetworkWait, (Record.EndTime - Record.StartTime) * 1000.0);
+		DevNotesStats::AddBytesReceived(Record.BytesReceived);
+		if (TrafficCapture.IsRecording())
+		{
+			TrafficCapture.Record(Req, Response, Record.StartTime, Record.EndTime, SessionToken);
+		}
+		Diagnostics.EndRequest(MoveTemp(Record));
+
+		Completion.ExecuteIfBound(Req, Response, bSuccess);
+	});
+	Request->ProcessRequest();
+}
+
+void UDevNoteSubsystem::MakeSimulatedClient(const FString& ServerAddress)
+{
+	bSimulatedClient = true;
+	ServerAddressOverride = ServerAddress;
 }
 
 FString UDevNoteSubsystem::GetServerAddress() const
 {
+	if (!ServerAddressOverride.IsEmpty())
+	{
+		return ServerAddressOverride;
+	}
+
 	const UDevNotesDeveloperSettings* Settings = GetDefault<UDevNotesDeveloperSettings>();
 	return Settings && !Settings->ServerAddress.IsEmpty() ? Settings->ServerAddress : TEXT("http://localhost:5281");
 }
 
 
+FString UDevNoteSubsystem::GetQueryServerAddress() const
+{
+	if (!ServerAddressOverride.IsEmpty())
+	{
+		return ServerAddressOverride;
+	}
+
+	const UDevNotesDeveloperSettings* Settings = GetDefault<UDevNotesDeveloperSettings>();
+	return Settings && !Settings->QueryServerAddress.IsEmpty() ? Settings->QueryServerAddress : GetServerAddress();
+}
+
 FString UDevNoteSubsystem::GetSessionTokenFilePath() const
 {
 	// Use the /Saved directory
@@ -674,6 +1330,10 @@ void UDevNoteSubsystem::DeleteSessionTokenFile() const
 void UDevNoteSubsystem::SetSessionToken(const FString& Token)
 {
 	SessionToken = Token;
+	if (bSimulatedClient)
+	{
+		return;
+	}
 	if (!Token.IsEmpty())
 	{
 		SaveSessionTokenToFile(Token);
@@ -687,7 +1347,10 @@ void UDevNoteSubsystem::SetSessionToken(const FString& Token)
 void UDevNoteSubsystem::ClearSessionToken()
 {
 	SessionToken.Empty();
-	DeleteSessionTokenFile();
+	if (!bSimulatedClient)
+	{
+		DeleteSessionTokenFile();
+	}
 }
 
 bool UDevNoteSubsystem::IsLoggedIn() const
@@ -715,21 +1378,55 @@ void UDevNoteSubsystem::SignOutInternal()
 {
 	const bool bWasLoggedIn = IsLoggedIn();
 	
+	// Everything cached goes away, listeners get it as one removal
+	FDevNoteChangeSet RemovedNotes;
+	CachedNotesById.GetKeys(RemovedNotes.Removed);
+	FDevNoteChangeSet RemovedTags;
+	for (const FDevNoteTag& Tag : CachedTags)
+	{
+		RemovedTags.Removed.Add(Tag.Id);
+	}
+
 	// Clear token and cached data
 	ClearSessionToken();
 	CachedNotes.Empty();
+	CachedNotesById.Empty();
 	CachedTags.Empty();
+	CachedUsers.Empty();
+	SharedTags.Empty();
+	SharedTagsById.Empty();
+	BodyCache.Empty();
+	PendingBodyRequests.Empty();
+	SearchIndex.Empty();
+	RebuildSavedViews();
 	CurrentUserId.Invalidate();
+	{
+		TSharedRef<FDevNoteSnapshot, ESPMode::ThreadSafe> Empty = MakeShared<FDevNoteSnapshot, ESPMode::ThreadSafe>();
+		FWriteScopeLock Lock(SnapshotLock);
+		Empty->Version = Snapshot->Version + 1;
+		Snapshot = Empty;
+	}
 	
-	// Stop polling timer
+	// Stop polling timers
 	if (RefreshNotesTimerHandle.IsValid())
 	{
 		GEditor->GetTimerManager()->ClearTimer(RefreshNotesTimerHandle);
 	}
+	if (RefreshTimedViewsTimerHandle.IsValid())
+	{
+		GEditor->GetTimerManager()->ClearTimer(RefreshTimedViewsTimerHandle);
+	}
 	
 	// Refresh UI
-	RefreshWaypointActors();
-	OnNotesUpdated.Broadcast();
+	ClearAllNoteWaypoints();
+	if (!RemovedNotes.IsEmpty())
+	{
+		OnNotesChanged.Broadcast(RemovedNotes);
+	}
+	if (!RemovedTags.IsEmpty())
+	{
+		OnTagsChanged.Broadcast(RemovedTags);
+	}
 	
 	// Broadcast sign out event only if we were actually logged in
 	if (bWasLoggedIn)
@@ -741,6 +1438,7 @@ void UDevNoteSubsystem::SignOutInternal()
 void UDevNoteSubsystem::SignIn(const FString& UserName, const FString& Password,
                                TFunction<void(bool bSuccess, const FString& Error)> Completion)
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	TSharedRef<FJsonObject> RequestObj = MakeShared<FJsonObject>();
 	RequestObj->SetStringField(TEXT("UserName"), UserName);
 	RequestObj->SetStringField(TEXT("Password"), Password);
@@ -806,12 +1504,13 @@ void UDevNoteSubsystem::SignIn(const FString& UserName, const FString& Password,
 			}
 		});
 		
-	HttpRequest->ProcessRequest();
+	ProcessRequest(HttpRequest);
 
 }
 
 void UDevNoteSubsystem::SignOut(TFunction<void(bool)> Completion)
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	if (!IsLoggedIn())
 	{
 		// Already signed out
@@ -854,11 +1553,12 @@ void UDevNoteSubsystem::SignOut(TFunction<void(bool)> Completion)
 			}
 		});
 		
-	HttpRequest->ProcessRequest();
+	ProcessRequest(HttpRequest);
 }
 
 void UDevNoteSubsystem::RetryTokenValidation()
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	if (!SessionToken.IsEmpty())
 	{
 		UE_LOG(LogDevNotes, Log, TEXT("Retrying token validation..."));
@@ -914,7 +1614,7 @@ void UDevNoteSubsystem::RetryTokenValidation()
 
 			});
 
-		Request->ProcessRequest();
+		ProcessRequest(Request);
 	}
 }
 
@@ -940,6 +1640,7 @@ ADevNoteActor* UDevNoteSubsystem::SpawnWaypointForNote(TSharedPtr<FDevNote> Note
 	ADevNoteActor* Waypoint = Cast<ADevNoteActor>(World->SpawnActor(spawnClass, &Note->WorldPosition, &FRotator::ZeroRotator, SpawnParams));
 	if (Waypoint)
 	{
+		DevNotesStats::AddActorsSpawned(1);
 		Waypoint->Note = Note;
 		Waypoint->SetActorLabel(TEXT("DevNote ") + Note->Title, false);
 		Waypoint->SetIsTemporarilyHiddenInEditor(false);
@@ -953,21 +1654,26 @@ ADevNoteActor* UDevNoteSubsystem::SpawnWaypointForNote(TSharedPtr<FDevNote> Note
 
 void UDevNoteSubsystem::ClearAllNoteWaypoints()
 {
-	if (!GEditor) return;
+	// The waypoints in the level belong to the editor's own subsystem
+	if (!GEditor || bSimulatedClient) return;
 	
 	UWorld* World = GEditor->GetEditorWorldContext().World();
 	if (!World) return;
 
-	// Could cache the actors instead
+	// Iterate the world rather than WaypointsByNoteId, to also catch waypoints left over from an earlier map
 	for (TActorIterator<ADevNoteActor> It(World); It; ++It)
 	{
 		GEditor->SelectActor(*It, false, true);
 		It->Destroy();
 	}
+	WaypointsByNoteId.Reset();
 }
 
 void UDevNoteSubsystem::RefreshWaypointActors()
 {
+	DEVNOTES_STAGE_SCOPE(Diagnostics, RefreshWaypoints);
+	LLM_SCOPE_BYTAG(DevNotes);
+
 	// Cache ID's
 	StoreSelectedNoteIDs();
 	ClearAllNoteWaypoints();
@@ -982,6 +1688,7 @@ void UDevNoteSubsystem::RefreshWaypointActors()
 		if (!CurrentLevels.Contains(levelString)) continue;
 		auto spawned = SpawnWaypointForNote(Note);
 		if (!spawned) continue;
+		WaypointsByNoteId.Add(Note->Id, spawned);
 
 		if (SelectedNoteIDsBeforeRefresh.Contains(Note->Id))
 		{
@@ -996,6 +1703,64 @@ void UDevNoteSubsystem::RefreshWaypointActors()
 	}
 }
 
+void UDevNoteSubsystem::DestroyWaypoint(const FGuid& NoteId)
+{
+	TWeakObjectPtr<ADevNoteActor> Waypoint;
+	if (WaypointsByNoteId.RemoveAndCopyValue(NoteId, Waypoint) && Waypoint.IsValid())
+	{
+		GEditor->SelectActor(Waypoint.Get(), false, true);
+		Waypoint->Destroy();
+	}
+}
+
+void UDevNoteSubsystem::ApplyWaypointChanges(const FDevNoteChangeSet& Changes)
+{
+	if (!GEditor || bSimulatedClient) return;
+
+	DEVNOTES_STAGE_SCOPE(Diagnostics, RefreshWaypoints);
+	LLM_SCOPE_BYTAG(DevNotes);
+
+	for (const FGuid& NoteId : Changes.Removed)
+	{
+		DestroyWaypoint(NoteId);
+	}
+
+	const TSet<FString> CurrentLevels = GetLoadedLevelPaths();
+	auto SyncWaypoint = [this, &CurrentLevels](const FGuid& NoteId)
+	{
+		// Notes moved to a level that isn't loaded lose their waypoint
+		TSharedPtr<FDevNote> Note = FindCachedNote(NoteId);
+		if (!Note.IsValid() || !CurrentLevels.Contains(Note->LevelPath.GetLongPackageName()))
+		{
+			DestroyWaypoint(NoteId);
+			return;
+		}
+
+		if (ADevNoteActor* Waypoint = WaypointsByNoteId.FindRef(NoteId).Get())
+		{
+			// Moving and relabelling the waypoint here must not be sent back to the server as an edit
+			Waypoint->bReadyForSync = false;
+			Waypoint->Note = Note;
+			Waypoint->SetActorLocation(Note->WorldPosition);
+			Waypoint->SetActorLabel(TEXT("DevNote ") + Note->Title, false);
+			Waypoint->bReadyForSync = true;
+		}
+		else if (ADevNoteActor* Spawned = SpawnWaypointForNote(Note))
+		{
+			WaypointsByNoteId.Add(NoteId, Spawned);
+		}
+	};
+
+	for (const FGuid& NoteId : Changes.Changed)
+	{
+		SyncWaypoint(NoteId);
+	}
+	for (const FGuid& NoteId : Changes.Added)
+	{
+		SyncWaypoint(NoteId);
+	}
+}
+
 TArray<TSharedPtr<FDevNote>> UDevNoteSubsystem::GetSelectedNoteWaypoints()
 {
 	TArray<TSharedPtr<FDevNote>> SelectedNotes;
@@ -1028,6 +1793,7 @@ void UDevNoteSubsystem::StoreSelectedNoteIDs()
 
 void UDevNoteSubsystem::PostTag(FDevNoteTag NoteTag)
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	FHttpModule* Http = &FHttpModule::Get();
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
 	Request->SetURL(GetServerAddress() + "/tags");
@@ -1048,14 +1814,16 @@ void UDevNoteSubsystem::PostTag(FDevNoteTag NoteTag)
 		if (bSuccess && Response->GetResponseCode() == EHttpResponseCodes::Created)
 		{
 			UE_LOG(LogDevNotes, Log, TEXT("Tag created successfully."));
+			RequestTagsFromServer();
 		}
 	});
 
-	Request->ProcessRequest();
+	ProcessRequest(Request);
 }
 
 void UDevNoteSubsystem::DeleteTag(const FGuid& TagId)
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
 	Request->SetURL(GetServerAddress() + "/tags/" + TagId.ToString(EGuidFormats::DigitsWithHyphens));
 	Request->SetVerb("DELETE");
@@ -1085,7 +1853,7 @@ void UDevNoteSubsystem::DeleteTag(const FGuid& TagId)
 		}
 	});
 
-	Request->ProcessRequest();
+	ProcessRequest(Request);
 
 }
 
@@ -1127,30 +1895,76 @@ const FDevNoteUser& UDevNoteSubsystem::GetUserById(const FGuid& UserId)
 void UDevNoteSubsystem::HandleUsersResponse(TSharedPtr<IHttpRequest> HttpRequest,
                                             TSharedPtr<IHttpResponse> HttpResponse, bool bWasSuccessful)
 {
-	CachedUsers.Empty();
 	HandleTokenInvalidation(HttpResponse);
 
-	if (bWasSuccessful && HttpResponse->GetResponseCode() == EHttpResponseCodes::Ok)
+	const bool bOk = bWasSuccessful && HttpResponse.IsValid() && HttpResponse->GetResponseCode() == EHttpResponseCodes::Ok;
+	ApplyUsersResponse(bOk ? HttpResponse->GetContentAsString() : FString(), bOk);
+}
+
+void UDevNoteSubsystem::ApplyUsersResponse(const FString& ResponseString, bool bSuccess)
+{
+	LLM_SCOPE_BYTAG(DevNotes);
+	TArray<FDevNoteUser> NewUsers;
+
+	// A failed request clears the users, a body that isn't a user list leaves them as they are
+	if (bSuccess)
 	{
-		FString ResponseString = HttpResponse->GetContentAsString();
+		DEVNOTES_STAGE_SCOPE(Diagnostics, Parse);
 		TArray<TSharedPtr<FJsonValue>> JsonArray;
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseString);
-		if (FJsonSerializer::Deserialize(Reader, JsonArray))
+		if (!FJsonSerializer::Deserialize(Reader, JsonArray))
+		{
+			UE_LOG(LogDevNotes, Warning, TEXT("Ignoring a users response that isn't a JSON array"));
+			return;
+		}
+		for (const auto& Item : JsonArray)
 		{
-			for (const auto& Item : JsonArray)
+			FDevNoteUser User;
+			if (ParseUserFromJsonObject(Item->AsObject(), User))
 			{
-				FDevNoteUser User;
-				if (ParseUserFromJsonObject(Item->AsObject(), User))
-				{
-					CachedUsers.Add(User);
-				}
+				NewUsers.Add(User);
 			}
 		}
 	}
+
+	// Users are polled with every note sync, so only a real change re-resolves names
+	{
+		DEVNOTES_STAGE_SCOPE(Diagnostics, ApplyCache);
+		TMap<FGuid, int32> OldIndexById;
+		OldIndexById.Reserve(CachedUsers.Num());
+		for (int32 i = 0; i < CachedUsers.Num(); ++i)
+		{
+			OldIndexById.Add(CachedUsers[i].Id, i);
+		}
+
+		bool bChanged = false;
+		for (const FDevNoteUser& User : NewUsers)
+		{
+			int32 OldIndex = INDEX_NONE;
+			if (!OldIndexById.RemoveAndCopyValue(User.Id, OldIndex) || !CachedUsers[OldIndex].Name.Equals(User.Name, ESearchCase::CaseSensitive))
+			{
+				bChanged = true;
+				break;
+			}
+		}
+		bChanged |= !OldIndexById.IsEmpty();
+
+		CachedUsers = MoveTemp(NewUsers);
+		if (!bChanged)
+		{
+			return;
+		}
+
+		SearchIndex.SetUsers(CachedUsers);
+		PublishSnapshot(FDevNoteChangeSet(), false, true);
+		RebuildSavedViews();
+	}
+	OnUsersUpdated.Broadcast();
 }
 
 void UDevNoteSubsystem::RequestUsersFromServer()
 {
+	DEVNOTES_SCOPE(BuildRequest);
 	FHttpModule* Http = &FHttpModule::Get();
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
 	
@@ -1159,5 +1973,5 @@ void UDevNoteSubsystem::RequestUsersFromServer()
 	Request->SetVerb("GET");
 	Request->SetHeader("Content-Type", "application/json");
 	Request->SetHeader(TEXT("X-Session-Token"), *SessionToken);
-	Request->ProcessRequest();
+	ProcessRequest(Request);
 }
@@ -0,0 +1,149 @@
+#include "DevNoteSyntheticData.h"
+
+#include "DevNoteSubsystem.h"
+#include "Misc/PackageName.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace DevNoteSyntheticData
+{
+	static const TCHAR* Words[] = {
+		TEXT("crash"), TEXT("lighting"), TEXT("collision"), TEXT("floating"), TEXT("texture"), TEXT("missing"),
+		TEXT("door"), TEXT("spawn"), TEXT("enemy"), TEXT("stuck"), TEXT("audio"), TEXT("navmesh"),
+		TEXT("seam"), TEXT("flicker"), TEXT("boss"), TEXT("checkpoint"), TEXT("foliage"), TEXT("ladder")
+	};
+
+	static const TCHAR* RandomWord(FRandomStream& Random)
+	{
+		return Words[Random.RandHelper(UE_ARRAY_COUNT(Words))];
+	}
+
+	static FString Serialize(const TArray<TSharedPtr<FJsonValue>>& Values)
+	{
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Values, Writer);
+		return Json;
+	}
+}
+
+FGuid FDevNoteSyntheticData::MakeGuid(FRandomStream& Random)
+{
+	return FGuid(Random.GetUnsignedInt(), Random.GetUnsignedInt(), Random.GetUnsignedInt(), Random.GetUnsignedInt());
+}
+
+FDevNoteSyntheticData FDevNoteSyntheticData::Generate(const FDevNoteSyntheticDataParams& Params)
+{
+	FRandomStream Random(Params.Seed);
+	FDevNoteSyntheticData Data;
+	Data.LatestTime = Params.LatestTime;
+
+	Data.Tags.Reserve(Params.NumTags);
+	for (int32 i = 0; i < Params.NumTags; ++i)
+	{
+		FDevNoteTag& Tag = Data.Tags.AddDefaulted_GetRef();
+		Tag.Id = MakeGuid(Random);
+		Tag.Name = i == 0 ? TEXT("Bug") : FString::Printf(TEXT("Tag%03d"), i);
+		Tag.Colour = Random.RandHelper(8);
+	}
+
+	Data.Users.Reserve(Params.NumUsers);
+	for (int32 i = 0; i < Params.NumUsers; ++i)
+	{
+		FDevNoteUser& User = Data.Users.AddDefaulted_GetRef();
+		User.Id = MakeGuid(Random);
+		User.Name = FString::Printf(TEXT("User%02d"), i);
+	}
+
+	Data.LevelPaths.Reserve(Params.NumLevels);
+	for (int32 i = 0; i < Params.NumLevels; ++i)
+	{
+		if (i == 0 && !Params.FirstLevelPackage.IsEmpty())
+		{
+			Data.LevelPaths.Add(Params.FirstLevelPackage + TEXT(".") + FPackageName::GetShortName(Params.FirstLevelPackage));
+			continue;
+		}
+		Data.LevelPaths.Add(FString::Printf(TEXT("/Game/Maps/Zone%02d.Zone%02d"), i, i));
+	}
+
+	Data.Notes.Reserve(Params.NumNotes);
+	for (int32 i = 0; i < Params.NumNotes; ++i)
+	{
+		FDevNote Note = Data.MakeNote(Random, Params.BodyWords);
+		for (int32 t = Random.RandHelper(Params.MaxTagsPerNote + 1); t > 0 && !Data.Tags.IsEmpty(); --t)
+		{
+			Note.Tags.AddUnique(Data.Tags[Random.RandHelper(Data.Tags.Num())].Id);
+		}
+		Data.Notes.Add(MoveTemp(Note));
+	}
+
+	return Data;
+}
+
+FDevNote FDevNoteSyntheticData::MakeNote(FRandomStream& Random, int32 BodyWords) const
+{
+	using namespace DevNoteSyntheticData;
+
+	FDevNote Note;
+	Note.Id = MakeGuid(Random);
+	Note.Title = FString::Printf(TEXT("%s %s near %s"), RandomWord(Random), RandomWord(Random), RandomWord(Random));
+	for (int32 Word = 0; Word < BodyWords; ++Word)
+	{
+		Note.Body += Word > 0 ? TEXT(" ") : TEXT("");
+		Note.Body += RandomWord(Random);
+	}
+	if (!Users.IsEmpty())
+	{
+		Note.CreatedById = Users[Random.RandHelper(Users.Num())].Id;
+	}
+	if (!LevelPaths.IsEmpty())
+	{
+		Note.LevelPath = FSoftObjectPath(LevelPaths[Random.RandHelper(LevelPaths.Num())]);
+	}
+	Note.WorldPosition = FVector(Random.FRandRange(-50000.0f, 50000.0f), Random.FRandRange(-50000.0f, 50000.0f), Random.FRandRange(0.0f, 5000.0f));
+	Note.CreatedAt = LatestTime - FTimespan::FromDays(Random.FRandRange(0.0f, 365.0f));
+	Note.LastEdited = Note.CreatedAt + FTimespan::FromDays(Random.FRandRange(0.0f, 30.0f));
+	return Note;
+}
+
+FString FDevNoteSyntheticData::NotesToJson(bool bSummary) const
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	Values.Reserve(Notes.Num());
+	for (const FDevNote& Note : Notes)
+	{
+		TSharedPtr<FJsonObject> NoteJson = UDevNoteSubsystem::ConvertNoteToJsonObject(Note);
+		NoteJson->SetStringField(TEXT("lastEdited"), Note.LastEdited.ToIso8601());
+		if (bSummary)
+		{
+			NoteJson->RemoveField(TEXT("body"));
+		}
+		Values.Add(MakeShared<FJsonValueObject>(NoteJson));
+	}
+	return DevNoteSyntheticData::Serialize(Values);
+}
+
+FString FDevNoteSyntheticData::TagsToJson() const
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	Values.Reserve(Tags.Num());
+	for (const FDevNoteTag& Tag : Tags)
+	{
+		Values.Add(MakeShared<FJsonValueObject>(UDevNoteSubsystem::ConvertTagToJsonObject(Tag)));
+	}
+	return DevNoteSyntheticData::Serialize(Values);
+}
+
+FString FDevNoteSyntheticData::UsersToJson() const
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	Values.Reserve(Users.Num());
+	for (const FDevNoteUser& User : Users)
+	{
+		TSharedPtr<FJsonObject> UserJson = MakeShared<FJsonObject>();
+		UserJson->SetStringField(TEXT("id"), User.Id.ToString(EGuidFormats::DigitsWithHyphens));
+		UserJson->SetStringField(TEXT("name"), User.Name);
+		Values.Add(MakeShared<FJsonValueObject>(UserJson));
+	}
+	return DevNoteSyntheticData::Serialize(Values);
+}
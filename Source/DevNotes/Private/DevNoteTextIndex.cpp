@@ -0,0 +1,271 @@
+﻿#include "DevNoteTextIndex.h"
+
+#include "Algo/BinarySearch.h"
+
+namespace DevNoteTextIndex
+{
+	// Very short words match too much to be useful, very long ones are usually pasted hashes or paths
+	static constexpr int32 MinWordLen = 2;
+	static constexpr int32 MaxWordLen = 40;
+
+	// A hit in the title says more about a note than a hit somewhere in a long body
+	static constexpr float TitleWeight = 3.0f;
+	static constexpr float WholeWordWeight = 1.5f;
+
+	static uint32 GetFingerprint(const FDevNote& Note)
+	{
+		return HashCombine(GetTypeHash(Note.Title), Note.bBodyLoaded ? GetTypeHash(Note.Body) + 1 : 0u);
+	}
+}
+
+void FDevNoteTextIndex::Tokenize(const FString& Text, TMap<FString, int32>& OutCounts)
+{
+	FString Word;
+	auto Flush = [&Word, &OutCounts]()
+	{
+		if (Word.Len() >= DevNoteTextIndex::MinWordLen)
+		{
+			++OutCounts.FindOrAdd(Word);
+		}
+		Word.Reset();
+	};
+
+	for (const TCHAR C : Text)
+	{
+		if (FChar::IsAlnum(C))
+		{
+			if (Word.Len() < DevNoteTextIndex::MaxWordLen)
+			{
+				Word.AppendChar(FChar::ToLower(C));
+			}
+		}
+		else
+		{
+			Flush();
+		}
+	}
+	Flush();
+}
+
+void FDevNoteTextIndex::UpdateNote(const FDevNote& Note)
+{
+	const uint32 Fingerprint = DevNoteTextIndex::GetFingerprint(Note);
+
+	FDoc* Doc = Docs.Find(Note.Id);
+	if (Doc && Doc->Fingerprint == Fingerprint)
+	{
+		return;
+	}
+
+	if (Doc)
+	{
+		RemoveDocWords(*Doc);
+	}
+	else
+	{
+		Doc = &Docs.Add(Note.Id);
+		if (FreeDocIds.Num() > 0)
+		{
+			Doc->DocId = FreeDocIds.Pop(EAllowShrinking::No);
+			NoteIdByDocId[Doc->DocId] = Note.Id;
+		}
+		else
+		{
+			Doc->DocId = NoteIdByDocId.Add(Note.Id);
+		}
+	}
+	Doc->Fingerprint = Fingerprint;
+
+	TMap<FString, int32> TitleCounts;
+	TMap<FString, int32> BodyCounts;
+	Tokenize(Note.Title, TitleCounts);
+	if (Note.bBodyLoaded)
+	{
+		Tokenize(Note.Body, BodyCounts);
+	}
+
+	TSet<FString> Words;
+	TitleCounts.GetKeys(Words);
+	for (const TPair<FString, int32>& Pair : BodyCounts)
+	{
+		Words.Add(Pair.Key);
+	}
+
+	Doc->Words.Reset(Words.Num());
+	for (const FString& Word : Words)
+	{
+		const int32* TitleCount = TitleCounts.Find(Word);
+		const int32* BodyCount = BodyCounts.Find(Word);
+
+		TArray<FPosting>* List = Postings.Find(Word);
+		if (!List)
+		{
+			List = &Postings.Add(Word);
+			bSortedWordsDirty = true;
+		}
+
+		FPosting& Posting = List->AddDefaulted_GetRef();
+		Posting.DocId = Doc->DocId;
+		Posting.TitleHits = static_cast<uint16>(FMath::Min(TitleCount ? *TitleCount : 0, static_cast<int32>(MAX_uint16)));
+		Posting.BodyHits = static_cast<uint16>(FMath::Min(BodyCount ? *BodyCount : 0, static_cast<int32>(MAX_uint16)));
+
+		Doc->Words.Add(Word);
+	}
+}
+
+void FDevNoteTextIndex::RemoveNote(const FGuid& NoteId)
+{
+	FDoc Doc;
+	if (!Docs.RemoveAndCopyValue(NoteId, Doc))
+	{
+		return;
+	}
+
+	RemoveDocWords(Doc);
+	NoteIdByDocId[Doc.DocId].Invalidate();
+	FreeDocIds.Add(Doc.DocId);
+}
+
+void FDevNoteTextIndex::SyncNotes(const TArray<TSharedPtr<FDevNote>>& Notes)
+{
+	TSet<FGuid> Present;
+	Present.Reserve(Notes.Num());
+	for (const TSharedPtr<FDevNote>& Note : Notes)
+	{
+		if (!Note.IsValid()) continue;
+		Present.Add(Note->Id);
+		UpdateNote(*Note);
+	}
+
+	TArray<FGuid> Removed;
+	for (const TPair<FGuid, FDoc>& Pair : Docs)
+	{
+		if (!Present.Contains(Pair.Key))
+		{
+			Removed.Add(Pair.Key);
+		}
+	}
+	for (const FGuid& NoteId : Removed)
+	{
+		RemoveNote(NoteId);
+	}
+}
+
+void FDevNoteTextIndex::Empty()
+{
+	Docs.Empty();
+	NoteIdByDocId.Empty();
+	FreeDocIds.Empty();
+	Postings.Empty();
+	SortedWords.Empty();
+	bSortedWordsDirty = false;
+}
+
+void FDevNoteTextIndex::RemoveDocWords(const FDoc& Doc)
+{
+	for (const FString& Word : Doc.Words)
+	{
+		TArray<FPosting>* List = Postings.Find(Word);
+		if (!List) continue;
+
+		List->RemoveAllSwap([DocId = Doc.DocId](const FPosting& Posting) { return Posting.DocId == DocId; }, EAllowShrinking::No);
+		if (List->IsEmpty())
+		{
+			Postings.Remove(Word);
+			bSortedWordsDirty = true;
+		}
+	}
+}
+
+void FDevNoteTextIndex::EnsureSortedWords() const
+{
+	if (!bSortedWordsDirty)
+	{
+		return;
+	}
+
+	Postings.GenerateKeyArray(SortedWords);
+	SortedWords.Sort([](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+	bSortedWordsDirty = false;
+}
+
+void FDevNoteTextIndex::SearchWord(const FString& Prefix, EField Fields, TMap<int32, float>& OutScores) const
+{
+	EnsureSortedWords();
+
+	const float NumDocs = static_cast<float>(FMath::Max(1, Docs.Num()));
+	const int32 First = Algo::LowerBound(SortedWords, Prefix, [](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+
+	for (int32 WordIndex = First; WordIndex < SortedWords.Num() && SortedWords[WordIndex].StartsWith(Prefix, ESearchCase::CaseSensitive); ++WordIndex)
+	{
+		const FString& Word = SortedWords[WordIndex];
+		const TArray<FPosting>& List = Postings.FindChecked(Word);
+
+		// Rare words are worth more than words every note has
+		const float Idf = FMath::Loge(1.0f + NumDocs / List.Num());
+		const float WordWeight = Word.Len() == Prefix.Len() ? DevNoteTextIndex::WholeWordWeight : 1.0f;
+
+		for (const FPosting& Posting : List)
+		{
+			float Hits = 0.0f;
+			if (EnumHasAnyFlags(Fields, EField::Title))
+			{
+				Hits += Posting.TitleHits * DevNoteTextIndex::TitleWeight;
+			}
+			if (EnumHasAnyFlags(Fields, EField::Body))
+			{
+				Hits += Posting.BodyHits;
+			}
+			if (Hits <= 0.0f) continue;
+
+			float& Score = OutScores.FindOrAdd(Posting.DocId);
+			Score = FMath::Max(Score, (1.0f + FMath::Loge(Hits)) * Idf * WordWeight);
+		}
+	}
+}
+
+bool FDevNoteTextIndex::Search(const FString& Phrase, EField Fields, TMap<FGuid, float>& OutScores) const
+{
+	TMap<FString, int32> Words;
+	Tokenize(Phrase, Words);
+	if (Words.IsEmpty())
+	{
+		return false;
+	}
+
+	// Every word of the phrase has to be found in the note
+	TMap<int32, float> PhraseScores;
+	bool bFirst = true;
+	for (const TPair<FString, int32>& Word : Words)
+	{
+		TMap<int32, float> WordScores;
+		SearchWord(Word.Key, Fields, WordScores);
+
+		if (bFirst)
+		{
+			PhraseScores = MoveTemp(WordScores);
+			bFirst = false;
+			continue;
+		}
+
+		for (auto It = PhraseScores.CreateIterator(); It; ++It)
+		{
+			if (const float* WordScore = WordScores.Find(It.Key()))
+			{
+				It.Value() += *WordScore;
+			}
+			else
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	OutScores.Reserve(OutScores.Num() + PhraseScores.Num());
+	for (const TPair<int32, float>& Pair : PhraseScores)
+	{
+		float& Score = OutScores.FindOrAdd(NoteIdByDocId[Pair.Key]);
+		Score = FMath::Max(Score, Pair.Value);
+	}
+	return true;
+}
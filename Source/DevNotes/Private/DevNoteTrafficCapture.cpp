@@ -0,0 +1,192 @@
+#include "DevNoteTrafficCapture.h"
+
+#include "DevNoteDiagnostics.h"
+#include "DevNoteSubsystem.h"
+#include "DevNotesLog.h"
+#include "Algo/StableSort.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace DevNoteTrafficCapture
+{
+	static const TCHAR* Scrubbed = TEXT("<scrubbed>");
+	static const TCHAR* SecretFields[] = { TEXT("token"), TEXT("sessionToken"), TEXT("Password") };
+
+	using FCondensedWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	static FString ToString(const TArray<uint8>& Content)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData()), Content.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+FDevNoteTrafficCapture::~FDevNoteTrafficCapture()
+{
+	Stop();
+}
+
+bool FDevNoteTrafficCapture::Start(const FString& InPath)
+{
+	Stop();
+
+	Path = InPath.IsEmpty()
+		? FPaths::ProjectSavedDir() / TEXT("DevNotes/Captures") / FString::Printf(TEXT("Capture-%s.jsonl"), *FDateTime::Now().ToString())
+		: InPath;
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogDevNotes, Error, TEXT("Could not create capture file %s"), *Path);
+		return false;
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	NumRecorded = 0;
+	UE_LOG(LogDevNotes, Display, TEXT("Capturing DevNotes traffic to %s"), *FPaths::ConvertRelativePathToFull(Path));
+	return true;
+}
+
+void FDevNoteTrafficCapture::Stop()
+{
+	if (Writer.IsValid())
+	{
+		Writer->Close();
+		Writer.Reset();
+		UE_LOG(LogDevNotes, Display, TEXT("Captured %d exchanges to %s"), NumRecorded, *Path);
+	}
+}
+
+void FDevNoteTrafficCapture::Record(const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, double RequestStartTime, double EndTime, const FString& SessionToken)
+{
+	using namespace DevNoteTrafficCapture;
+
+	if (!Writer.IsValid() || !Request.IsValid())
+	{
+		return;
+	}
+
+	const FString Secrets[] = { Request->GetHeader(TEXT("X-Session-Token")), SessionToken };
+
+	const TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetNumberField(TEXT("time"), EndTime - StartTime);
+	Json->SetNumberField(TEXT("durationMs"), (EndTime - RequestStartTime) * 1000.0);
+	Json->SetStringField(TEXT("verb"), Request->GetVerb());
+	Json->SetStringField(TEXT("url"), FDevNoteDiagnostics::GetPathAndQuery(Request->GetURL()));
+	Json->SetStringField(TEXT("requestBody"), Scrub(DevNoteTrafficCapture::ToString(Request->GetContent()), Secrets));
+	Json->SetNumberField(TEXT("responseCode"), Response.IsValid() ? Response->GetResponseCode() : 0);
+	Json->SetStringField(TEXT("responseBody"), Response.IsValid() ? Scrub(Response->GetContentAsString(), Secrets) : FString());
+
+	FString Line;
+	FJsonSerializer::Serialize(Json, FCondensedWriterFactory::Create(&Line));
+	Line += TEXT("\n");
+
+	const FTCHARToUTF8 Utf8(*Line);
+	Writer->Serialize((void*)Utf8.Get(), Utf8.Length());
+	Writer->Flush();
+	++NumRecorded;
+}
+
+bool FDevNoteTrafficCapture::Load(const FString& InPath, TArray<FDevNoteExchange>& OutExchanges)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *InPath))
+	{
+		return false;
+	}
+
+	OutExchanges.Reset(Lines.Num());
+	for (const FString& Line : Lines)
+	{
+		TSharedPtr<FJsonObject> Json;
+		if (Line.IsEmpty() || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), Json) || !Json.IsValid())
+		{
+			continue;
+		}
+
+		FDevNoteExchange& Exchange = OutExchanges.AddDefaulted_GetRef();
+		Json->TryGetNumberField(TEXT("time"), Exchange.Time);
+		Json->TryGetNumberField(TEXT("durationMs"), Exchange.DurationMs);
+		Json->TryGetStringField(TEXT("verb"), Exchange.Verb);
+		Json->TryGetStringField(TEXT("url"), Exchange.Url);
+		Json->TryGetStringField(TEXT("requestBody"), Exchange.RequestBody);
+		Json->TryGetNumberField(TEXT("responseCode"), Exchange.ResponseCode);
+		Json->TryGetStringField(TEXT("responseBody"), Exchange.ResponseBody);
+	}
+
+	// Lines are written as responses arrive, but a hand edited file may not be
+	Algo::StableSortBy(OutExchanges, &FDevNoteExchange::Time);
+	return true;
+}
+
+FString FDevNoteTrafficCapture::Scrub(const FString& Text, TConstArrayView<FString> Secrets)
+{
+	using namespace DevNoteTrafficCapture;
+
+	FString Result = Text;
+	for (const FString& Secret : Secrets)
+	{
+		if (!Secret.IsEmpty())
+		{
+			Result.ReplaceInline(*Secret, Scrubbed, ESearchCase::CaseSensitive);
+		}
+	}
+
+	// Tokens handed out by sign in aren't known yet when their response is recorded
+	TSharedPtr<FJsonObject> Json;
+	if (Result.StartsWith(TEXT("{")) && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Result), Json) && Json.IsValid())
+	{
+		bool bScrubbed = false;
+		for (const TCHAR* Field : SecretFields)
+		{
+			if (Json->HasField(Field))
+			{
+				Json->SetStringField(Field, Scrubbed);
+				bScrubbed = true;
+			}
+		}
+		if (bScrubbed)
+		{
+			Result.Reset();
+			FJsonSerializer::Serialize(Json.ToSharedRef(), FCondensedWriterFactory::Create(&Result));
+		}
+	}
+	return Result;
+}
+
+namespace DevNoteTrafficCaptureCommands
+{
+	static void Start(const TArray<FString>& Args)
+	{
+		if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+		{
+			Subsystem->GetTrafficCapture().Start(Args.Num() > 0 ? Args[0] : FString());
+		}
+	}
+
+	static void Stop()
+	{
+		if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+		{
+			Subsystem->GetTrafficCapture().Stop();
+		}
+	}
+}
+
+static FAutoConsoleCommand GDevNotesCaptureStartCommand(
+	TEXT("DevNotes.Capture.Start"),
+	TEXT("Records every DevNotes request and response, with session tokens scrubbed, for DevNotes.Replay.Start.\n")
+	TEXT("Usage: DevNotes.Capture.Start [Path=Saved/DevNotes/Captures/Capture-<date>.jsonl]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DevNoteTrafficCaptureCommands::Start));
+
+static FAutoConsoleCommand GDevNotesCaptureStopCommand(
+	TEXT("DevNotes.Capture.Stop"),
+	TEXT("Stops recording DevNotes traffic."),
+	FConsoleCommandDelegate::CreateStatic(&DevNoteTrafficCaptureCommands::Stop));
@@ -0,0 +1,187 @@
+#include "DevNoteTrafficReplay.h"
+
+#include "DevNoteSubsystem.h"
+#include "DevNotesLog.h"
+#include "HAL/IConsoleManager.h"
+
+namespace DevNoteTrafficReplay
+{
+	enum class EKind : uint8
+	{
+		None,
+		Notes,
+		Tags,
+		Users,
+	};
+
+	static EKind Classify(const FDevNoteExchange& Exchange)
+	{
+		if (Exchange.Verb != TEXT("GET") || Exchange.ResponseCode != 200)
+		{
+			return EKind::None;
+		}
+
+		int32 QueryStart = INDEX_NONE;
+		const FString Route = Exchange.Url.FindChar(TEXT('?'), QueryStart) ? Exchange.Url.Left(QueryStart) : Exchange.Url;
+		if (Route == TEXT("/notes"))
+		{
+			return EKind::Notes;
+		}
+		if (Route == TEXT("/tags"))
+		{
+			return EKind::Tags;
+		}
+		if (Route == TEXT("/users"))
+		{
+			return EKind::Users;
+		}
+		return EKind::None;
+	}
+}
+
+FDevNoteTrafficReplay::FDevNoteTrafficReplay(UDevNoteSubsystem& InTarget, TArray<FDevNoteExchange>&& InExchanges)
+	: Target(&InTarget)
+	, Exchanges(MoveTemp(InExchanges))
+{
+	NumLeftOut = Exchanges.RemoveAll([](const FDevNoteExchange& Exchange) { return !IsReplayable(Exchange); });
+}
+
+FDevNoteTrafficReplay::~FDevNoteTrafficReplay()
+{
+	Stop();
+}
+
+bool FDevNoteTrafficReplay::IsReplayable(const FDevNoteExchange& Exchange)
+{
+	return DevNoteTrafficReplay::Classify(Exchange) != DevNoteTrafficReplay::EKind::None;
+}
+
+void FDevNoteTrafficReplay::Start(float InSpeed)
+{
+	Stop();
+
+	Speed = FMath::Max(0.0f, InSpeed);
+	StartTime = FPlatformTime::Seconds();
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FDevNoteTrafficReplay::Tick));
+}
+
+void FDevNoteTrafficReplay::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+void FDevNoteTrafficReplay::ApplyAll()
+{
+	while (NextIndex < Exchanges.Num() && Target.IsValid())
+	{
+		ApplyNext();
+	}
+}
+
+bool FDevNoteTrafficReplay::Tick(float DeltaTime)
+{
+	if (Speed <= 0.0f)
+	{
+		if (NextIndex < Exchanges.Num() && Target.IsValid())
+		{
+			ApplyNext();
+		}
+	}
+	else
+	{
+		// Captured times are relative to the first replayed response, so a capture that starts idle doesn't wait
+		const double Elapsed = (FPlatformTime::Seconds() - StartTime) * Speed;
+		const double Origin = Exchanges.IsEmpty() ? 0.0 : Exchanges[0].Time;
+		while (NextIndex < Exchanges.Num() && Target.IsValid() && Exchanges[NextIndex].Time - Origin <= Elapsed)
+		{
+			ApplyNext();
+		}
+	}
+
+	if (NextIndex < Exchanges.Num() && Target.IsValid())
+	{
+		return true;
+	}
+
+	UE_LOG(LogDevNotes, Display, TEXT("Replayed %d of %d responses"), NextIndex, Exchanges.Num());
+	TickerHandle.Reset();
+	return false;
+}
+
+void FDevNoteTrafficReplay::ApplyNext()
+{
+	using namespace DevNoteTrafficReplay;
+
+	// The constructor left out failed exchanges, so every response here was a success
+	const FDevNoteExchange& Exchange = Exchanges[NextIndex++];
+	switch (Classify(Exchange))
+	{
+	case EKind::Notes:
+		Target->ApplyNotesResponse(Exchange.ResponseBody, Exchange.Url.Contains(TEXT("summary=true")));
+		break;
+	case EKind::Tags:
+		Target->ApplyTagsResponse(Exchange.ResponseBody, true);
+		break;
+	case EKind::Users:
+		Target->ApplyUsersResponse(Exchange.ResponseBody, true);
+		break;
+	default:
+		break;
+	}
+}
+
+namespace DevNoteTrafficReplayCommands
+{
+	static TSharedPtr<FDevNoteTrafficReplay> ActiveReplay;
+
+	static void Start(const TArray<FString>& Args)
+	{
+		UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+		if (!Subsystem || Args.IsEmpty())
+		{
+			UE_LOG(LogDevNotes, Warning, TEXT("Usage: DevNotes.Replay.Start <Path> [Speed=1]"));
+			return;
+		}
+
+		TArray<FDevNoteExchange> Exchanges;
+		if (!FDevNoteTrafficCapture::Load(Args[0], Exchanges))
+		{
+			UE_LOG(LogDevNotes, Error, TEXT("Could not read capture %s"), *Args[0]);
+			return;
+		}
+		if (Subsystem->IsLoggedIn())
+		{
+			UE_LOG(LogDevNotes, Warning, TEXT("Replaying while signed in, polls from the server will mix with the capture. Sign out first to replay it alone"));
+		}
+
+		ActiveReplay = MakeShared<FDevNoteTrafficReplay>(*Subsystem, MoveTemp(Exchanges));
+		const float Speed = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1.0f;
+		UE_LOG(LogDevNotes, Display, TEXT("Replaying %d responses from %s at %s, leaving out %d other exchanges"), ActiveReplay->Num(), *Args[0],
+			Speed > 0.0f ? *FString::Printf(TEXT("%gx speed"), Speed) : TEXT("one per frame"), ActiveReplay->GetNumLeftOut());
+		ActiveReplay->Start(Speed);
+	}
+
+	static void Stop()
+	{
+		if (ActiveReplay.IsValid())
+		{
+			ActiveReplay->Stop();
+			ActiveReplay.Reset();
+		}
+	}
+}
+
+static FAutoConsoleCommand GDevNotesReplayStartCommand(
+	TEXT("DevNotes.Replay.Start"),
+	TEXT("Feeds the notes, tags and users responses of a DevNotes.Capture.Start file back into the notes cache.\n")
+	TEXT("Usage: DevNotes.Replay.Start <Path> [Speed=1, 0 for one response per frame]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DevNoteTrafficReplayCommands::Start));
+
+static FAutoConsoleCommand GDevNotesReplayStopCommand(
+	TEXT("DevNotes.Replay.Stop"),
+	TEXT("Stops replaying captured DevNotes traffic."),
+	FConsoleCommandDelegate::CreateStatic(&DevNoteTrafficReplayCommands::Stop));
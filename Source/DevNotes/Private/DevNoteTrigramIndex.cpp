@@ -0,0 +1,166 @@
+#include "DevNoteTrigramIndex.h"
+
+#include "DevNoteTextIndex.h"
+
+void FDevNoteTrigramIndex::GetTrigrams(const FString& Word, TArray<uint64>& OutTrigrams)
+{
+	// Padding makes the start and end of a word count, so short words still get a few trigrams
+	const FString Padded = FString::Printf(TEXT("  %s "), *Word);
+
+	OutTrigrams.Reset(Padded.Len());
+	for (int32 i = 0; i + 2 < Padded.Len(); ++i)
+	{
+		const uint64 Trigram =
+			(static_cast<uint64>(static_cast<uint16>(Padded[i])) << 32) |
+			(static_cast<uint64>(static_cast<uint16>(Padded[i + 1])) << 16) |
+			static_cast<uint64>(static_cast<uint16>(Padded[i + 2]));
+		OutTrigrams.AddUnique(Trigram);
+	}
+}
+
+void FDevNoteTrigramIndex::AddText(const FString& Text)
+{
+	TMap<FString, int32> Counts;
+	FDevNoteTextIndex::Tokenize(Text, Counts);
+	for (const TPair<FString, int32>& Pair : Counts)
+	{
+		AddWord(Pair.Key);
+	}
+}
+
+void FDevNoteTrigramIndex::RemoveText(const FString& Text)
+{
+	TMap<FString, int32> Counts;
+	FDevNoteTextIndex::Tokenize(Text, Counts);
+	for (const TPair<FString, int32>& Pair : Counts)
+	{
+		RemoveWord(Pair.Key);
+	}
+}
+
+void FDevNoteTrigramIndex::Empty()
+{
+	WordIdByWord.Empty();
+	Words.Empty();
+	FreeWordIds.Empty();
+	WordIdsByTrigram.Empty();
+}
+
+void FDevNoteTrigramIndex::AddWord(const FString& Word)
+{
+	if (const int32* Existing = WordIdByWord.Find(Word))
+	{
+		++Words[*Existing].RefCount;
+		return;
+	}
+
+	const int32 WordId = FreeWordIds.Num() > 0 ? FreeWordIds.Pop(EAllowShrinking::No) : Words.AddDefaulted();
+	WordIdByWord.Add(Word, WordId);
+
+	TArray<uint64> Trigrams;
+	GetTrigrams(Word, Trigrams);
+
+	FWordInfo& Info = Words[WordId];
+	Info.Word = Word;
+	Info.RefCount = 1;
+	Info.NumTrigrams = Trigrams.Num();
+
+	for (const uint64 Trigram : Trigrams)
+	{
+		WordIdsByTrigram.FindOrAdd(Trigram).Add(WordId);
+	}
+}
+
+void FDevNoteTrigramIndex::RemoveWord(const FString& Word)
+{
+	const int32* Existing = WordIdByWord.Find(Word);
+	if (!Existing)
+	{
+		return;
+	}
+
+	const int32 WordId = *Existing;
+	if (--Words[WordId].RefCount > 0)
+	{
+		return;
+	}
+
+	TArray<uint64> Trigrams;
+	GetTrigrams(Word, Trigrams);
+	for (const uint64 Trigram : Trigrams)
+	{
+		if (TArray<int32>* WordIds = WordIdsByTrigram.Find(Trigram))
+		{
+			WordIds->RemoveSingleSwap(WordId, EAllowShrinking::No);
+			if (WordIds->IsEmpty())
+			{
+				WordIdsByTrigram.Remove(Trigram);
+			}
+		}
+	}
+
+	WordIdByWord.Remove(Word);
+	Words[WordId] = FWordInfo();
+	FreeWordIds.Add(WordId);
+}
+
+void FDevNoteTrigramIndex::FindCorrections(const FString& Term, float MinSimilarity, TArray<FMatch>& OutMatches, int32 MaxMatches) const
+{
+	OutMatches.Reset();
+
+	const FString Lower = Term.ToLower();
+	if (Lower.Len() < MinTermLen || MinSimilarity <= 0.0f)
+	{
+		return;
+	}
+	for (const TCHAR C : Lower)
+	{
+		// Vocabulary words never span separators, so such a term can't be a misspelling of one
+		if (!FChar::IsAlnum(C))
+		{
+			return;
+		}
+	}
+
+	TArray<uint64> Trigrams;
+	GetTrigrams(Lower, Trigrams);
+
+	// Count the trigrams each vocabulary word shares with the term. Only words sharing at least one are ever touched
+	TMap<int32, int32> SharedCounts;
+	for (const uint64 Trigram : Trigrams)
+	{
+		if (const TArray<int32>* WordIds = WordIdsByTrigram.Find(Trigram))
+		{
+			for (const int32 WordId : *WordIds)
+			{
+				++SharedCounts.FindOrAdd(WordId);
+			}
+		}
+	}
+
+	// A word containing the term shares its trigrams, so it is among the counted ones
+	for (const TPair<int32, int32>& Pair : SharedCounts)
+	{
+		const FWordInfo& Info = Words[Pair.Key];
+		if (Info.Word.Contains(Lower, ESearchCase::CaseSensitive))
+		{
+			OutMatches.Reset();
+			return;
+		}
+
+		const float Similarity = static_cast<float>(Pair.Value) / (Trigrams.Num() + Info.NumTrigrams - Pair.Value);
+		if (Similarity >= MinSimilarity)
+		{
+			OutMatches.Add({ Info.Word, Similarity });
+		}
+	}
+
+	OutMatches.Sort([](const FMatch& A, const FMatch& B)
+	{
+		return A.Similarity != B.Similarity ? A.Similarity > B.Similarity : A.Word.Compare(B.Word, ESearchCase::CaseSensitive) < 0;
+	});
+	if (OutMatches.Num() > MaxMatches)
+	{
+		OutMatches.SetNum(MaxMatches);
+	}
+}
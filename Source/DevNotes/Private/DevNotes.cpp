@@ -7,16 +7,27 @@
 #include "Misc/MessageDialog.h"
 #include "ToolMenus.h"
 #include "EditorCustomization/DevNoteActorCustomization.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/SDevNoteDiagnostics.h"
 #include "Widgets/SDevNotesDropdownWidget.h"
+#include "Widgets/SDevNoteViewBadges.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 
 #define LOCTEXT_NAMESPACE "FDevNotesModule"
 
+const FName FDevNotesModule::NotesTabName(TEXT("DevNotes"));
+const FName FDevNotesModule::DiagnosticsTabName(TEXT("DevNotesDiagnostics"));
+
 void FDevNotesModule::OnMapOpened(const FString& String, bool bArg)
 {
 	if (UDevNoteSubsystem* Subsystem = GEditor->GetEditorSubsystem<UDevNoteSubsystem>())
 	{
 		if (Subsystem->IsLoggedIn())
 		{
+			// Syncs only touch the waypoints of notes that changed, a new map needs all of its own
+			Subsystem->RefreshWaypointActors();
 			Subsystem->RequestNotesFromServer();
 		}
 	}
@@ -36,6 +47,18 @@ void FDevNotesModule::StartupModule()
 
 	// Refresh notes whenever a new map is opened
 	FEditorDelegates::OnMapOpened.AddRaw(this, &FDevNotesModule::OnMapOpened);
+
+	// Dockable notes tab, also listed under Window -> Level Editor
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(NotesTabName, FOnSpawnTab::CreateRaw(this, &FDevNotesModule::SpawnNotesTab))
+		.SetDisplayName(FText::FromString("Dev Notes"))
+		.SetTooltipText(FText::FromString("Browse and edit developer notes"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetLevelEditorCategory());
+
+	// Request latencies and sync timings, listed under Tools
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(DiagnosticsTabName, FOnSpawnTab::CreateRaw(this, &FDevNotesModule::SpawnDiagnosticsTab))
+		.SetDisplayName(FText::FromString("Dev Notes Diagnostics"))
+		.SetTooltipText(FText::FromString("Request latency, payload sizes and sync timings of the DevNotes plugin"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
 }
 
 
@@ -43,19 +66,30 @@ void FDevNotesModule::RegisterMenus()
 {
 	FToolMenuOwnerScoped OwnerScoped(this);
 
-	// Add a combo button dropdown to toolbar for custom DevNotes menu
+	// Add a toolbar button that brings up the DevNotes tab
 	UToolMenu* ToolbarMenu = UToolMenus::Get()->ExtendMenu("LevelEditor.LevelEditorToolBar.User");
 	FToolMenuSection& Section = ToolbarMenu->FindOrAddSection("DevNotes");
 	Section.AddEntry(FToolMenuEntry::InitWidget(
 			"DevNotesButton",
-			SNew(SComboButton)
-			.OnGetMenuContent(FOnGetContent::CreateRaw(this, &FDevNotesModule::GenerateNotesDropdown))
-			.ButtonContent()
+			SNew(SButton)
+			.OnClicked_Lambda([this]()
+			{
+				OpenNotesTab();
+				return FReply::Handled();
+			})
 			[
 				SNew(STextBlock).Text(FText::FromString("Notes"))
 			],
 			FText::FromString("Developer Notes")
 		));
+
+	// Live note counts of the saved views marked Show In Toolbar
+	Section.AddEntry(FToolMenuEntry::InitWidget(
+			"DevNotesViewBadges",
+			SNew(SDevNoteViewBadges)
+			.OnViewClicked_Raw(this, &FDevNotesModule::OpenSavedView),
+			FText::GetEmpty()
+		));
 }
 
 
@@ -65,34 +99,55 @@ void FDevNotesModule::ShutdownModule()
 	UToolMenus::UnregisterOwner(this);
 
 	FEditorDelegates::OnMapOpened.RemoveAll(this);
+
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(NotesTabName);
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(DiagnosticsTabName);
+	}
+	NotesWidget.Reset();
 }
 
 
-TSharedRef<SWidget> FDevNotesModule::GenerateNotesDropdown()
+void FDevNotesModule::OpenNotesTab()
 {
-	if (UDevNoteSubsystem* Subsystem = GEditor->GetEditorSubsystem<UDevNoteSubsystem>())
+	FGlobalTabmanager::Get()->TryInvokeTab(NotesTabName);
+}
+
+
+void FDevNotesModule::OpenSavedView(const FString& Name)
+{
+	OpenNotesTab();
+	if (NotesWidget.IsValid())
 	{
-		// Refresh notes whenever opened
-		Subsystem->RequestNotesFromServer();
-		const auto& notes = Subsystem->GetNotes();
+		NotesWidget->ApplySavedView(Name);
+	}
+}
 
-		// Cache and reuse a single notes widget
-		if (NotesWidget == nullptr)
-		{
-			NotesWidget = SNew(SDevNotesDropdownWidget);
-		}
 
-		NotesWidget->SetNotesSource(notes);
-	
-		return SNew(SBox)
-		.WidthOverride(600)
-		.HeightOverride(400)
+TSharedRef<SDockTab> FDevNotesModule::SpawnNotesTab(const FSpawnTabArgs& Args)
+{
+	// The widget keeps itself up to date from subsystem events, so showing it again fetches and re-filters nothing
+	if (NotesWidget == nullptr)
+	{
+		NotesWidget = SNew(SDevNotesDropdownWidget);
+	}
+
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
 		[
 			NotesWidget.ToSharedRef()
 		];
-	}
-	
-	return SNullWidget::NullWidget;
+}
+
+
+TSharedRef<SDockTab> FDevNotesModule::SpawnDiagnosticsTab(const FSpawnTabArgs& Args)
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(SDevNoteDiagnostics)
+		];
 }
 
 #undef LOCTEXT_NAMESPACE
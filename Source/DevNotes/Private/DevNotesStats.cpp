@@ -0,0 +1,51 @@
+#include "DevNotesStats.h"
+
+#include "ProfilingDebugging/CountersTrace.h"
+
+DEFINE_STAT(STAT_DevNotes_BuildRequest);
+DEFINE_STAT(STAT_DevNotes_Parse);
+DEFINE_STAT(STAT_DevNotes_ApplyCache);
+DEFINE_STAT(STAT_DevNotes_RefreshWaypoints);
+DEFINE_STAT(STAT_DevNotes_Filter);
+DEFINE_STAT(STAT_DevNotes_GenerateRows);
+DEFINE_STAT(STAT_DevNotes_NetworkWait);
+DEFINE_STAT(STAT_DevNotes_RequestsInFlight);
+DEFINE_STAT(STAT_DevNotes_BytesSent);
+DEFINE_STAT(STAT_DevNotes_BytesReceived);
+DEFINE_STAT(STAT_DevNotes_NotesParsed);
+DEFINE_STAT(STAT_DevNotes_ActorsSpawned);
+DEFINE_STAT(STAT_DevNotes_SearchEntriesMemory);
+
+LLM_DEFINE_TAG(DevNotes);
+
+TRACE_DECLARE_INT_COUNTER(DevNotes_BytesSent, TEXT("DevNotes/Bytes Sent"));
+TRACE_DECLARE_INT_COUNTER(DevNotes_BytesReceived, TEXT("DevNotes/Bytes Received"));
+TRACE_DECLARE_INT_COUNTER(DevNotes_NotesParsed, TEXT("DevNotes/Notes Parsed"));
+TRACE_DECLARE_INT_COUNTER(DevNotes_ActorsSpawned, TEXT("DevNotes/Actors Spawned"));
+
+namespace DevNotesStats
+{
+	void AddBytesSent(int64 Bytes)
+	{
+		INC_DWORD_STAT_BY(STAT_DevNotes_BytesSent, Bytes);
+		TRACE_COUNTER_ADD(DevNotes_BytesSent, Bytes);
+	}
+
+	void AddBytesReceived(int64 Bytes)
+	{
+		INC_DWORD_STAT_BY(STAT_DevNotes_BytesReceived, Bytes);
+		TRACE_COUNTER_ADD(DevNotes_BytesReceived, Bytes);
+	}
+
+	void AddNotesParsed(int32 Count)
+	{
+		INC_DWORD_STAT_BY(STAT_DevNotes_NotesParsed, Count);
+		TRACE_COUNTER_ADD(DevNotes_NotesParsed, Count);
+	}
+
+	void AddActorsSpawned(int32 Count)
+	{
+		INC_DWORD_STAT_BY(STAT_DevNotes_ActorsSpawned, Count);
+		TRACE_COUNTER_ADD(DevNotes_ActorsSpawned, Count);
+	}
+}
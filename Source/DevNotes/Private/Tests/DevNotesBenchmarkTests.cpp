@@ -0,0 +1,293 @@
+#include "Commandlets/DevNotesBenchmarkCommandlet.h"
+#include "DevNoteBodyCache.h"
+#include "DevNoteDiagnostics.h"
+#include "DevNoteQuery.h"
+#include "DevNoteSearchIndex.h"
+#include "DevNoteSubsystem.h"
+#include "DevNoteSyntheticData.h"
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DevNotesBenchmarkTests
+{
+	// Small enough to run with every test pass, large enough that every tag and level has notes
+	static FDevNoteSyntheticData Generate()
+	{
+		FDevNoteSyntheticDataParams Params;
+		Params.NumNotes = 2000;
+		Params.NumTags = 50;
+		Params.NumUsers = 20;
+		Params.NumLevels = 10;
+		Params.BodyWords = 8;
+		return FDevNoteSyntheticData::Generate(Params);
+	}
+
+	static void BuildIndex(const FDevNoteSyntheticData& Data, FDevNoteSearchIndex& OutIndex)
+	{
+		TArray<TSharedPtr<FDevNote>> Notes;
+		Notes.Reserve(Data.Notes.Num());
+		for (const FDevNote& Note : Data.Notes)
+		{
+			Notes.Add(MakeShared<FDevNote>(Note));
+		}
+		OutIndex.SetTags(Data.Tags);
+		OutIndex.SetUsers(Data.Users);
+		OutIndex.RebuildNotes(Notes);
+	}
+
+	static TSet<FGuid> Evaluate(const FString& QueryString, const FDevNoteSearchIndex& Index)
+	{
+		const FDevNoteQuery Query = FDevNoteQuery::Compile(QueryString, Index);
+		TArray<int32> Matches;
+		Query.Evaluate(Index.GetEntries(), nullptr, Matches);
+
+		TSet<FGuid> Ids;
+		for (const int32 EntryIndex : Matches)
+		{
+			Ids.Add(Index.GetEntries().GetId(EntryIndex));
+		}
+		return Ids;
+	}
+
+	static TSharedRef<FJsonObject> MakeBaselineCase(const FString& Name, int32 NumNotes, double MinMs, int64 Allocations)
+	{
+		TSharedRef<FJsonObject> Case = MakeShared<FJsonObject>();
+		Case->SetStringField(TEXT("name"), Name);
+		Case->SetNumberField(TEXT("notes"), NumNotes);
+		Case->SetNumberField(TEXT("minMs"), MinMs);
+		Case->SetNumberField(TEXT("allocations"), Allocations);
+		return Case;
+	}
+
+	static DevNotesBenchmark::FCaseResult MakeResult(const FString& Name, int32 NumNotes, double MinMs, int64 Allocations)
+	{
+		DevNotesBenchmark::FCaseResult Result;
+		Result.Name = Name;
+		Result.NumNotes = NumNotes;
+		Result.MinMs = MinMs;
+		Result.Allocations = Allocations;
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDevNotesParseTest, "DevNotes.Benchmark.Parse", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDevNotesParseTest::RunTest(const FString& Parameters)
+{
+	const FDevNoteSyntheticData Data = DevNotesBenchmarkTests::Generate();
+
+	TArray<FDevNote> Parsed;
+	TestTrue(TEXT("Full notes parse"), UDevNoteSubsystem::ParseNotesFromJson(Data.NotesToJson(), Parsed));
+	if (!TestEqual(TEXT("Every full note parsed"), Parsed.Num(), Data.Notes.Num()))
+	{
+		return false;
+	}
+	for (int32 i = 0; i < Parsed.Num(); ++i)
+	{
+		const FDevNote& Expected = Data.Notes[i];
+		const FDevNote& Actual = Parsed[i];
+		if (Actual.Id != Expected.Id || Actual.Title != Expected.Title || Actual.Body != Expected.Body || !Actual.bBodyLoaded
+			|| Actual.Tags != Expected.Tags || Actual.LevelPath != Expected.LevelPath || Actual.CreatedById != Expected.CreatedById)
+		{
+			AddError(FString::Printf(TEXT("Note %d did not survive a JSON round trip"), i));
+			break;
+		}
+	}
+
+	TArray<FDevNote> Summaries;
+	TestTrue(TEXT("Summaries parse"), UDevNoteSubsystem::ParseNotesFromJson(Data.NotesToJson(true), Summaries, true));
+	TestEqual(TEXT("Every summary parsed"), Summaries.Num(), Data.Notes.Num());
+	TestTrue(TEXT("Summaries have no body"), !Summaries.ContainsByPredicate([](const FDevNote& Note) { return Note.bBodyLoaded; }));
+
+	// A full sync that leaves bodies out is malformed, not a summary
+	TArray<FDevNote> Rejected;
+	UDevNoteSubsystem::ParseNotesFromJson(Data.NotesToJson(true), Rejected);
+	TestEqual(TEXT("Full notes without a body are rejected"), Rejected.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDevNotesFilterTest, "DevNotes.Benchmark.Filter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDevNotesFilterTest::RunTest(const FString& Parameters)
+{
+	using namespace DevNotesBenchmarkTests;
+
+	const FDevNoteSyntheticData Data = Generate();
+	FDevNoteSearchIndex Index;
+	BuildIndex(Data, Index);
+
+	// Tag 0 is "Bug", no other generated tag name contains it
+	const FGuid BugId = Data.Tags[0].Id;
+	TSet<FGuid> Expected;
+	for (const FDevNote& Note : Data.Notes)
+	{
+		if (Note.Tags.Contains(BugId))
+		{
+			Expected.Add(Note.Id);
+		}
+	}
+	const TSet<FGuid> Bugs = Evaluate(TEXT("tag=bug"), Index);
+	TestTrue(TEXT("tag=bug matches some notes"), Bugs.Num() > 0);
+	TestTrue(TEXT("tag=bug matches exactly the notes tagged Bug"), Bugs.Num() == Expected.Num() && Bugs.Includes(Expected));
+
+	// Generated times end now, so a relative range has to find the recent ones. A minute either side absorbs the clock moving
+	const FDateTime Now = FDateTime::UtcNow();
+	const FTimespan Slack = FTimespan::FromMinutes(1.0);
+	const TSet<FGuid> RecentBugs = Evaluate(TEXT("edited<30d tag=bug"), Index);
+	TestTrue(TEXT("edited<30d tag=bug matches some notes"), RecentBugs.Num() > 0);
+	for (const FDevNote& Note : Data.Notes)
+	{
+		const bool bRecentBug = Note.Tags.Contains(BugId) && Note.LastEdited >= Now - FTimespan::FromDays(30.0) + Slack;
+		const bool bOldOrNotBug = !Note.Tags.Contains(BugId) || Note.LastEdited < Now - FTimespan::FromDays(30.0) - Slack;
+		if ((bRecentBug && !RecentBugs.Contains(Note.Id)) || (bOldOrNotBug && RecentBugs.Contains(Note.Id)))
+		{
+			AddError(FString::Printf(TEXT("edited<30d tag=bug got note %s wrong"), *Note.Id.ToString()));
+			break;
+		}
+	}
+
+	const TSet<FGuid> Excluded = Evaluate(TEXT("-tag=bug"), Index);
+	TestEqual(TEXT("-tag=bug matches every other note"), Excluded.Num(), Data.Notes.Num() - Expected.Num());
+	TestTrue(TEXT("-tag=bug matches no Bug note"), Excluded.Intersect(Expected).IsEmpty());
+
+	// Refining reuses the previous results, so it must only be taken where the new clauses are stricter
+	const FDevNoteQuery Short = FDevNoteQuery::Compile(TEXT("tag=bu"), Index);
+	const FDevNoteQuery Long = FDevNoteQuery::Compile(TEXT("tag=bug"), Index);
+	TestTrue(TEXT("Extending a tag value narrows"), Long.IsNarrowingOf(Short));
+	const FDevNoteQuery ShortExclusion = FDevNoteQuery::Compile(TEXT("-tag=tag00"), Index);
+	const FDevNoteQuery LongExclusion = FDevNoteQuery::Compile(TEXT("-tag=tag001"), Index);
+	TestFalse(TEXT("Extending an exclusion does not narrow"), LongExclusion.IsNarrowingOf(ShortExclusion));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDevNotesTimeBoundTest, "DevNotes.Benchmark.TimeBound", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDevNotesTimeBoundTest::RunTest(const FString& Parameters)
+{
+	// Typed dates are local, so compare against local times converted the same way
+	const FDateTime UtcNow = FDateTime::UtcNow();
+	const FTimespan LocalOffset = FDateTime::Now() - UtcNow;
+	auto LocalTicks = [&LocalOffset](const FDateTime& Local) { return (Local - LocalOffset).GetTicks(); };
+
+	TOptional<FDevNoteQuery::FTimeBound> After;
+	TestTrue(TEXT("created>date parses"), FDevNoteQuery::ParseTimeBound(TEXT("created>2024-05-01"), UtcNow, After) && After.IsSet());
+	if (After.IsSet())
+	{
+		TestFalse(TEXT("created>date is a lower bound"), After->bUpper);
+		TestFalse(TEXT("Later the same day is not after the date"), LocalTicks(FDateTime(2024, 5, 1, 23, 59, 59)) >= After->Ticks);
+		TestTrue(TEXT("The next day is after the date"), LocalTicks(FDateTime(2024, 5, 2)) >= After->Ticks);
+	}
+
+	TOptional<FDevNoteQuery::FTimeBound> Before;
+	TestTrue(TEXT("created<date parses"), FDevNoteQuery::ParseTimeBound(TEXT("created<2024-05-01"), UtcNow, Before) && Before.IsSet());
+	if (Before.IsSet())
+	{
+		TestTrue(TEXT("created<date is an upper bound"), Before->bUpper);
+		TestTrue(TEXT("The day before is before the date"), LocalTicks(FDateTime(2024, 4, 30, 23, 59, 59)) < Before->Ticks);
+		TestFalse(TEXT("The date itself is not before it"), LocalTicks(FDateTime(2024, 5, 1)) < Before->Ticks);
+	}
+
+	// With a time of day, after means right after that moment
+	TOptional<FDevNoteQuery::FTimeBound> AfterTime;
+	TestTrue(TEXT("created>datetime parses"), FDevNoteQuery::ParseTimeBound(TEXT("created>2024-05-01T12:00:00"), UtcNow, AfterTime) && AfterTime.IsSet());
+	if (AfterTime.IsSet())
+	{
+		TestFalse(TEXT("The moment itself is not after it"), LocalTicks(FDateTime(2024, 5, 1, 12)) >= AfterTime->Ticks);
+		TestTrue(TEXT("Later the same day is after it"), LocalTicks(FDateTime(2024, 5, 1, 12, 0, 1)) >= AfterTime->Ticks);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDevNotesBodyCacheTest, "DevNotes.Benchmark.BodyCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDevNotesBodyCacheTest::RunTest(const FString& Parameters)
+{
+	const FString Body = FString::ChrN(100, TEXT('x'));
+	const int64 EntryBytes = Body.GetAllocatedSize();
+	const FDateTime Edited = FDateTime(2024, 1, 1);
+	const FGuid A = FGuid::NewGuid();
+	const FGuid B = FGuid::NewGuid();
+	const FGuid C = FGuid::NewGuid();
+
+	FDevNoteBodyCache Cache(EntryBytes * 2);
+	Cache.Add(A, Body, Edited);
+	Cache.Add(B, Body, Edited);
+
+	// Touching A leaves B as the least recently used body
+	FString Out;
+	TestTrue(TEXT("A is cached"), Cache.TryGet(A, Edited, Out));
+	Cache.Add(C, Body, Edited);
+	TestTrue(TEXT("A survives eviction"), Cache.Contains(A));
+	TestFalse(TEXT("B is evicted"), Cache.Contains(B));
+	TestTrue(TEXT("C is cached"), Cache.Contains(C));
+	TestEqual(TEXT("Budget is kept"), Cache.GetUsedBytes(), EntryBytes * 2);
+
+	// An edit on the server since the fetch invalidates the body
+	TestFalse(TEXT("Stale body is not returned"), Cache.TryGet(C, Edited + FTimespan::FromSeconds(1.0), Out));
+	TestFalse(TEXT("Stale body is dropped"), Cache.Contains(C));
+
+	Cache.SetMaxBytes(0);
+	TestEqual(TEXT("Shrinking the budget evicts everything"), Cache.Num(), 0);
+	TestEqual(TEXT("No bytes are left in use"), Cache.GetUsedBytes(), static_cast<int64>(0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDevNotesRequestRouteTest, "DevNotes.Benchmark.RequestRoute", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDevNotesRequestRouteTest::RunTest(const FString& Parameters)
+{
+	const FString NoteId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+	TestEqual(TEXT("Query strings are dropped"), FDevNoteDiagnostics::GetRequestRoute(TEXT("http://localhost:7125/notes?summary=true")), FString(TEXT("/notes")));
+	TestEqual(TEXT("Ids become {id}"), FDevNoteDiagnostics::GetRequestRoute(TEXT("http://localhost:7125/notes/") + NoteId), FString(TEXT("/notes/{id}")));
+	TestEqual(TEXT("Named routes are kept"), FDevNoteDiagnostics::GetRequestRoute(TEXT("http://localhost:7125/notes/query")), FString(TEXT("/notes/query")));
+	TestEqual(TEXT("Path and query keep the Id"), FDevNoteDiagnostics::GetPathAndQuery(TEXT("https://server/notes/") + NoteId + TEXT("?a=1")),
+		TEXT("/notes/") + NoteId + TEXT("?a=1"));
+
+	// Failures are remembered per route, whichever note they were for
+	FDevNoteDiagnostics Diagnostics;
+	FDevNoteRequestRecord Failed;
+	Failed.Verb = TEXT("GET");
+	Failed.Route = FDevNoteDiagnostics::GetRequestRoute(TEXT("http://localhost/notes/") + NoteId);
+	Failed.bFailed = true;
+	Failed.StartTime = FPlatformTime::Seconds();
+	Failed.EndTime = Failed.StartTime;
+	Diagnostics.BeginRequest();
+	Diagnostics.EndRequest(MoveTemp(Failed));
+	const FString OtherRoute = FDevNoteDiagnostics::GetRequestRoute(TEXT("http://localhost/notes/") + FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens));
+	TestTrue(TEXT("Another note's request counts as a retry"), Diagnostics.DidLastAttemptFail(TEXT("GET"), OtherRoute));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDevNotesRegressionTest, "DevNotes.Benchmark.Regression", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDevNotesRegressionTest::RunTest(const FString& Parameters)
+{
+	using namespace DevNotesBenchmarkTests;
+
+	TArray<TSharedPtr<FJsonValue>> Cases;
+	Cases.Add(MakeShared<FJsonValueObject>(MakeBaselineCase(TEXT("Slower"), 1000, 10.0, 1000)));
+	Cases.Add(MakeShared<FJsonValueObject>(MakeBaselineCase(TEXT("Noise"), 1000, 1.0, 1000)));
+	Cases.Add(MakeShared<FJsonValueObject>(MakeBaselineCase(TEXT("Allocates"), 1000, 10.0, 1000)));
+	Cases.Add(MakeShared<FJsonValueObject>(MakeBaselineCase(TEXT("Faster"), 1000, 10.0, 1000)));
+	FJsonObject Baseline;
+	Baseline.SetArrayField(TEXT("cases"), Cases);
+
+	TArray<DevNotesBenchmark::FCaseResult> Results;
+	Results.Add(MakeResult(TEXT("Slower"), 1000, 15.0, 1000));
+	Results.Add(MakeResult(TEXT("Noise"), 1000, 1.4, 1050));
+	Results.Add(MakeResult(TEXT("Allocates"), 1000, 10.0, 2000));
+	Results.Add(MakeResult(TEXT("Faster"), 1000, 5.0, 500));
+
+	// Not in the baseline at this size, so there is nothing to compare with
+	Results.Add(MakeResult(TEXT("Slower"), 10000, 100.0, 100000));
+
+	const TArray<FString> Regressions = DevNotesBenchmark::FindRegressions(Results, Baseline, 0.2);
+	TestEqual(TEXT("Two regressions"), Regressions.Num(), 2);
+	TestTrue(TEXT("Slower case reported"), Regressions.ContainsByPredicate([](const FString& Line) { return Line.StartsWith(TEXT("Slower@1000:")); }));
+	TestTrue(TEXT("Allocating case reported"), Regressions.ContainsByPredicate([](const FString& Line) { return Line.StartsWith(TEXT("Allocates@1000:")); }));
+	return true;
+}
+
+#endif
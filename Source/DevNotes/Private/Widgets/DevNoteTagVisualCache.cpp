@@ -0,0 +1,81 @@
+#include "DevNoteTagVisualCache.h"
+
+#include "DevNoteSubsystem.h"
+#include "FDevNoteTag.h"
+#include "Styling/AppStyle.h"
+
+FDevNoteTagVisualCache::FDevNoteTagVisualCache()
+{
+    DotBrush = FAppStyle::GetBrush("Icons.FilledCircle");
+
+    if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+    {
+        TagsChangedHandle = Subsystem->OnTagsChanged.AddRaw(this, &FDevNoteTagVisualCache::ApplyChanges);
+    }
+    Rebuild();
+}
+
+FDevNoteTagVisualCache::~FDevNoteTagVisualCache()
+{
+    if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+    {
+        Subsystem->OnTagsChanged.Remove(TagsChangedHandle);
+    }
+}
+
+void FDevNoteTagVisualCache::Rebuild()
+{
+    Visuals.Reset();
+    ++Version;
+
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    const TArray<FDevNoteTag>& Tags = Subsystem->GetCachedTags();
+    Visuals.Reserve(Tags.Num());
+    for (const FDevNoteTag& Tag : Tags)
+    {
+        SetVisual(Tag);
+    }
+}
+
+void FDevNoteTagVisualCache::ApplyChanges(const FDevNoteChangeSet& Changes)
+{
+    ++Version;
+    for (const FGuid& TagId : Changes.Removed)
+    {
+        Visuals.Remove(TagId);
+    }
+
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem || (Changes.Added.IsEmpty() && Changes.Changed.IsEmpty()))
+    {
+        return;
+    }
+
+    for (const FDevNoteTag& Tag : Subsystem->GetCachedTags())
+    {
+        if (Changes.WasChanged(Tag.Id) || Changes.Added.Contains(Tag.Id))
+        {
+            SetVisual(Tag);
+        }
+    }
+}
+
+void FDevNoteTagVisualCache::SetVisual(const FDevNoteTag& Tag)
+{
+    FColor TagColor;
+    TagColor.DWColor() = Tag.Colour;
+
+    FVisual& Visual = Visuals.FindOrAdd(Tag.Id);
+    Visual.Color = FLinearColor::FromSRGBColor(TagColor);
+    Visual.Name = FText::FromString(Tag.Name);
+    Visual.ToolTip = FText::FromString(FString::Printf(TEXT("%s\nColor: R=%.2f G=%.2f B=%.2f"),
+        *Tag.Name,
+        Visual.Color.R,
+        Visual.Color.G,
+        Visual.Color.B));
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSlateBrush;
+struct FDevNoteChangeSet;
+struct FDevNoteTag;
+
+/**
+ * Display data for every known tag (colour, name, tooltip), built once per tag sync instead of per list row.
+ * Only the tags named in the subsystem's OnTagsChanged events are rebuilt.
+ */
+class FDevNoteTagVisualCache
+{
+public:
+    struct FVisual
+    {
+        FLinearColor Color = FLinearColor::White;
+        FText Name;
+        FText ToolTip;
+    };
+
+    FDevNoteTagVisualCache();
+    ~FDevNoteTagVisualCache();
+
+    const FVisual* Find(const FGuid& TagId) const { return Visuals.Find(TagId); }
+
+    // Brush every tag dot is drawn with, tinted with the tag colour
+    const FSlateBrush* GetDotBrush() const { return DotBrush; }
+
+    // Bumped on every rebuild or change, which may move visuals: widgets holding pointers to them look them up again
+    uint32 GetVersion() const { return Version; }
+
+    void Rebuild();
+    void ApplyChanges(const FDevNoteChangeSet& Changes);
+
+private:
+    void SetVisual(const FDevNoteTag& Tag);
+
+    TMap<FGuid, FVisual> Visuals;
+    const FSlateBrush* DotBrush = nullptr;
+    uint32 Version = 0;
+    FDelegateHandle TagsChangedHandle;
+};
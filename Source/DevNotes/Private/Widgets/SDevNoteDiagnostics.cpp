@@ -0,0 +1,342 @@
+#include "SDevNoteDiagnostics.h"
+
+#include "DevNoteSubsystem.h"
+#include "HAL/PlatformApplicationMisc.h"
+#include "Rendering/DrawElements.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SGridPanel.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SLeafWidget.h"
+#include "Widgets/Text/STextBlock.h"
+
+namespace DevNoteDiagnosticsPanel
+{
+    static constexpr float RefreshSeconds = 1.0f;
+
+    static FText FormatMs(double Ms)
+    {
+        FNumberFormattingOptions Options;
+        Options.MaximumFractionalDigits = Ms < 10.0 ? 2 : 0;
+        return FText::Format(FText::FromString(TEXT("{0} ms")), FText::AsNumber(Ms, &Options));
+    }
+
+    static FText FormatBytes(int64 Bytes)
+    {
+        return FText::AsMemory(Bytes);
+    }
+}
+
+// Bars of a latency histogram, scaled to the fullest bucket
+class SDevNoteLatencyHistogram : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SDevNoteLatencyHistogram) {}
+        SLATE_ARGUMENT(const FDevNoteLatencySummary*, Summary)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs)
+    {
+        Summary = InArgs._Summary;
+        BarBrush = FAppStyle::GetBrush("WhiteBrush");
+        SetToolTipText(MakeAttributeSP(this, &SDevNoteLatencyHistogram::GetToolTip));
+    }
+
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override
+    {
+        return FVector2D(FDevNoteLatencySummary::NumBuckets * (BarWidth + BarSpacing), Height);
+    }
+
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+    {
+        int32 Fullest = 0;
+        for (const int32 Count : Summary->Histogram)
+        {
+            Fullest = FMath::Max(Fullest, Count);
+        }
+
+        const FLinearColor Color = InWidgetStyle.GetColorAndOpacityTint() * FLinearColor(0.2f, 0.6f, 1.0f);
+        for (int32 Bucket = 0; Bucket < FDevNoteLatencySummary::NumBuckets; ++Bucket)
+        {
+            // Empty buckets keep a sliver so the scale stays readable
+            const float BarHeight = Fullest > 0 ? FMath::Max(1.0f, Height * Summary->Histogram[Bucket] / Fullest) : 1.0f;
+            FSlateDrawElement::MakeBox(
+                OutDrawElements,
+                LayerId,
+                AllottedGeometry.ToPaintGeometry(FVector2f(BarWidth, BarHeight), FSlateLayoutTransform(FVector2f(Bucket * (BarWidth + BarSpacing), Height - BarHeight))),
+                BarBrush,
+                ESlateDrawEffect::None,
+                Color);
+        }
+        return LayerId;
+    }
+
+private:
+    FText GetToolTip() const
+    {
+        FString Lines;
+        for (int32 Bucket = 0; Bucket < FDevNoteLatencySummary::NumBuckets; ++Bucket)
+        {
+            const FString Label = Bucket < FDevNoteLatencySummary::NumBuckets - 1
+                ? FString::Printf(TEXT("< %.0f ms"), FDevNoteLatencySummary::BucketLimitsMs[Bucket])
+                : FString::Printf(TEXT(">= %.0f ms"), FDevNoteLatencySummary::BucketLimitsMs[Bucket - 1]);
+            Lines += FString::Printf(TEXT("%s%s: %d"), Lines.IsEmpty() ? TEXT("") : TEXT("\n"), *Label, Summary->Histogram[Bucket]);
+        }
+        return FText::FromString(Lines);
+    }
+
+    static constexpr float BarWidth = 6.0f;
+    static constexpr float BarSpacing = 1.0f;
+    static constexpr float Height = 16.0f;
+
+    // Owned by the diagnostics panel, which outlives its rows
+    const FDevNoteLatencySummary* Summary = nullptr;
+    const FSlateBrush* BarBrush = nullptr;
+};
+
+void SDevNoteDiagnostics::Construct(const FArguments& InArgs)
+{
+    RefreshSummaries();
+    RegisterActiveTimer(DevNoteDiagnosticsPanel::RefreshSeconds, FWidgetActiveTimerDelegate::CreateSP(this, &SDevNoteDiagnostics::OnRefreshElapsed));
+
+    ChildSlot
+    [
+        SNew(SScrollBox)
+        + SScrollBox::Slot()
+        .Padding(8.0f)
+        [
+            SNew(SVerticalBox)
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0.0f, 0.0f, 0.0f, 8.0f)
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                [
+                    SNew(STextBlock)
+                    .Text(FText::FromString(TEXT("Last minutes:")))
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(4.0f, 0.0f)
+                [
+                    SNew(SBox)
+                    .WidthOverride(60.0f)
+                    [
+                        SNew(SSpinBox<int32>)
+                        .MinValue(1)
+                        .MaxValue(static_cast<int32>(FDevNoteDiagnostics::WindowSeconds / 60.0))
+                        .Value_Lambda([this]() { return WindowMinutes; })
+                        .OnValueChanged_Lambda([this](int32 Value)
+                        {
+                            WindowMinutes = Value;
+                            RefreshSummaries();
+                        })
+                    ]
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(4.0f, 0.0f)
+                [
+                    SNew(SButton)
+                    .Text(FText::FromString(TEXT("Dump Chrome Trace")))
+                    .ToolTipText(FText::FromString(TEXT("Write requests and sync stages of the last minutes to Saved/DevNotes, for chrome://tracing or Perfetto. The path is copied to the clipboard")))
+                    .OnClicked(this, &SDevNoteDiagnostics::OnDumpTraceClicked)
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .VAlign(VAlign_Center)
+                .Padding(8.0f, 0.0f)
+                [
+                    SNew(STextBlock)
+                    .Text(this, &SDevNoteDiagnostics::GetQueueText)
+                ]
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            [
+                MakeRequestTable()
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0.0f, 12.0f, 0.0f, 0.0f)
+            [
+                MakeStageTable()
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0.0f, 8.0f, 0.0f, 0.0f)
+            [
+                SNew(STextBlock)
+                .Text_Lambda([this]()
+                {
+                    return LastTracePath.IsEmpty() ? FText::GetEmpty() : FText::FromString(TEXT("Trace written to ") + LastTracePath);
+                })
+            ]
+        ]
+    ];
+}
+
+EActiveTimerReturnType SDevNoteDiagnostics::OnRefreshElapsed(double InCurrentTime, float InDeltaTime)
+{
+    RefreshSummaries();
+    return EActiveTimerReturnType::Continue;
+}
+
+void SDevNoteDiagnostics::RefreshSummaries()
+{
+    const UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    const FDevNoteDiagnostics& Diagnostics = Subsystem->GetDiagnostics();
+    const double SinceTime = FPlatformTime::Seconds() - WindowMinutes * 60.0;
+    for (int32 Endpoint = 0; Endpoint < static_cast<int32>(EDevNoteEndpoint::Num); ++Endpoint)
+    {
+        RequestSummaries[Endpoint] = Diagnostics.SummarizeRequests(static_cast<EDevNoteEndpoint>(Endpoint), SinceTime);
+    }
+    for (int32 Stage = 0; Stage < static_cast<int32>(EDevNoteStage::Num); ++Stage)
+    {
+        StageSummaries[Stage] = Diagnostics.SummarizeStage(static_cast<EDevNoteStage>(Stage), SinceTime);
+    }
+    RequestsInFlight = Diagnostics.GetRequestsInFlight();
+    PeakRequestsInFlight = Diagnostics.GetPeakRequestsInFlight(SinceTime);
+}
+
+TSharedRef<SWidget> SDevNoteDiagnostics::MakeRequestTable()
+{
+    using namespace DevNoteDiagnosticsPanel;
+
+    static const TCHAR* Headers[] = {
+        TEXT("Endpoint"), TEXT("Requests"), TEXT("p50"), TEXT("p95"), TEXT("p99"), TEXT("Max"), TEXT("Latency"),
+        TEXT("Payload p50"), TEXT("Payload p95"), TEXT("Payload Max"), TEXT("Failed"), TEXT("Retried")
+    };
+
+    TSharedRef<SGridPanel> Grid = SNew(SGridPanel);
+    for (int32 Column = 0; Column < UE_ARRAY_COUNT(Headers); ++Column)
+    {
+        Grid->AddSlot(Column, 0)
+        .Padding(6.0f, 2.0f)
+        [
+            SNew(STextBlock)
+            .Font(FCoreStyle::GetDefaultFontStyle("Bold", 9))
+            .Text(FText::FromString(Headers[Column]))
+        ];
+    }
+
+    for (int32 Endpoint = 0; Endpoint < static_cast<int32>(EDevNoteEndpoint::Num); ++Endpoint)
+    {
+        const FDevNoteLatencySummary* Summary = &RequestSummaries[Endpoint];
+        const int32 Row = Endpoint + 1;
+        auto AddText = [&Grid, Row](int32 Column, TAttribute<FText> Text)
+        {
+            Grid->AddSlot(Column, Row)
+            .Padding(6.0f, 2.0f)
+            .VAlign(VAlign_Center)
+            [
+                SNew(STextBlock)
+                .Text(Text)
+            ];
+        };
+
+        AddText(0, FText::FromString(FDevNoteDiagnostics::GetEndpointName(static_cast<EDevNoteEndpoint>(Endpoint))));
+        AddText(1, MakeAttributeLambda([Summary]() { return FText::AsNumber(Summary->Count); }));
+        AddText(2, MakeAttributeLambda([Summary]() { return FormatMs(Summary->P50Ms); }));
+        AddText(3, MakeAttributeLambda([Summary]() { return FormatMs(Summary->P95Ms); }));
+        AddText(4, MakeAttributeLambda([Summary]() { return FormatMs(Summary->P99Ms); }));
+        AddText(5, MakeAttributeLambda([Summary]() { return FormatMs(Summary->MaxMs); }));
+        Grid->AddSlot(6, Row)
+        .Padding(6.0f, 2.0f)
+        .VAlign(VAlign_Center)
+        [
+            SNew(SDevNoteLatencyHistogram)
+            .Summary(Summary)
+        ];
+        AddText(7, MakeAttributeLambda([Summary]() { return FormatBytes(Summary->P50Bytes); }));
+        AddText(8, MakeAttributeLambda([Summary]() { return FormatBytes(Summary->P95Bytes); }));
+        AddText(9, MakeAttributeLambda([Summary]() { return FormatBytes(Summary->MaxBytes); }));
+        AddText(10, MakeAttributeLambda([Summary]() { return FText::AsNumber(Summary->NumFailed); }));
+        AddText(11, MakeAttributeLambda([Summary]() { return FText::AsNumber(Summary->NumRetried); }));
+    }
+
+    return Grid;
+}
+
+TSharedRef<SWidget> SDevNoteDiagnostics::MakeStageTable()
+{
+    using namespace DevNoteDiagnosticsPanel;
+
+    static const TCHAR* Headers[] = {
+        TEXT("Sync Stage"), TEXT("Runs"), TEXT("p50"), TEXT("p95"), TEXT("p99"), TEXT("Max"), TEXT("Duration")
+    };
+
+    TSharedRef<SGridPanel> Grid = SNew(SGridPanel);
+    for (int32 Column = 0; Column < UE_ARRAY_COUNT(Headers); ++Column)
+    {
+        Grid->AddSlot(Column, 0)
+        .Padding(6.0f, 2.0f)
+        [
+            SNew(STextBlock)
+            .Font(FCoreStyle::GetDefaultFontStyle("Bold", 9))
+            .Text(FText::FromString(Headers[Column]))
+        ];
+    }
+
+    for (int32 Stage = 0; Stage < static_cast<int32>(EDevNoteStage::Num); ++Stage)
+    {
+        const FDevNoteLatencySummary* Summary = &StageSummaries[Stage];
+        const int32 Row = Stage + 1;
+        auto AddText = [&Grid, Row](int32 Column, TAttribute<FText> Text)
+        {
+            Grid->AddSlot(Column, Row)
+            .Padding(6.0f, 2.0f)
+            .VAlign(VAlign_Center)
+            [
+                SNew(STextBlock)
+                .Text(Text)
+            ];
+        };
+
+        AddText(0, FText::FromString(FDevNoteDiagnostics::GetStageName(static_cast<EDevNoteStage>(Stage))));
+        AddText(1, MakeAttributeLambda([Summary]() { return FText::AsNumber(Summary->Count); }));
+        AddText(2, MakeAttributeLambda([Summary]() { return FormatMs(Summary->P50Ms); }));
+        AddText(3, MakeAttributeLambda([Summary]() { return FormatMs(Summary->P95Ms); }));
+        AddText(4, MakeAttributeLambda([Summary]() { return FormatMs(Summary->P99Ms); }));
+        AddText(5, MakeAttributeLambda([Summary]() { return FormatMs(Summary->MaxMs); }));
+        Grid->AddSlot(6, Row)
+        .Padding(6.0f, 2.0f)
+        .VAlign(VAlign_Center)
+        [
+            SNew(SDevNoteLatencyHistogram)
+            .Summary(Summary)
+        ];
+    }
+
+    return Grid;
+}
+
+FReply SDevNoteDiagnostics::OnDumpTraceClicked()
+{
+    if (const UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+    {
+        LastTracePath = Subsystem->GetDiagnostics().DumpChromeTrace(WindowMinutes);
+        if (!LastTracePath.IsEmpty())
+        {
+            FPlatformApplicationMisc::ClipboardCopy(*LastTracePath);
+        }
+    }
+    return FReply::Handled();
+}
+
+FText SDevNoteDiagnostics::GetQueueText() const
+{
+    return FText::Format(FText::FromString(TEXT("Requests in flight: {0} (peak {1})")),
+        FText::AsNumber(RequestsInFlight), FText::AsNumber(PeakRequestsInFlight));
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DevNoteDiagnostics.h"
+#include "Widgets/SCompoundWidget.h"
+
+class SGridPanel;
+
+/**
+ * The plugin's health at a glance: request latency percentiles and histograms per endpoint, payload sizes,
+ * failures and retries, sync stage timings and queue depth, over the last few minutes.
+ */
+class SDevNoteDiagnostics : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SDevNoteDiagnostics) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+private:
+    EActiveTimerReturnType OnRefreshElapsed(double InCurrentTime, float InDeltaTime);
+    void RefreshSummaries();
+
+    TSharedRef<SWidget> MakeRequestTable();
+    TSharedRef<SWidget> MakeStageTable();
+    FReply OnDumpTraceClicked();
+
+    FText GetQueueText() const;
+
+    // Minutes of history the summaries and trace dumps cover
+    int32 WindowMinutes = 5;
+
+    FDevNoteLatencySummary RequestSummaries[static_cast<int32>(EDevNoteEndpoint::Num)];
+    FDevNoteLatencySummary StageSummaries[static_cast<int32>(EDevNoteStage::Num)];
+    int32 RequestsInFlight = 0;
+    int32 PeakRequestsInFlight = 0;
+    FString LastTracePath;
+};
@@ -12,6 +12,8 @@
 #include "FDevNoteTag.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Misc/MessageDialog.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Input/SComboBox.h"
 #include "PropertyCustomizationHelpers.h"
@@ -21,18 +23,19 @@
 // Add this near the top with other includes
 #include "Widgets/Colors/SColorBlock.h"
 #include "Widgets/Layout/SWrapBox.h"
+#include "Widgets/SInvalidationPanel.h"
 
 
 FString SDevNoteEditor::GetLevelPath() const
 {
-    if (SelectedNote == nullptr) return FString();
-    
-    return SelectedNote->LevelPath.ToString();
+    // Polled by the entry box every frame, so it only returns the string cached on note change
+    return LevelPathText;
 }
 
 void SDevNoteEditor::OnLevelPathChanged(const FAssetData& AssetData)
 {
     SelectedNote->LevelPath = AssetData.GetSoftObjectPath();
+    LevelPathText = SelectedNote->LevelPath.ToString();
     UDevNoteSubsystem::Get()->UpdateNote(*SelectedNote);
 }
 
@@ -48,285 +51,247 @@ void SDevNoteEditor::Construct(const FArguments& InArgs)
     TitleText = SelectedNote.IsValid() ? SelectedNote->Title : FString();
     BodyText = SelectedNote.IsValid() ? SelectedNote->Body : FString();
 
-    // Initialize tags list
-    RefreshTagsList();
-
     // Create the tag picker widget early so we can reference it in CreateTagDisplay
     SAssignNew(TagPicker, SDevNoteTagPicker)
-        .AvailableTags(&TagsList)
         .SelectedTagIds(SelectedNote.IsValid() ? &SelectedNote->Tags : nullptr)
         .OnTagAdded(this, &SDevNoteEditor::OnTagAdded)
         .OnNewTagCreated(this, &SDevNoteEditor::OnNewTagCreated)
-        .OnTagListOpened(this, &SDevNoteEditor::OnTagPickerOpened)
-        .IsEnabled_Lambda([this]() -> bool {
-            return SelectedNote.IsValid();
-        });
+        .OnTagListOpened(this, &SDevNoteEditor::OnTagPickerOpened);
 
 
-    UDevNoteSubsystem::Get()->OnTagsUpdated.AddSP(SharedThis(this), &SDevNoteEditor::RefreshTagsList);
-    
+    UDevNoteSubsystem::Get()->OnNotesChanged.AddSP(SharedThis(this), &SDevNoteEditor::OnNotesChanged);
+    UDevNoteSubsystem::Get()->OnTagsChanged.AddSP(SharedThis(this), &SDevNoteEditor::OnTagsChanged);
+    UDevNoteSubsystem::Get()->OnUsersUpdated.AddSP(SharedThis(this), &SDevNoteEditor::RefreshDetailsText);
+    UDevNoteSubsystem::Get()->OnNoteBodyLoaded.AddSP(SharedThis(this), &SDevNoteEditor::OnNoteBodyLoaded);
+    UDevNoteSubsystem::Get()->OnNoteUpdateFailed.AddSP(SharedThis(this), &SDevNoteEditor::OnNoteUpdateFailed);
+    RequestBodyIfNeeded();
     
+    // Nothing below is bound to per-frame lambdas: text and enabled states are pushed in RefreshFromNote when the note changes,
+    // so the cached panel only repaints when one of its widgets actually invalidates
     ChildSlot
     [
-        SNew(SVerticalBox)
-
-        // Title
-        + SVerticalBox::Slot()
-        .AutoHeight()
-        .Padding(FMargin(0, 0, 0, 6))
+        SNew(SInvalidationPanel)
         [
-            SNew(SEditableTextBox)
-            .Font(FCoreStyle::GetDefaultFontStyle("Bold", 16))
-            .Text_Lambda([this]() -> FText {
-                return FText::FromString(TitleText);
-            })
-            .OnTextChanged_Lambda([this](const FText& NewText) {
-                TitleText = NewText.ToString();
-                UDevNoteSubsystem::Get()->SetEditorEditingState(true);
-            })
-            .IsEnabled_Lambda([this]() -> bool {
-                return SelectedNote.IsValid();
-            })
-            .HintText(FText::FromString(TEXT("Note Title")))
-            .OnTextCommitted_Lambda([this](const FText& NewText, ETextCommit::Type CommitType) {
-                if (SelectedNote.IsValid() && (CommitType != ETextCommit::OnCleared))
-                {
-                    TitleText = NewText.ToString();
-                    SelectedNote->Title = TitleText;
+            SNew(SVerticalBox)
 
-                    if (UDevNoteSubsystem* Subsystem = GEditor->GetEditorSubsystem<UDevNoteSubsystem>())
+            // Title
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 6))
+            [
+                SAssignNew(TitleBox, SEditableTextBox)
+                .Font(FCoreStyle::GetDefaultFontStyle("Bold", 16))
+                .OnTextChanged_Lambda([this](const FText& NewText) {
+                    TitleText = NewText.ToString();
+                    UDevNoteSubsystem::Get()->SetEditorEditingState(true);
+                })
+                .HintText(FText::FromString(TEXT("Note Title")))
+                .OnTextCommitted_Lambda([this](const FText& NewText, ETextCommit::Type CommitType) {
+                    if (SelectedNote.IsValid() && (CommitType != ETextCommit::OnCleared))
                     {
-                        Subsystem->UpdateNote(*SelectedNote);
+                        TitleText = NewText.ToString();
+                        SelectedNote->Title = TitleText;
+
+                        if (UDevNoteSubsystem* Subsystem = GEditor->GetEditorSubsystem<UDevNoteSubsystem>())
+                        {
+                            Subsystem->UpdateNote(*SelectedNote);
+                        }
+                        UDevNoteSubsystem::Get()->SetEditorEditingState(false);
                     }
-                    UDevNoteSubsystem::Get()->SetEditorEditingState(false);
-                }
-            })
-        ]
+                })
+            ]
 
-        // Level Picker
-        + SVerticalBox::Slot()
-        .AutoHeight()
-        .Padding(FMargin(0, 0, 0, 6))
-        [
-            SNew(SObjectPropertyEntryBox)
-                .AllowedClass(UWorld::StaticClass())
-                .ObjectPath(this, &SDevNoteEditor::GetLevelPath)
-                .OnObjectChanged(this, &SDevNoteEditor::OnLevelPathChanged)
-                .AllowClear(true)
-                .DisplayUseSelected(true)
-                .IsEnabled_Lambda([this]() -> bool {
-                     return SelectedNote.IsValid();
-                 })
-        ]
+            // Level Picker
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 6))
+            [
+                SAssignNew(LevelPicker, SObjectPropertyEntryBox)
+                    .AllowedClass(UWorld::StaticClass())
+                    .ObjectPath(this, &SDevNoteEditor::GetLevelPath)
+                    .OnObjectChanged(this, &SDevNoteEditor::OnLevelPathChanged)
+                    .AllowClear(true)
+                    .DisplayUseSelected(true)
+            ]
 
-        // Tag display area
-        + SVerticalBox::Slot()
-        .AutoHeight()
-        .Padding(FMargin(0, 0, 0, 12))
-        [
-            SNew(SBox)
-            .MinDesiredHeight(28)
-            .VAlign(VAlign_Top)
+            // Tag display area
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 12))
             [
-                SNew(SBorder)
-                .BorderImage(FAppStyle::GetBrush("ToolPanel.DarkGroupBorder"))
-                .Padding(FMargin(6, 4))
+                SNew(SBox)
+                .MinDesiredHeight(28)
+                .VAlign(VAlign_Top)
                 [
-                    // Widget refreshed when tags changed
-                    SAssignNew(TagDisplayWidget, SBox)
+                    SNew(SBorder)
+                    .BorderImage(FAppStyle::GetBrush("ToolPanel.DarkGroupBorder"))
+                    .Padding(FMargin(6, 4))
                     [
-                        CreateTagDisplay()
+                        // Widget refreshed when tags changed
+                        SAssignNew(TagDisplayWidget, SBox)
+                        [
+                            CreateTagDisplay()
+                        ]
                     ]
                 ]
             ]
-        ]
         
-        // Details
-        + SVerticalBox::Slot()
-        .AutoHeight()
-        .Padding(FMargin(0, 0, 0, 12))
-        [
-            SNew(STextBlock)
-            .AutoWrapText(true)
-            .Text_Lambda([this]() -> FText {
-                if (!SelectedNote.IsValid())
-                    return FText::GetEmpty();
-
-                const FVector& Loc = SelectedNote->WorldPosition;
-
-                FDateTime localTimeCreated = (FDateTime::Now().GetTicks() - FDateTime::UtcNow().GetTicks()) + SelectedNote->CreatedAt.GetTicks();
-                FDateTime localTimeLastEdited = (FDateTime::Now().GetTicks() - FDateTime::UtcNow().GetTicks()) + SelectedNote->LastEdited.GetTicks();
-
-                FString CreatedAtStr = localTimeCreated.ToString(TEXT("%Y-%m-%d %H:%M:%S"));
-                FString LastEditedStr = localTimeLastEdited.ToString(TEXT("%Y-%m-%d %H:%M:%S"));
-
-                FString CreatedByStr = UDevNoteSubsystem::Get()->GetUserById(SelectedNote->CreatedById).Name;
-                
-                FString Details = FString::Printf(
-                    TEXT("Location: (%.1f, %.1f, %.1f)\nCreated At: %s\nCreated By: %s\nLast Edited: %s"),
-                    Loc.X, Loc.Y, Loc.Z,
-                    *CreatedAtStr,
-                    *CreatedByStr,
-                    *LastEditedStr);
-
-                return FText::FromString(Details);
-            })
-        ]
-
-        // Body text
-        + SVerticalBox::Slot()
-        .FillHeight(1.f)
-        .MinHeight(100.f)
-        .VAlign(VAlign_Fill)
-        [
-                SNew(SMultiLineEditableTextBox)
+            // Details
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 12))
+            [
+                SAssignNew(DetailsBlock, STextBlock)
                 .AutoWrapText(true)
-                .Text_Lambda([this]() -> FText {
-                    return FText::FromString(BodyText);
-                })
-                .OnTextChanged_Lambda([this](const FText& NewText) {
-                    BodyText = NewText.ToString();
-                    UDevNoteSubsystem::Get()->SetEditorEditingState(true);
-                })
-                .IsEnabled_Lambda([this]() -> bool {
-                    return SelectedNote.IsValid();
-                })
-                .HintText(FText::FromString(TEXT("Note Body")))
-                .OnTextCommitted_Lambda([this](const FText& NewText, ETextCommit::Type CommitType) {
-                    if (SelectedNote.IsValid() && (CommitType != ETextCommit::OnCleared))
-                    {
-                        BodyText = NewText.ToString();
-                        SelectedNote->Body = BodyText;
+            ]
 
-                        auto ss = UDevNoteSubsystem::Get();
-                        ss->UpdateNote(*SelectedNote);
-                        ss->SetEditorEditingState(false);
-                    }
-                })
-        ]
+            // Body text
+            + SVerticalBox::Slot()
+            .FillHeight(1.f)
+            .MinHeight(100.f)
+            .VAlign(VAlign_Fill)
+            [
+                    SAssignNew(BodyBox, SMultiLineEditableTextBox)
+                    .AutoWrapText(true)
+                    .OnTextChanged_Lambda([this](const FText& NewText) {
+                        BodyText = NewText.ToString();
+                        UDevNoteSubsystem::Get()->SetEditorEditingState(true);
+                    })
+                    .OnTextCommitted_Lambda([this](const FText& NewText, ETextCommit::Type CommitType) {
+                        if (SelectedNote.IsValid() && (CommitType != ETextCommit::OnCleared))
+                        {
+                            BodyText = NewText.ToString();
+                            SelectedNote->Body = BodyText;
 
-        // Button Row
-        + SVerticalBox::Slot()
-        .AutoHeight()
-        .HAlign(HAlign_Fill)
-        .VAlign(VAlign_Bottom)
-        .Padding(FMargin(0, 12, 0, 0))
-        [
-            SNew(SHorizontalBox)
+                            auto ss = UDevNoteSubsystem::Get();
+                            ss->UpdateNote(*SelectedNote);
+                            ss->SetEditorEditingState(false);
+                        }
+                    })
+            ]
 
-            // Select Button
-            + SHorizontalBox::Slot()
-            .AutoWidth()
+            // Button Row
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .HAlign(HAlign_Fill)
+            .VAlign(VAlign_Bottom)
+            .Padding(FMargin(0, 12, 0, 0))
             [
-                SNew(SButton)
-                .Text(FText::FromString(TEXT("Select")))
-                .IsEnabled_Lambda([this]() { return SelectedNote.IsValid(); })
-                .OnClicked_Lambda([this]() -> FReply {
-                    if (!SelectedNote.IsValid())
-                        return FReply::Handled();
+                SAssignNew(ButtonRow, SHorizontalBox)
 
-                    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-                    if (!World)
-                        return FReply::Handled();
+                // Select Button
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                    .Text(FText::FromString(TEXT("Select")))
+                    .OnClicked_Lambda([this]() -> FReply {
+                        if (!SelectedNote.IsValid())
+                            return FReply::Handled();
 
-                    for (TActorIterator<ADevNoteActor> It(World); It; ++It)
-                    {
-                        if (It->Note == SelectedNote)
+                        UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+                        if (!World)
+                            return FReply::Handled();
+
+                        for (TActorIterator<ADevNoteActor> It(World); It; ++It)
                         {
-                            GEditor->SelectNone(false, true, false);
-                            GEditor->SelectActor(*It, true, true, true);
-                            break;
+                            if (It->Note == SelectedNote)
+                            {
+                                GEditor->SelectNone(false, true, false);
+                                GEditor->SelectActor(*It, true, true, true);
+                                break;
+                            }
                         }
-                    }
-                    return FReply::Handled();
-                })
-            ]
-            
-            // Teleport Button
-            + SHorizontalBox::Slot()
-            .AutoWidth()
-            .Padding(FMargin(6, 0))
-            [
-                SNew(SButton)
-                .Text(FText::FromString(TEXT("Teleport")))
-                .IsEnabled_Lambda([this]() { return SelectedNote.IsValid(); })
-                .OnClicked_Lambda([this]() -> FReply {
-                    if (!SelectedNote.IsValid())
                         return FReply::Handled();
+                    })
+                ]
+            
+                // Teleport Button
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(FMargin(6, 0))
+                [
+                    SNew(SButton)
+                    .Text(FText::FromString(TEXT("Teleport")))
+                    .OnClicked_Lambda([this]() -> FReply {
+                        if (!SelectedNote.IsValid())
+                            return FReply::Handled();
 
-                    FVector CamTarget = SelectedNote->WorldPosition;
+                        FVector CamTarget = SelectedNote->WorldPosition;
 
-                    auto ss = GEditor->GetEditorSubsystem<UDevNoteSubsystem>();
-                    if (ss)
-                    {
-                        ss->PromptAndTeleportToNote(*SelectedNote);
-                    }
+                        auto ss = GEditor->GetEditorSubsystem<UDevNoteSubsystem>();
+                        if (ss)
+                        {
+                            ss->PromptAndTeleportToNote(*SelectedNote);
+                        }
 
-                    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-                    if (!World) return FReply::Handled();
+                        UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+                        if (!World) return FReply::Handled();
 
-                    for (TActorIterator<ADevNoteActor> It(World); It; ++It)
-                    {
-                        if (It->Note == SelectedNote)
+                        for (TActorIterator<ADevNoteActor> It(World); It; ++It)
                         {
-                            GEditor->SelectNone(false, true, false);
-                            GEditor->SelectActor(*It, true, true, true);
-                            break;
+                            if (It->Note == SelectedNote)
+                            {
+                                GEditor->SelectNone(false, true, false);
+                                GEditor->SelectActor(*It, true, true, true);
+                                break;
+                            }
                         }
-                    }
                     
-                    return FReply::Handled();
-                })
-            ]
-            // Spacer takes the rest of the horizontal space
-            + SHorizontalBox::Slot()
-            .FillWidth(1.f)
-            [
-                SNew(SSpacer)
-            ]
-            // Delete button on right hand side
-            + SHorizontalBox::Slot()
-            .AutoWidth()
-            [
-                SNew(SButton)
-                .Text(FText::FromString(TEXT("Delete")))
-                .IsEnabled_Lambda([this]() { return SelectedNote.IsValid(); })
-                .OnClicked_Lambda([this]() -> FReply {
-                    if (!SelectedNote.IsValid())
                         return FReply::Handled();
+                    })
+                ]
+                // Spacer takes the rest of the horizontal space
+                + SHorizontalBox::Slot()
+                .FillWidth(1.f)
+                [
+                    SNew(SSpacer)
+                ]
+                // Delete button on right hand side
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                    .Text(FText::FromString(TEXT("Delete")))
+                    .OnClicked_Lambda([this]() -> FReply {
+                        if (!SelectedNote.IsValid())
+                            return FReply::Handled();
 
-                    const FText ConfirmText = FText::FromString(TEXT("Are you sure you want to delete this note? This action cannot be undone."));
-                    EAppReturnType::Type Result = FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText);
+                        const FText ConfirmText = FText::FromString(TEXT("Are you sure you want to delete this note? This action cannot be undone."));
+                        EAppReturnType::Type Result = FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText);
 
-                    if (Result == EAppReturnType::Yes)
-                    {
-                        if (GEditor)
+                        if (Result == EAppReturnType::Yes)
                         {
-                            if (UDevNoteSubsystem* Subsystem = GEditor->GetEditorSubsystem<UDevNoteSubsystem>())
+                            if (GEditor)
                             {
-                                Subsystem->DeleteNote(SelectedNote->Id);
-
-                                UWorld* World = GEditor->GetEditorWorldContext().World();
-                                if (World)
+                                if (UDevNoteSubsystem* Subsystem = GEditor->GetEditorSubsystem<UDevNoteSubsystem>())
                                 {
-                                    for (TActorIterator<ADevNoteActor> It(World); It; ++It)
+                                    Subsystem->DeleteNote(SelectedNote->Id);
+
+                                    UWorld* World = GEditor->GetEditorWorldContext().World();
+                                    if (World)
                                     {
-                                        if (It->Note == SelectedNote)
+                                        for (TActorIterator<ADevNoteActor> It(World); It; ++It)
                                         {
-                                            It->Destroy();
-                                            break;
+                                            if (It->Note == SelectedNote)
+                                            {
+                                                It->Destroy();
+                                                break;
+                                            }
                                         }
                                     }
                                 }
                             }
+                            SetSelectedNote(nullptr);
                         }
-                        SetSelectedNote(nullptr);
-                    }
-                    return FReply::Handled();
-                })
+                        return FReply::Handled();
+                    })
+                ]
             ]
         ]
     ];
+
+    RefreshFromNote();
 }
 
 void SDevNoteEditor::SetSelectedNote(TSharedPtr<FDevNote> InNote)
@@ -334,6 +299,8 @@ void SDevNoteEditor::SetSelectedNote(TSharedPtr<FDevNote> InNote)
     SelectedNote = InNote;
     TitleText = SelectedNote.IsValid() ? SelectedNote->Title : FString();
     BodyText = SelectedNote.IsValid() ? SelectedNote->Body : FString();
+    RefreshFromNote();
+    RequestBodyIfNeeded();
 
     // Update tag picker with new note's tags
     if (TagPicker.IsValid())
@@ -353,6 +320,108 @@ void SDevNoteEditor::SetSelectedNote(TSharedPtr<FDevNote> InNote)
     }
 }
 
+void SDevNoteEditor::RefreshFromNote()
+{
+    const bool bHasNote = SelectedNote.IsValid();
+    LevelPathText = bHasNote ? SelectedNote->LevelPath.ToString() : FString();
+
+    if (TitleBox.IsValid())
+    {
+        TitleBox->SetText(FText::FromString(TitleText));
+        TitleBox->SetEnabled(bHasNote);
+    }
+    if (BodyBox.IsValid())
+    {
+        const bool bBodyLoaded = bHasNote && SelectedNote->bBodyLoaded;
+        BodyBox->SetText(FText::FromString(BodyText));
+        BodyBox->SetEnabled(bBodyLoaded);
+        BodyBox->SetHintText(bHasNote && !bBodyLoaded
+            ? FText::FromString(TEXT("Loading..."))
+            : FText::FromString(TEXT("Note Body")));
+    }
+    if (LevelPicker.IsValid())
+    {
+        LevelPicker->SetEnabled(bHasNote);
+    }
+    if (TagPicker.IsValid())
+    {
+        TagPicker->SetEnabled(bHasNote);
+    }
+    if (ButtonRow.IsValid())
+    {
+        ButtonRow->SetEnabled(bHasNote);
+    }
+
+    RefreshDetailsText();
+}
+
+void SDevNoteEditor::RefreshDetailsText()
+{
+    if (!DetailsBlock.IsValid())
+    {
+        return;
+    }
+
+    if (!SelectedNote.IsValid())
+    {
+        DetailsBlock->SetText(FText::GetEmpty());
+        return;
+    }
+
+    const FVector& Loc = SelectedNote->WorldPosition;
+
+    FDateTime localTimeCreated = (FDateTime::Now().GetTicks() - FDateTime::UtcNow().GetTicks()) + SelectedNote->CreatedAt.GetTicks();
+    FDateTime localTimeLastEdited = (FDateTime::Now().GetTicks() - FDateTime::UtcNow().GetTicks()) + SelectedNote->LastEdited.GetTicks();
+
+    FString CreatedAtStr = localTimeCreated.ToString(TEXT("%Y-%m-%d %H:%M:%S"));
+    FString LastEditedStr = localTimeLastEdited.ToString(TEXT("%Y-%m-%d %H:%M:%S"));
+
+    FString CreatedByStr = UDevNoteSubsystem::Get()->GetUserById(SelectedNote->CreatedById).Name;
+
+    FString Details = FString::Printf(
+        TEXT("Location: (%.1f, %.1f, %.1f)\nCreated At: %s\nCreated By: %s\nLast Edited: %s"),
+        Loc.X, Loc.Y, Loc.Z,
+        *CreatedAtStr,
+        *CreatedByStr,
+        *LastEditedStr);
+
+    DetailsBlock->SetText(FText::FromString(Details));
+}
+
+void SDevNoteEditor::RequestBodyIfNeeded()
+{
+    if (SelectedNote.IsValid() && !SelectedNote->bBodyLoaded)
+    {
+        if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+        {
+            Subsystem->RequestNoteBody(SelectedNote->Id);
+        }
+    }
+}
+
+void SDevNoteEditor::OnNoteBodyLoaded(const FGuid& NoteId, const FString& Body)
+{
+    if (SelectedNote.IsValid() && SelectedNote->Id == NoteId)
+    {
+        // Our note may be a copy from an older sync, so take the body from the event
+        SelectedNote->Body = Body;
+        SelectedNote->bBodyLoaded = true;
+        BodyText = Body;
+        RefreshFromNote();
+    }
+}
+
+void SDevNoteEditor::OnNoteUpdateFailed(const FGuid& NoteId)
+{
+    // Edits are saved as they are made, so this is the only place the user learns one was lost
+    FNotificationInfo Info(FText::FromString(TEXT("Failed to save a note edit, see the log for details")));
+    Info.ExpireDuration = 5.0f;
+    if (SelectedNote.IsValid() && SelectedNote->Id == NoteId)
+    {
+        Info.SubText = FText::FromString(SelectedNote->Title);
+    }
+    FSlateNotificationManager::Get().AddNotification(Info);
+}
 
 void SDevNoteEditor::OnTagSelectionChanged(const TArray<FGuid>& NewTagIds)
 {
@@ -377,19 +446,10 @@ void SDevNoteEditor::OnTagSelectionChanged(const TArray<FGuid>& NewTagIds)
 
 void SDevNoteEditor::OnNewTagCreated(const FDevNoteTag& NewTag)
 {
+    // The subsystem syncs tags once the server created it, which reaches the picker through OnTagsChanged
     if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
     {
         Subsystem->PostTag(NewTag);
-        
-        // Refresh our local tags list after a short delay to allow server sync
-        FTimerHandle RefreshTimerHandle;
-        GEditor->GetTimerManager()->SetTimer(RefreshTimerHandle, [this]() {
-            RefreshTagsList();
-            if (TagPicker.IsValid())
-            {
-                TagPicker->RefreshTagsList();
-            }
-        }, 0.5f, false);
     }
 }
 
@@ -444,16 +504,30 @@ void SDevNoteEditor::OnTagRemoved(FGuid TagId) const
 }
 
 
-void SDevNoteEditor::RefreshTagsList()
+void SDevNoteEditor::OnNotesChanged(const FDevNoteChangeSet& Changes)
 {
-    TagsList.Empty();
-    if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+    // Our note was updated in place, reload what the widgets show from it
+    if (SelectedNote.IsValid() && Changes.WasChanged(SelectedNote->Id))
     {
-        const TArray<FDevNoteTag>& CachedTags = Subsystem->GetCachedTags();
-        for (const FDevNoteTag& NoteTag : CachedTags)
-        {
-            TagsList.Add(MakeShared<FDevNoteTag>(NoteTag));
-        }
+        SetSelectedNote(SelectedNote);
+    }
+}
+
+void SDevNoteEditor::OnTagsChanged(const FDevNoteChangeSet& Changes)
+{
+    if (TagPicker.IsValid())
+    {
+        TagPicker->ApplyTagChanges(Changes);
+    }
+
+    // The chips only need rebuilding if the selected note shows one of the tags
+    const bool bShowsChangedTag = SelectedNote.IsValid() && SelectedNote->Tags.ContainsByPredicate([&Changes](const FGuid& TagId)
+    {
+        return Changes.WasChanged(TagId) || Changes.WasRemoved(TagId) || Changes.Added.Contains(TagId);
+    });
+    if (bShowsChangedTag && TagDisplayWidget.IsValid())
+    {
+        TagDisplayWidget->SetContent(CreateTagDisplay());
     }
 }
 
@@ -464,19 +538,17 @@ TSharedRef<SWidget> SDevNoteEditor::CreateTagDisplay() const
         .UseAllottedSize(true)
         .InnerSlotPadding(FVector2D(2, 2));
 
-    if (SelectedNote.IsValid() && !SelectedNote->Tags.IsEmpty())
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (Subsystem && SelectedNote.IsValid() && !SelectedNote->Tags.IsEmpty())
     {
         for (const FGuid& TagId : SelectedNote->Tags)
         {
-            const TSharedPtr<FDevNoteTag>* FoundTag = TagsList.FindByPredicate([&TagId](const TSharedPtr<FDevNoteTag>& NoteTag) {
-                return NoteTag.IsValid() && NoteTag->Id == TagId;
-            });
-
-            if (FoundTag && FoundTag->IsValid())
+            const TSharedPtr<FDevNoteTag> FoundTag = Subsystem->FindSharedTag(TagId);
+            if (FoundTag.IsValid())
             {
                 // Convert stored int32 color to display color
                 FColor TagColor;
-                TagColor.DWColor() = (*FoundTag)->Colour;
+                TagColor.DWColor() = FoundTag->Colour;
                 FLinearColor DisplayColor = FLinearColor::FromSRGBColor(TagColor);
 
                 TagWrapBox->AddSlot()
@@ -484,7 +556,7 @@ TSharedRef<SWidget> SDevNoteEditor::CreateTagDisplay() const
                     SNew(SBorder)
                     .BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
                     .Padding(FMargin(4, 2))
-                    .ToolTipText(FText::FromString((*FoundTag)->Name))
+                    .ToolTipText(FText::FromString(FoundTag->Name))
                     [
                         SNew(SHorizontalBox)
                         
@@ -508,7 +580,7 @@ TSharedRef<SWidget> SDevNoteEditor::CreateTagDisplay() const
                         .Padding(FMargin(0, 0, 2, 0))
                         [
                             SNew(STextBlock)
-                            .Text(FText::FromString((*FoundTag)->Name))
+                            .Text(FText::FromString(FoundTag->Name))
                             .Font(FCoreStyle::GetDefaultFontStyle("Regular", 8))
                         ]
                         
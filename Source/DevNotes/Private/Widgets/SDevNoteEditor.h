@@ -5,7 +5,9 @@
 #include "SDevNoteTagPicker.h"
 
 struct FDevNoteTag;
+struct FDevNoteChangeSet;
 class UDevNoteSubsystem;
+class SMultiLineEditableTextBox;
 
 class SDevNoteEditor : public SCompoundWidget
 {
@@ -24,11 +26,29 @@ private:
 	TSharedPtr<FDevNote> SelectedNote;
 	FString TitleText;
 	FString BodyText;
+	FString LevelPathText;
+
+	TSharedPtr<SEditableTextBox> TitleBox;
+	TSharedPtr<SMultiLineEditableTextBox> BodyBox;
+	TSharedPtr<STextBlock> DetailsBlock;
+	TSharedPtr<SWidget> LevelPicker;
+	TSharedPtr<SHorizontalBox> ButtonRow;
+
+	// Push text and enabled states for the selected note into the widgets. Called on note change only, never per frame
+	void RefreshFromNote();
+	void RefreshDetailsText();
 	
-	TArray<TSharedPtr<FDevNoteTag>> TagsList;
+	// Tags themselves are the subsystem's shared objects, nothing here copies them
 	TSharedPtr<SDevNoteTagPicker> TagPicker;
-    
-	void RefreshTagsList();
+
+	// Sync events. Notes and tags are updated in place, so only what the selected note shows is refreshed
+	void OnNotesChanged(const FDevNoteChangeSet& Changes);
+	void OnTagsChanged(const FDevNoteChangeSet& Changes);
+
+	// Summary synced notes arrive without a body, fetch it when the note is opened
+	void RequestBodyIfNeeded();
+	void OnNoteBodyLoaded(const FGuid& NoteId, const FString& Body);
+	void OnNoteUpdateFailed(const FGuid& NoteId);
 	void OnTagSelectionChanged(const TArray<FGuid>& NewTagIds);
 	void OnNewTagCreated(const FDevNoteTag& NewTag);
 
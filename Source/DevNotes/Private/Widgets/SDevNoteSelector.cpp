@@ -1,194 +1,1313 @@
 ﻿#include "SDevNoteSelector.h"
 
 #include "DevNoteSubsystem.h"
+#include "Async/Async.h"
+#include "DevNotesDeveloperSettings.h"
+#include "DevNotesStats.h"
+#include "DevNoteSearchIndex.h"
+#include "DevNoteServerQuery.h"
+#include "DevNoteTagVisualCache.h"
 #include "FDevNoteTag.h"
+#include "SDevNoteTagDots.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "StructUtils/PropertyBag.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SMenuAnchor.h"
+#include "Widgets/Input/SSegmentedControl.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SSpacer.h"
+#include "Widgets/Layout/SWidgetSwitcher.h"
+#include "Widgets/Views/SExpanderArrow.h"
+#include "Widgets/Views/SHeaderRow.h"
 #include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STreeView.h"
 #include "Widgets/Text/STextBlock.h"
 
-static void ParseSearchStringWithQuotes(const FString& InStr, TArray<FString>& OutTokens)
+namespace DevNoteSelector
 {
-    int32 Len = InStr.Len();
+    // Wait for a short pause in typing before filtering
+    static constexpr float FilterDebounceSeconds = 0.15f;
+
+    // Below this many notes a filter pass is cheaper than handing it to a worker
+    static constexpr int32 AsyncFilterThreshold = 5000;
+
+    // How long to filter locally after a server query failed before trying the server again
+    static constexpr double ServerFilterRetrySeconds = 30.0;
+
+    // Completions shown below the search box
+    static constexpr int32 MaxSuggestions = 8;
+
+    static const FName ColumnTitle(TEXT("Title"));
+    static const FName ColumnAuthor(TEXT("Author"));
+    static const FName ColumnLevel(TEXT("Level"));
+    static const FName ColumnCreated(TEXT("Created"));
+    static const FName ColumnLastEdited(TEXT("LastEdited"));
+    static const FName ColumnTags(TEXT("Tags"));
+    static const FName ColumnDistance(TEXT("Distance"));
+
+    static FText FormatLocalTime(const FDateTime& UtcTime)
+    {
+        const FDateTime LocalTime = (FDateTime::Now().GetTicks() - FDateTime::UtcNow().GetTicks()) + UtcTime.GetTicks();
+        return FText::FromString(LocalTime.ToString(TEXT("%Y-%m-%d %H:%M")));
+    }
+
+    // The filter key a suggestion completes to when it replaces an unqualified term
+    static const TCHAR* GetSuggestionKey(EDevNoteSuggestionField Field)
+    {
+        switch (Field)
+        {
+        case EDevNoteSuggestionField::Tag: return TEXT("Tag");
+        case EDevNoteSuggestionField::User: return TEXT("User");
+        default: return TEXT("Map");
+        }
+    }
+}
+
+/**
+ * Column values of one note, copied from its search entry when the row is generated.
+ * Shared by the rows of the flat list and the note rows of the grouped tree; tag dots read the shared tag visual cache
+ */
+struct FDevNoteRowColumns
+{
+    TSharedPtr<FDevNote> Note;
+    TSharedPtr<FDevNoteTagVisualCache> TagVisuals;
+    FString AuthorName;
+    FString LevelName;
+    double Distance = 0.0;
+
+    void Init(const TSharedPtr<FDevNote>& InNote, const FDevNoteSearchEntries* Entries, int32 EntryIndex, const FVector& CameraLocation, const TSharedPtr<FDevNoteTagVisualCache>& InTagVisuals)
+    {
+        Note = InNote;
+        TagVisuals = InTagVisuals;
+        if (Entries && Entries->IsValidIndex(EntryIndex))
+        {
+            AuthorName = Entries->GetAuthorName(EntryIndex);
+            LevelName = Entries->GetLevelName(EntryIndex);
+        }
+        Distance = Note.IsValid() ? FVector::Dist(Note->WorldPosition, CameraLocation) : 0.0;
+    }
+
+    TSharedRef<SWidget> MakeWidget(const FName& ColumnName) const
+    {
+        using namespace DevNoteSelector;
+
+        if (!Note.IsValid())
+        {
+            return SNullWidget::NullWidget;
+        }
+
+        FText Text;
+        if (ColumnName == ColumnTitle)
+        {
+            Text = FText::FromString(Note->Title);
+        }
+        else if (ColumnName == ColumnAuthor)
+        {
+            Text = FText::FromString(AuthorName);
+        }
+        else if (ColumnName == ColumnLevel)
+        {
+            Text = FText::FromString(LevelName);
+        }
+        else if (ColumnName == ColumnCreated)
+        {
+            Text = FormatLocalTime(Note->CreatedAt);
+        }
+        else if (ColumnName == ColumnLastEdited)
+        {
+            Text = FormatLocalTime(Note->LastEdited);
+        }
+        else if (ColumnName == ColumnDistance)
+        {
+            // World units are centimetres
+            FNumberFormattingOptions Options;
+            Options.MaximumFractionalDigits = 0;
+            Text = FText::Format(INVTEXT("{0} m"), FText::AsNumber(Distance / 100.0, &Options));
+        }
+        else if (ColumnName == ColumnTags)
+        {
+            return SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                [
+                    SNew(STextBlock)
+                    .Text(FText::AsNumber(Note->Tags.Num()))
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                .Padding(4.0f, 0.0f, 0.0f, 0.0f)
+                [
+                    SNew(SDevNoteTagDots)
+                    .TagVisuals(TagVisuals)
+                    .Tags(Note->Tags)
+                ];
+        }
+
+        return SNew(STextBlock)
+            .Text(Text)
+            .ToolTipText(Text);
+    }
+};
+
+/**
+ * One row of the flat note list
+ */
+class SDevNoteListRow : public SMultiColumnTableRow<TSharedPtr<FDevNote>>
+{
+public:
+    SLATE_BEGIN_ARGS(SDevNoteListRow)
+        : _Entries(nullptr)
+        , _EntryIndex(INDEX_NONE)
+        , _CameraLocation(FVector::ZeroVector)
+    {}
+    SLATE_ARGUMENT(TSharedPtr<FDevNote>, Note)
+    SLATE_ARGUMENT(const FDevNoteSearchEntries*, Entries)
+    SLATE_ARGUMENT(int32, EntryIndex)
+    SLATE_ARGUMENT(FVector, CameraLocation)
+    SLATE_ARGUMENT(TSharedPtr<FDevNoteTagVisualCache>, TagVisuals)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+    {
+        Columns.Init(InArgs._Note, InArgs._Entries, InArgs._EntryIndex, InArgs._CameraLocation, InArgs._TagVisuals);
+        SMultiColumnTableRow<TSharedPtr<FDevNote>>::Construct(FSuperRowType::FArguments(), OwnerTable);
+    }
+
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        return Columns.MakeWidget(ColumnName);
+    }
+
+private:
+    FDevNoteRowColumns Columns;
+};
+
+/**
+ * One row of the grouped note tree: a group header with its note count, or a note inside an expanded group
+ */
+class SDevNoteTreeRow : public SMultiColumnTableRow<TSharedPtr<FDevNoteTreeItem>>
+{
+public:
+    SLATE_BEGIN_ARGS(SDevNoteTreeRow)
+        : _Entries(nullptr)
+        , _EntryIndex(INDEX_NONE)
+        , _CameraLocation(FVector::ZeroVector)
+    {}
+    SLATE_ARGUMENT(TSharedPtr<FDevNoteTreeItem>, Item)
+    SLATE_ARGUMENT(const FDevNoteSearchEntries*, Entries)
+    SLATE_ARGUMENT(int32, EntryIndex)
+    SLATE_ARGUMENT(FVector, CameraLocation)
+    SLATE_ARGUMENT(TSharedPtr<FDevNoteTagVisualCache>, TagVisuals)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+    {
+        Item = InArgs._Item;
+        if (Item.IsValid() && !Item->IsGroup())
+        {
+            Columns.Init(Item->Note, InArgs._Entries, InArgs._EntryIndex, InArgs._CameraLocation, InArgs._TagVisuals);
+        }
+        SMultiColumnTableRow<TSharedPtr<FDevNoteTreeItem>>::Construct(FSuperRowType::FArguments(), OwnerTable);
+    }
+
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        if (!Item.IsValid())
+        {
+            return SNullWidget::NullWidget;
+        }
+
+        if (ColumnName != DevNoteSelector::ColumnTitle)
+        {
+            return Item->IsGroup() ? SNullWidget::NullWidget : Columns.MakeWidget(ColumnName);
+        }
+
+        TSharedRef<SWidget> Content = Item->IsGroup()
+            ? StaticCastSharedRef<SWidget>(SNew(STextBlock)
+                .Text(Item->GroupLabel)
+                .Font(FCoreStyle::GetDefaultFontStyle("Bold", 9)))
+            : Columns.MakeWidget(ColumnName);
+
+        return SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SExpanderArrow, SharedThis(this))
+            ]
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            .VAlign(VAlign_Center)
+            [
+                Content
+            ];
+    }
+
+private:
+    TSharedPtr<FDevNoteTreeItem> Item;
+    FDevNoteRowColumns Columns;
+};
+
+void SDevNoteSelector::OnSearchTextChanged(const FText& Text)
+{
+    SearchText = Text;
+    UpdateSuggestions(Text.ToString());
+
+    if (FilterDebounceHandle.IsValid())
+    {
+        UnRegisterActiveTimer(FilterDebounceHandle.ToSharedRef());
+    }
+    FilterDebounceHandle = RegisterActiveTimer(DevNoteSelector::FilterDebounceSeconds,
+        FWidgetActiveTimerDelegate::CreateSP(this, &SDevNoteSelector::OnFilterDebounceElapsed));
+}
+
+void SDevNoteSelector::UpdateSuggestions(const FString& Text)
+{
+    // Only the token at the end of the text is completed. Quoted values may contain spaces
+    int32 TokenStart = 0;
     bool bInQuotes = false;
-    FString Current;
-    for (int32 i = 0; i < Len; ++i)
+    for (int32 i = 0; i < Text.Len(); ++i)
+    {
+        if (Text[i] == TEXT('"'))
+        {
+            bInQuotes = !bInQuotes;
+        }
+        else if (!bInQuotes && FChar::IsWhitespace(Text[i]))
+        {
+            TokenStart = i + 1;
+        }
+    }
+    const FString Token = Text.Mid(TokenStart);
+
+    // Suggestions come from the tries directly, so they keep up with typing instead of waiting for the filter debounce
+    TArray<EDevNoteSuggestionField, TInlineAllocator<3>> Fields;
+    FString Key, Value;
+    if (Token.Split(TEXT("="), &Key, &Value))
+    {
+        const FString KeyLower = Key.ToLower();
+        if (KeyLower == TEXT("tag") || KeyLower == TEXT("+tag") || KeyLower == TEXT("-tag"))
+        {
+            Fields.Add(EDevNoteSuggestionField::Tag);
+        }
+        else if (KeyLower == TEXT("user"))
+        {
+            Fields.Add(EDevNoteSuggestionField::User);
+        }
+        else if (KeyLower == TEXT("map"))
+        {
+            Fields.Add(EDevNoteSuggestionField::Level);
+        }
+    }
+    else if (!Token.IsEmpty())
+    {
+        Key.Reset();
+        Value = Token;
+        Fields = { EDevNoteSuggestionField::Tag, EDevNoteSuggestionField::User, EDevNoteSuggestionField::Level };
+    }
+
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem || Fields.IsEmpty())
+    {
+        CloseSuggestions();
+        return;
+    }
+
+    Value.RemoveFromStart(TEXT("\""));
+    Value.RemoveFromEnd(TEXT("\""));
+    const FString ValueLower = Value.ToLower();
+
+    TArray<FDevNoteSuggestion> Found;
+    for (const EDevNoteSuggestionField Field : Fields)
+    {
+        Subsystem->GetSearchIndex().Suggest(Field, ValueLower, DevNoteSelector::MaxSuggestions, Found);
+    }
+    if (Fields.Num() > 1)
+    {
+        Algo::Sort(Found, [](const FDevNoteSuggestion& A, const FDevNoteSuggestion& B)
+        {
+            return A.NoteCount != B.NoteCount ? A.NoteCount > B.NoteCount : A.Value < B.Value;
+        });
+        Found.SetNum(FMath::Min(Found.Num(), DevNoteSelector::MaxSuggestions));
+    }
+
+    // Nothing left to complete once the value is typed out in full
+    if (Found.IsEmpty() || (Found.Num() == 1 && Found[0].Value.Equals(Value, ESearchCase::IgnoreCase)))
+    {
+        CloseSuggestions();
+        return;
+    }
+
+    SuggestionTokenStart = TokenStart;
+    SuggestionTokenKey = Key;
+    Suggestions.Reset(Found.Num());
+    for (FDevNoteSuggestion& Suggestion : Found)
+    {
+        Suggestions.Add(MakeShared<FDevNoteSuggestion>(MoveTemp(Suggestion)));
+    }
+    SuggestionListView->RequestListRefresh();
+    SuggestionListView->SetSelection(Suggestions[0]);
+
+    // Keep keyboard focus in the search box so typing carries on while the list is open
+    SuggestionMenu->SetIsOpen(true, false);
+}
+
+void SDevNoteSelector::AcceptSuggestion(TSharedPtr<FDevNoteSuggestion> Suggestion)
+{
+    if (!Suggestion.IsValid() || SuggestionTokenStart == INDEX_NONE)
+    {
+        return;
+    }
+
+    const FString Key = SuggestionTokenKey.IsEmpty() ? DevNoteSelector::GetSuggestionKey(Suggestion->Field) : SuggestionTokenKey;
+    const FString Value = Suggestion->Value.Contains(TEXT(" ")) ? FString::Printf(TEXT("\"%s\""), *Suggestion->Value) : Suggestion->Value;
+
+    // The trailing space ends the token, which closes the list again
+    const FString NewText = SearchText.ToString().Left(SuggestionTokenStart) + Key + TEXT("=") + Value + TEXT(" ");
+    CloseSuggestions();
+
+    SearchBox->SetText(FText::FromString(NewText));
+    if (!SearchText.ToString().Equals(NewText, ESearchCase::CaseSensitive))
+    {
+        OnSearchTextChanged(FText::FromString(NewText));
+    }
+    SearchBox->GoTo(ETextLocation::EndOfDocument);
+    FSlateApplication::Get().SetKeyboardFocus(SearchBox, EFocusCause::SetDirectly);
+}
+
+void SDevNoteSelector::CloseSuggestions()
+{
+    SuggestionTokenStart = INDEX_NONE;
+    Suggestions.Reset();
+    if (SuggestionListView.IsValid())
+    {
+        SuggestionListView->RequestListRefresh();
+    }
+    if (SuggestionMenu.IsValid() && SuggestionMenu->IsOpen())
+    {
+        SuggestionMenu->SetIsOpen(false);
+    }
+}
+
+TSharedRef<SWidget> SDevNoteSelector::MakeSuggestionMenu()
+{
+    return SNew(SBorder)
+        .BorderImage(FAppStyle::GetBrush("Menu.Background"))
+        .Padding(2.0f)
+        [
+            SNew(SBox)
+            .MaxDesiredHeight(240.0f)
+            [
+                SAssignNew(SuggestionListView, SListView<TSharedPtr<FDevNoteSuggestion>>)
+                .ListItemsSource(&Suggestions)
+                .SelectionMode(ESelectionMode::Single)
+                .OnGenerateRow(this, &SDevNoteSelector::OnGenerateSuggestionRow)
+                .OnMouseButtonClick(this, &SDevNoteSelector::AcceptSuggestion)
+            ]
+        ];
+}
+
+TSharedRef<ITableRow> SDevNoteSelector::OnGenerateSuggestionRow(TSharedPtr<FDevNoteSuggestion> InSuggestion, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(STableRow<TSharedPtr<FDevNoteSuggestion>>, OwnerTable)
+        .Padding(FMargin(4.0f, 2.0f))
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            [
+                SNew(STextBlock)
+                .Text(FText::FromString(InSuggestion->Value))
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(8.0f, 0.0f)
+            [
+                SNew(STextBlock)
+                .Text(FText::FromString(DevNoteSelector::GetSuggestionKey(InSuggestion->Field)))
+                .ColorAndOpacity(FSlateColor::UseSubduedForeground())
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(STextBlock)
+                .Text(FText::AsNumber(InSuggestion->NoteCount))
+                .ToolTipText(FText::FromString(TEXT("Notes matching this value")))
+            ]
+        ];
+}
+
+FReply SDevNoteSelector::OnSearchKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent)
+{
+    if (!SuggestionMenu.IsValid() || !SuggestionMenu->IsOpen() || Suggestions.IsEmpty())
+    {
+        return FReply::Unhandled();
+    }
+
+    const FKey Key = InKeyEvent.GetKey();
+    const TArray<TSharedPtr<FDevNoteSuggestion>> Selected = SuggestionListView->GetSelectedItems();
+    if (Key == EKeys::Up || Key == EKeys::Down)
+    {
+        const int32 Current = Selected.Num() > 0 ? Suggestions.IndexOfByKey(Selected[0]) : INDEX_NONE;
+        const int32 Next = FMath::Clamp(Current + (Key == EKeys::Up ? -1 : 1), 0, Suggestions.Num() - 1);
+        SuggestionListView->SetSelection(Suggestions[Next]);
+        SuggestionListView->RequestScrollIntoView(Suggestions[Next]);
+        return FReply::Handled();
+    }
+    if (Key == EKeys::Tab || Key == EKeys::Enter)
+    {
+        AcceptSuggestion(Selected.Num() > 0 ? Selected[0] : Suggestions[0]);
+        return FReply::Handled();
+    }
+    if (Key == EKeys::Escape)
+    {
+        CloseSuggestions();
+        return FReply::Handled();
+    }
+    return FReply::Unhandled();
+}
+
+EActiveTimerReturnType SDevNoteSelector::OnFilterDebounceElapsed(double InCurrentTime, float InDeltaTime)
+{
+    FilterDebounceHandle.Reset();
+    ParseAndApplyFilters();
+    return EActiveTimerReturnType::Stop;
+}
+
+void SDevNoteSelector::OnSearchIndexChanged()
+{
+    // Tag and user terms are resolved when the query compiles, and rows show resolved author names,
+    // so a new tag/user list needs a re-filter
+    ParseAndApplyFilters();
+}
+
+void SDevNoteSelector::OnTagsChanged(const FDevNoteChangeSet& Changes)
+{
+    // Unfiltered, a tag edit can't change which notes are listed: tag dots read the visual cache when painted,
+    // and only the tag groups, rebuilt by a new pass, are labelled with tag names
+    if (AppliedQuery.IsValid() && AppliedQuery->IsEmpty() && !InFlightFilterCancel.IsValid() && Grouping != EDevNoteGrouping::Tag)
+    {
+        return;
+    }
+    ParseAndApplyFilters();
+}
+
+void SDevNoteSelector::ApplyNoteChanges(const FDevNoteChangeSet& Changes)
+{
+    DEVNOTES_SCOPE(Filter);
+    LLM_SCOPE_BYTAG(DevNotes);
+
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+
+    // Nothing shown to patch yet, or a pass is still running on older entries: a full pass picks the changes up
+    if (!Subsystem || !AppliedQuery.IsValid() || InFlightFilterCancel.IsValid() || FilterDebounceHandle.IsValid())
+    {
+        ParseAndApplyFilters();
+        return;
+    }
+
+    // Text terms resolve to matching notes when compiled, so the query is recompiled against the new index
+    const FDevNoteSearchIndex& Index = Subsystem->GetSearchIndex();
+    CompileQuery(Index);
+
+    // Relative ranges like edited<2d move with the clock, so untouched notes may have aged out. Test them all again,
+    // as saved views do in FDevNoteSavedViews::RefreshTimedViews
+    if (CompiledQuery->HasTimeClause())
+    {
+        ParseAndApplyFilters();
+        return;
+    }
+    FDevNoteSearchEntriesRef Entries = Index.GetEntriesSnapshot();
+
+    TSet<FGuid> Touched;
+    Touched.Reserve(Changes.Num());
+    Touched.Append(Changes.Added);
+    Touched.Append(Changes.Changed);
+    Touched.Append(Changes.Removed);
+
+    // Untouched notes still match. Their entry index only moves if a removed note's slot was refilled
+    TArray<int32> Matches;
+    Matches.Reserve(AppliedResult.Num() + Changes.Added.Num());
+    for (const TSharedPtr<FDevNote>& Note : FilteredNotes)
+    {
+        const FGuid& NoteId = Note->Id;
+        if (!Touched.Contains(NoteId))
+        {
+            const int32 NewIndex = Index.FindEntryIndex(NoteId);
+            if (NewIndex != INDEX_NONE)
+            {
+                Matches.Add(NewIndex);
+            }
+        }
+    }
+
+    TArray<int32> Candidates;
+    Candidates.Reserve(Changes.Added.Num() + Changes.Changed.Num());
+    for (const TArray<FGuid>* Ids : { &Changes.Added, &Changes.Changed })
+    {
+        for (const FGuid& NoteId : *Ids)
+        {
+            const int32 EntryIndex = Index.FindEntryIndex(NoteId);
+            if (EntryIndex != INDEX_NONE)
+            {
+                Candidates.Add(EntryIndex);
+            }
+        }
+    }
+
+    TArray<int32> CandidateMatches;
+    CompiledQuery->Evaluate(*Entries, &Candidates, CandidateMatches);
+    Matches.Append(CandidateMatches);
+    SortMatches(*CompiledQuery, *Entries, MakeSortSpec(), Matches);
+
+    AppliedQuery = CompiledQuery;
+    AppliedIndexVersion = CompiledIndexVersion;
+    AppliedResult = MoveTemp(Matches);
+
+    // Rows of unchanged notes are reused as they are, only edited notes need their columns rebuilt
+    ShowAppliedResult(*Entries, !Changes.Changed.IsEmpty());
+}
+
+void SDevNoteSelector::CompileQuery(const FDevNoteSearchIndex& Index)
+{
+    // Only recompile when the text changed or the index resolved names differently
+    const FString QueryString = SearchText.ToString();
+    if (!CompiledQuery.IsValid() || CompiledQuery->GetSourceString() != QueryString || CompiledIndexVersion != Index.GetVersion())
+    {
+        CompiledQuery = MakeShared<const FDevNoteQuery, ESPMode::ThreadSafe>(FDevNoteQuery::Compile(QueryString, Index));
+        CompiledIndexVersion = Index.GetVersion();
+    }
+}
+
+void SDevNoteSelector::ParseAndApplyFilters()
+{
+    DEVNOTES_SCOPE(Filter);
+    LLM_SCOPE_BYTAG(DevNotes);
+
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem)
+    {
+        return;
+    }
+    const FDevNoteSearchIndex& Index = Subsystem->GetSearchIndex();
+    CompileQuery(Index);
+
+    // Whatever is still running is for an older query
+    if (InFlightFilterCancel.IsValid())
+    {
+        InFlightFilterCancel->store(true);
+        InFlightFilterCancel.Reset();
+    }
+    const uint32 Generation = ++FilterGeneration;
+    bAppliedFromServer = false;
+
+    TSharedRef<const FDevNoteQuery, ESPMode::ThreadSafe> Query = CompiledQuery.ToSharedRef();
+    FDevNoteSearchEntriesRef Entries = Index.GetEntriesSnapshot();
+    const FSortSpec Spec = MakeSortSpec();
+
+    if (Query->IsEmpty())
+    {
+        TArray<int32> Matches;
+        Matches.Reserve(Entries->Num());
+        for (int32 EntryIndex = 0; EntryIndex < Entries->Num(); ++EntryIndex)
+        {
+            Matches.Add(EntryIndex);
+        }
+        SortMatches(*Query, *Entries, Spec, Matches);
+        ApplyFilterResults(Query, Entries, CompiledIndexVersion, Spec.Column, Spec.Mode, MoveTemp(Matches));
+        return;
+    }
+
+    // A saved view with this exact filter already holds its results, kept current through every sync
+    if (const FDevNoteSavedView* View = Subsystem->GetSavedViews().FindByQuery(Query->GetSourceString()))
+    {
+        if (Subsystem->GetSavedViews().IsCurrent(Index))
+        {
+            TArray<int32> Matches;
+            Matches.Reserve(View->NoteIds.Num());
+            for (const FGuid& NoteId : View->NoteIds)
+            {
+                const int32 EntryIndex = Index.FindEntryIndex(NoteId);
+                if (EntryIndex != INDEX_NONE)
+                {
+                    Matches.Add(EntryIndex);
+                }
+            }
+            ApplyMatchingEntries(MoveTemp(Matches));
+            return;
+        }
+    }
+
+    if (!Query->IsEmpty() && Subsystem->IsServerFilteringEnabled() && FPlatformTime::Seconds() >= ServerFilterRetryTime)
+    {
+        const FDevNoteServerQuery ServerQuery = FDevNoteServerQuery::Translate(Query->GetSourceString(), FDateTime::UtcNow());
+        if (!ServerQuery.IsEmpty())
+        {
+            Subsystem->QueryNotesOnServer(ServerQuery, [WeakThis = TWeakPtr<SDevNoteSelector>(SharedThis(this)), Generation](bool bSuccess, const TArray<FGuid>& NoteIds)
+            {
+                TSharedPtr<SDevNoteSelector> This = WeakThis.Pin();
+                if (!This.IsValid() || Generation != This->FilterGeneration)
+                {
+                    return;
+                }
+
+                if (bSuccess)
+                {
+                    This->ApplyServerResults(NoteIds);
+                }
+                else
+                {
+                    This->ServerFilterRetryTime = FPlatformTime::Seconds() + DevNoteSelector::ServerFilterRetrySeconds;
+                    This->ParseAndApplyFilters();
+                }
+            });
+            return;
+        }
+    }
+
+    // Every clause is at least as strict as before: only the notes that matched before can still match
+    TSharedPtr<TArray<int32>, ESPMode::ThreadSafe> Candidates;
+    if (AppliedQuery.IsValid() && AppliedIndexVersion == CompiledIndexVersion && Query->IsNarrowingOf(*AppliedQuery))
+    {
+        Candidates = MakeShared<TArray<int32>, ESPMode::ThreadSafe>(AppliedResult);
+    }
+
+    const int32 NumToTest = Candidates.IsValid() ? Candidates->Num() : Entries->Num();
+    if (NumToTest < DevNoteSelector::AsyncFilterThreshold)
+    {
+        TArray<int32> Matches;
+        Query->Evaluate(*Entries, Candidates.Get(), Matches);
+        SortMatches(*Query, *Entries, Spec, Matches);
+        ApplyFilterResults(Query, Entries, CompiledIndexVersion, Spec.Column, Spec.Mode, MoveTemp(Matches));
+        return;
+    }
+
+    TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> Cancel = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+    InFlightFilterCancel = Cancel;
+
+    Async(EAsyncExecution::ThreadPool, [WeakThis = TWeakPtr<SDevNoteSelector>(SharedThis(this)), Query, Entries, Candidates, Cancel, Generation, Spec, IndexVersion = CompiledIndexVersion]()
+    {
+        DEVNOTES_SCOPE(Filter);
+        LLM_SCOPE_BYTAG(DevNotes);
+        TArray<int32> Matches;
+        if (!Query->Evaluate(*Entries, Candidates.Get(), Matches, &Cancel.Get()))
+        {
+            return;
+        }
+        SortMatches(*Query, *Entries, Spec, Matches);
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Query, Entries, Cancel, Generation, Spec, IndexVersion, Matches = MoveTemp(Matches)]() mutable
+        {
+            TSharedPtr<SDevNoteSelector> This = WeakThis.Pin();
+            if (This.IsValid() && !Cancel->load() && Generation == This->FilterGeneration)
+            {
+                This->InFlightFilterCancel.Reset();
+                This->ApplyFilterResults(Query, Entries, IndexVersion, Spec.Column, Spec.Mode, MoveTemp(Matches));
+            }
+        });
+    });
+}
+
+void SDevNoteSelector::ApplyServerResults(const TArray<FGuid>& NoteIds)
+{
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    const FDevNoteSearchIndex& Index = Subsystem->GetSearchIndex();
+    TArray<int32> Matches;
+    Matches.Reserve(NoteIds.Num());
+    for (const FGuid& NoteId : NoteIds)
+    {
+        const int32 EntryIndex = Index.FindEntryIndex(NoteId);
+        if (EntryIndex != INDEX_NONE)
+        {
+            Matches.Add(EntryIndex);
+        }
+    }
+
+    // The server only matches terms as typed. Notes matching a correction of a misspelled term are found locally and added
+    CompileQuery(Index);
+    if (CompiledQuery->IsFuzzy())
+    {
+        TArray<int32> LocalMatches;
+        CompiledQuery->Evaluate(Index.GetEntries(), nullptr, LocalMatches);
+        Matches.Append(MoveTemp(LocalMatches));
+        Matches.Sort();
+        Matches.SetNum(Algo::Unique(Matches));
+    }
+    bAppliedFromServer = true;
+    ApplyMatchingEntries(MoveTemp(Matches));
+}
+
+void SDevNoteSelector::ApplyMatchingEntries(TArray<int32>&& Matches)
+{
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    const FDevNoteSearchIndex& Index = Subsystem->GetSearchIndex();
+    CompileQuery(Index);
+    FDevNoteSearchEntriesRef Entries = Index.GetEntriesSnapshot();
+
+    // Matches arrive in any order. Entry order is the sync order unsorted lists keep, sorting and ranking stay local
+    Matches.Sort();
+    const FSortSpec Spec = MakeSortSpec();
+    SortMatches(*CompiledQuery, *Entries, Spec, Matches);
+    ApplyFilterResults(CompiledQuery.ToSharedRef(), Entries, CompiledIndexVersion, Spec.Column, Spec.Mode, MoveTemp(Matches));
+}
+
+void SDevNoteSelector::ApplySavedView(const FString& Name)
+{
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    const FDevNoteSavedView* View = Subsystem ? Subsystem->GetSavedViews().FindByName(Name) : nullptr;
+    if (!View)
+    {
+        return;
+    }
+
+    // Apply at once rather than after the typing debounce
+    CloseSuggestions();
+    SearchText = FText::FromString(View->QueryString);
+    SearchBox->SetText(SearchText);
+    if (FilterDebounceHandle.IsValid())
+    {
+        UnRegisterActiveTimer(FilterDebounceHandle.ToSharedRef());
+        FilterDebounceHandle.Reset();
+    }
+    ParseAndApplyFilters();
+}
+
+TSharedRef<SWidget> SDevNoteSelector::MakeViewsMenu()
+{
+    FMenuBuilder MenuBuilder(true, nullptr);
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem)
+    {
+        return MenuBuilder.MakeWidget();
+    }
+
+    const FString CurrentQuery = SearchText.ToString();
+    const FDevNoteSavedView* CurrentView = Subsystem->GetSavedViews().FindByQuery(CurrentQuery);
+
+    MenuBuilder.BeginSection(NAME_None, FText::FromString(TEXT("Saved Views")));
+    for (const FDevNoteSavedView& View : Subsystem->GetSavedViews().GetViews())
+    {
+        MenuBuilder.AddMenuEntry(
+            FText::Format(FText::FromString(TEXT("{0} ({1})")), FText::FromString(View.Name), FText::AsNumber(View.NoteIds.Num())),
+            FText::FromString(View.QueryString),
+            FSlateIcon(),
+            FUIAction(FExecuteAction::CreateSP(this, &SDevNoteSelector::ApplySavedView, View.Name)));
+    }
+    MenuBuilder.EndSection();
+
+    MenuBuilder.BeginSection(NAME_None, FText::FromString(TEXT("Current Filter")));
+    if (!CurrentQuery.TrimStartAndEnd().IsEmpty())
+    {
+        MenuBuilder.AddWidget(
+            SNew(SEditableTextBox)
+            .HintText(FText::FromString(TEXT("Save current filter as...")))
+            .OnTextCommitted_Lambda([CurrentQuery](const FText& Text, ETextCommit::Type CommitType)
+            {
+                UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+                const FString ViewName = Text.ToString().TrimStartAndEnd();
+                if (Subsystem && CommitType == ETextCommit::OnEnter && !ViewName.IsEmpty())
+                {
+                    Subsystem->SaveView(ViewName, CurrentQuery);
+                    FSlateApplication::Get().DismissAllMenus();
+                }
+            }),
+            FText::GetEmpty());
+    }
+    if (CurrentView)
+    {
+        MenuBuilder.AddMenuEntry(
+            FText::Format(FText::FromString(TEXT("Delete '{0}'")), FText::FromString(CurrentView->Name)),
+            FText::FromString(TEXT("Remove the saved view matching the current filter")),
+            FSlateIcon(),
+            FUIAction(FExecuteAction::CreateLambda([Name = CurrentView->Name]()
+            {
+                if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+                {
+                    Subsystem->DeleteView(Name);
+                }
+            })));
+    }
+    MenuBuilder.EndSection();
+
+    return MenuBuilder.MakeWidget();
+}
+
+void SDevNoteSelector::ApplyFilterResults(const TSharedRef<const FDevNoteQuery, ESPMode::ThreadSafe>& Query, const FDevNoteSearchEntriesRef& Entries,
+    uint32 IndexVersion, const FName& SortedBy, EColumnSortMode::Type SortedMode, TArray<int32>&& Matches)
+{
+    // The sort column was changed while the filter ran
+    if (SortedBy != SortColumn || SortedMode != SortMode)
+    {
+        SortMatches(*Query, *Entries, MakeSortSpec(), Matches);
+    }
+
+    const bool bEntriesChanged = !AppliedQuery.IsValid() || AppliedIndexVersion != IndexVersion;
+    AppliedQuery = Query;
+    AppliedIndexVersion = IndexVersion;
+    AppliedResult = MoveTemp(Matches);
+
+    ShowAppliedResult(*Entries, bEntriesChanged);
+}
+
+const FDevNoteSearchEntries* SDevNoteSelector::FindAppliedEntries() const
+{
+    // The index bumps its version on every change, so an unchanged version means the very entries the results came from
+    const UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem || !AppliedQuery.IsValid() || Subsystem->GetSearchIndex().GetVersion() != AppliedIndexVersion)
+    {
+        return nullptr;
+    }
+    return &Subsystem->GetSearchIndex().GetEntries();
+}
+
+void SDevNoteSelector::UpdateBodySearchHint()
+{
+    // The server searched every body itself, only a local search misses the ones never fetched
+    const UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    const bool bShow = !bAppliedFromServer && AppliedQuery.IsValid() && AppliedQuery->ReadsBody() && Subsystem && Subsystem->IsSummarySyncEnabled();
+    if (BodySearchHint.IsValid())
     {
-        TCHAR C = InStr[i];
-        if (C == '\"')
+        BodySearchHint->SetVisibility(bShow ? EVisibility::Visible : EVisibility::Collapsed);
+    }
+}
+
+void SDevNoteSelector::ShowAppliedResult(const FDevNoteSearchEntries& Entries, bool bEntriesChanged)
+{
+    UpdateBodySearchHint();
+
+    FilteredNotes.Reset(AppliedResult.Num());
+    for (const int32 EntryIndex : AppliedResult)
+    {
+        FilteredNotes.Add(Entries.GetNote(EntryIndex));
+    }
+
+    if (Grouping != EDevNoteGrouping::None)
+    {
+        RebuildGroups(Entries);
+        return;
+    }
+
+    if (NotesListView.IsValid())
+    {
+        // Rows copy their columns from the entries, so new entries mean new rows
+        if (bEntriesChanged)
         {
-            bInQuotes = !bInQuotes;
-            continue;
+            NotesListView->RebuildList();
         }
-        if (!bInQuotes && FChar::IsWhitespace(C))
+        else
         {
-            if (!Current.IsEmpty())
-            {
-                OutTokens.Add(Current);
-                Current.Empty();
-            }
-            continue;
+            NotesListView->RequestListRefresh();
         }
-        Current.AppendChar(C);
     }
-    if (!Current.IsEmpty()) OutTokens.Add(Current);
 }
 
-void SDevNoteSelector::OnSearchTextChanged(const FText& Text)
+void SDevNoteSelector::SetGrouping(EDevNoteGrouping InGrouping)
 {
-    SearchText = Text;
-    ParseAndApplyFilters();
+    if (Grouping == InGrouping)
+    {
+        return;
+    }
+
+    Grouping = InGrouping;
+    ExpandedGroupKeys.Reset();
+    GroupItems.Reset();
+    if (ViewSwitcher.IsValid())
+    {
+        ViewSwitcher->SetActiveWidgetIndex(Grouping == EDevNoteGrouping::None ? 0 : 1);
+    }
+
+    if (const FDevNoteSearchEntries* Entries = FindAppliedEntries())
+    {
+        ShowAppliedResult(*Entries, true);
+    }
+    else
+    {
+        ParseAndApplyFilters();
+    }
 }
 
-void SDevNoteSelector::ParseAndApplyFilters()
+void SDevNoteSelector::RebuildGroups(const FDevNoteSearchEntries& Entries)
 {
-    TMap<FString, TArray<FString>> FieldFilters;
-    TArray<FString> GenericTerms;
-
-    TArray<FString> Tokens;
-    ParseSearchStringWithQuotes(SearchText.ToString(), Tokens);
+    GroupItems.Reset();
 
-    auto tags = UDevNoteSubsystem::Get()->GetCachedTags();
-    
-    for (const FString& Token : Tokens)
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!AppliedQuery.IsValid() || !Subsystem)
     {
-        // Split into key value
-        FString Key, Value;
-        if (Token.Split(TEXT("="), &Key, &Value))
+        if (NotesTreeView.IsValid())
         {
-            Key = Key.ToLower().TrimStartAndEnd();
-            Value = Value.TrimQuotes().TrimStartAndEnd();
-            FieldFilters.FindOrAdd(Key).Add(Value);
+            NotesTreeView->RequestTreeRefresh();
         }
-        else
+        return;
+    }
+
+    const FDevNoteSearchIndex& Index = Subsystem->GetSearchIndex();
+    const bool bByLevel = Grouping == EDevNoteGrouping::Level;
+
+    // Unfiltered, the groups the index keeps at ingest are the answer. Filtered, the results are bucketed once,
+    // which only moves indices around: no rows are made for groups that stay collapsed
+    TMap<FString, TArray<int32>> Buckets;
+    const bool bUseIndexGroups = AppliedQuery->IsEmpty() && Index.GetVersion() == AppliedIndexVersion;
+    if (bUseIndexGroups && bByLevel)
+    {
+        Buckets = Index.GetEntriesByLevel();
+    }
+    else if (bUseIndexGroups)
+    {
+        for (const TPair<FGuid, TArray<int32>>& Pair : Index.GetEntriesByTag())
         {
-            // Generic (no key - wildcard)
-            GenericTerms.Add(Token.TrimQuotes().TrimStartAndEnd());
+            Buckets.Add(Pair.Key.ToString(), Pair.Value);
         }
     }
-
-    FilteredNotes.Empty();
-    for (const auto& Note : Notes)
+    else
     {
-        bool bPass = true;
-        
-        // Name
-        if (FieldFilters.Contains("name"))
+        for (const int32 EntryIndex : AppliedResult)
         {
-            bool bAny = false;
-            for (const FString& Val : FieldFilters["name"])
+            const TArrayView<const uint16> Tags = Entries.GetTagIndices(EntryIndex);
+            if (bByLevel)
+            {
+                Buckets.FindOrAdd(Entries.GetLevelLower(EntryIndex)).Add(EntryIndex);
+            }
+            else if (Tags.IsEmpty())
             {
-                if (Note->Title.Contains(Val, ESearchCase::IgnoreCase))
+                Buckets.FindOrAdd(FGuid().ToString()).Add(EntryIndex);
+            }
+            else
+            {
+                for (const uint16 TagIndex : Tags)
                 {
-                    bAny = true; break;
+                    Buckets.FindOrAdd(Entries.GetInternedTagId(TagIndex).ToString()).Add(EntryIndex);
                 }
             }
-            if (!bAny) { bPass = false; }
         }
-        
-        // User
-        if (FieldFilters.Contains("user"))
+    }
+
+    GroupItems.Reserve(Buckets.Num());
+    for (TPair<FString, TArray<int32>>& Bucket : Buckets)
+    {
+        if (Bucket.Value.IsEmpty()) continue;
+
+        FString Name;
+        if (bByLevel)
+        {
+            Name = Entries.IsValidIndex(Bucket.Value[0]) ? Entries.GetLevelName(Bucket.Value[0]) : FString();
+            if (Name.IsEmpty()) Name = TEXT("No Level");
+        }
+        else
+        {
+            FGuid TagId;
+            FGuid::Parse(Bucket.Key, TagId);
+            const FDevNoteTagVisualCache::FVisual* Visual = TagId.IsValid() && TagVisuals.IsValid() ? TagVisuals->Find(TagId) : nullptr;
+            Name = TagId.IsValid() ? (Visual ? Visual->Name.ToString() : TEXT("Unknown Tag")) : TEXT("Untagged");
+        }
+
+        TSharedPtr<FDevNoteTreeItem> Group = MakeShared<FDevNoteTreeItem>();
+        Group->GroupKey = Bucket.Key;
+        Group->GroupLabel = FText::FromString(FString::Printf(TEXT("%s (%d)"), *Name, Bucket.Value.Num()));
+        Group->EntryIndices = MoveTemp(Bucket.Value);
+        GroupItems.Add(Group);
+    }
+
+    GroupItems.Sort([](const TSharedPtr<FDevNoteTreeItem>& A, const TSharedPtr<FDevNoteTreeItem>& B)
+    {
+        return A->GroupLabel.CompareToCaseIgnored(B->GroupLabel) < 0;
+    });
+
+    if (NotesTreeView.IsValid())
+    {
+        // Expansion is tracked by key, since every refresh makes new group items
+        for (const TSharedPtr<FDevNoteTreeItem>& Group : GroupItems)
         {
-            bool bAny = false;
-            for (const FString& Val : FieldFilters["user"])
+            if (ExpandedGroupKeys.Contains(Group->GroupKey))
             {
-                UDevNoteSubsystem* ss = UDevNoteSubsystem::Get();
-                auto user = ss->GetUserById(Note->CreatedById);
-                if (ss->GetUserById(Note->CreatedById).Name.Contains(Val, ESearchCase::IgnoreCase))
-                {
-                    bAny = true; break;
-                }
+                BuildGroupChildren(*Group, Entries);
+                NotesTreeView->SetItemExpansion(Group, true);
             }
-            if (!bAny) { bPass = false; }
         }
-        
-        // Map
-        if (FieldFilters.Contains("map"))
+        NotesTreeView->RebuildList();
+    }
+}
+
+void SDevNoteSelector::BuildGroupChildren(FDevNoteTreeItem& Group, const FDevNoteSearchEntries& Entries) const
+{
+    if (Group.bChildrenBuilt || !AppliedQuery.IsValid())
+    {
+        return;
+    }
+
+    // Index groups are unordered and buckets follow the results, either way the group gets the list's order
+    SortMatches(*AppliedQuery, Entries, MakeSortSpec(), Group.EntryIndices);
+
+    Group.Children.Reset(Group.EntryIndices.Num());
+    for (const int32 EntryIndex : Group.EntryIndices)
+    {
+        if (!Entries.IsValidIndex(EntryIndex)) continue;
+
+        TSharedPtr<FDevNoteTreeItem> Child = MakeShared<FDevNoteTreeItem>();
+        Child->Note = Entries.GetNote(EntryIndex);
+        Group.Children.Add(Child);
+    }
+    Group.bChildrenBuilt = true;
+}
+
+TSharedRef<ITableRow> SDevNoteSelector::OnGenerateTreeRow(TSharedPtr<FDevNoteTreeItem> InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    DEVNOTES_SCOPE(GenerateRows);
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    const bool bNote = InItem.IsValid() && !InItem->IsGroup();
+    const FDevNoteSearchIndex* Index = Subsystem && bNote ? &Subsystem->GetSearchIndex() : nullptr;
+
+    return SNew(SDevNoteTreeRow, OwnerTable)
+        .Item(InItem)
+        .Entries(Index ? &Index->GetEntries() : nullptr)
+        .EntryIndex(Index ? Index->FindEntryIndex(InItem->Note->Id) : INDEX_NONE)
+        .CameraLocation(bNote ? UDevNoteSubsystem::GetEditorCameraLocation() : FVector::ZeroVector)
+        .TagVisuals(TagVisuals);
+}
+
+void SDevNoteSelector::OnGetTreeChildren(TSharedPtr<FDevNoteTreeItem> InItem, TArray<TSharedPtr<FDevNoteTreeItem>>& OutChildren)
+{
+    if (!InItem.IsValid() || !InItem->IsGroup())
+    {
+        return;
+    }
+
+    // The tree asks every visible item for children, expanded or not
+    if (InItem->bChildrenBuilt)
+    {
+        OutChildren = InItem->Children;
+    }
+    else if (InItem->EntryIndices.Num() > 0)
+    {
+        OutChildren.Add(CollapsedPlaceholder);
+    }
+}
+
+void SDevNoteSelector::OnTreeExpansionChanged(TSharedPtr<FDevNoteTreeItem> InItem, bool bExpanded)
+{
+    if (!InItem.IsValid() || !InItem->IsGroup())
+    {
+        return;
+    }
+
+    if (bExpanded)
+    {
+        ExpandedGroupKeys.Add(InItem->GroupKey);
+
+        // Group indices are stale once the index changed, a new pass regroups and builds the expanded groups
+        if (const FDevNoteSearchEntries* Entries = FindAppliedEntries())
+        {
+            BuildGroupChildren(*InItem, *Entries);
+        }
+        else
+        {
+            ParseAndApplyFilters();
+        }
+    }
+    else
+    {
+        ExpandedGroupKeys.Remove(InItem->GroupKey);
+    }
+}
+
+void SDevNoteSelector::OnTreeSelectionChanged(TSharedPtr<FDevNoteTreeItem> InItem, ESelectInfo::Type SelectInfo)
+{
+    if (InItem.IsValid() && !InItem->IsGroup())
+    {
+        OnNoteSelectedInternal(InItem->Note, SelectInfo);
+    }
+}
+
+SDevNoteSelector::FSortSpec SDevNoteSelector::MakeSortSpec() const
+{
+    FSortSpec Spec;
+    Spec.Column = SortColumn;
+    Spec.Mode = SortMode;
+    if (SortColumn == DevNoteSelector::ColumnDistance)
+    {
+        Spec.CameraLocation = UDevNoteSubsystem::GetEditorCameraLocation();
+    }
+    return Spec;
+}
+
+namespace DevNoteSelector
+{
+    template <typename T>
+    static int32 CompareKeys(const T& A, const T& B)
+    {
+        return A < B ? -1 : (B < A ? 1 : 0);
+    }
+
+    // Sort by a three way key comparison, falling back to the note Id for equal keys
+    template <typename CompareType>
+    static void SortByKey(const FDevNoteSearchEntries& Entries, bool bAscending, TArray<int32>& InOutMatches, CompareType Compare)
+    {
+        Algo::Sort(InOutMatches, [&Entries, bAscending, &Compare](int32 A, int32 B)
         {
-            bool bAny = false;
-            for (const FString& Val : FieldFilters["map"])
+            const int32 Result = Compare(A, B);
+            if (Result != 0)
             {
-                if (Note->LevelPath.ToString().Contains(Val, ESearchCase::IgnoreCase))
-                {
-                    bAny = true; break;
-                }
+                return bAscending ? Result < 0 : Result > 0;
             }
-            if (!bAny) { bPass = false; }
+            return Entries.GetId(A) < Entries.GetId(B);
+        });
+    }
+
+    // Rank each interned value once, so sorting rows compares two integers instead of two strings. Equal values share a rank
+    template <typename CompareType>
+    static TArray<int32> RankInterned(int32 Num, CompareType Compare)
+    {
+        TArray<int32> Order;
+        Order.SetNumUninitialized(Num);
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Order[i] = i;
         }
-        
-        // Tag
-        if (FieldFilters.Contains("tag"))
+        Algo::Sort(Order, [&Compare](int32 A, int32 B) { return Compare(A, B) < 0; });
+
+        TArray<int32> Ranks;
+        Ranks.SetNumUninitialized(Num);
+        int32 Rank = 0;
+        for (int32 i = 0; i < Num; ++i)
         {
-            bool bAny = false;
-            for (const FString& Val : FieldFilters["tag"])
+            if (i > 0 && Compare(Order[i - 1], Order[i]) != 0)
             {
-                // Check all tags for this note
-                for (const FGuid& NoteTagId : Note->Tags)
-                {
-                    // Find the tag with this ID
-                    if (const FDevNoteTag* FoundTag = tags.FindByPredicate([&NoteTagId](const FDevNoteTag& NoteTag) { 
-                        return NoteTag.Id == NoteTagId; 
-                    }))
-                    {
-                        if (FoundTag->Name.Contains(Val, ESearchCase::IgnoreCase))
-                        {
-                            bAny = true;
-                            break;
-                        }
-                    }
-                }
-                if (bAny) break; // Exit outer loop if we found a match
+                ++Rank;
             }
-            if (!bAny) { bPass = false; }
+            Ranks[Order[i]] = Rank;
         }
+        return Ranks;
+    }
+}
 
-        
+void SDevNoteSelector::SortMatches(const FDevNoteQuery& Query, const FDevNoteSearchEntries& Entries, const FSortSpec& Spec, TArray<int32>& InOutMatches)
+{
+    using namespace DevNoteSelector;
 
-        // Generic/wildcard terms
-        if (bPass && GenericTerms.Num() > 0)
+    if (Spec.Mode == EColumnSortMode::None)
+    {
+        // Sync order, with the best text matches first. Refined results may still be in an older column order
+        InOutMatches.Sort();
+        if (Query.IsRanked())
         {
-            bool bAnyGeneric = false;
-            for (const FString& Term : GenericTerms)
-            {
-                // Title, level, user
-                if (Note->Title.Contains(Term, ESearchCase::IgnoreCase) ||
-                    Note->LevelPath.ToString().Contains(Term, ESearchCase::IgnoreCase) ||
-                    UDevNoteSubsystem::Get()->GetUserById(Note->CreatedById).Name.Contains(Term, ESearchCase::IgnoreCase))
-                {
-                    bAnyGeneric = true;
-                    break;
-                }
-                
-                // Check all tags for this note
-                for (const FGuid& NoteTagId : Note->Tags)
-                {
-                    if (const FDevNoteTag* FoundTag = tags.FindByPredicate([&NoteTagId](const FDevNoteTag& NoteTag) { 
-                        return NoteTag.Id == NoteTagId; 
-                    }))
-                    {
-                        if (FoundTag->Name.Contains(Term, ESearchCase::IgnoreCase))
-                        {
-                            bAnyGeneric = true;
-                            break;
-                        }
-                    }
-                }
-                if (bAnyGeneric) break; // Exit outer loop if we found a match
-            }
-            if (!bAnyGeneric) { bPass = false; }
+            Query.SortByScore(Entries, InOutMatches);
         }
+        return;
+    }
 
-        if (bPass)
+    const bool bAscending = Spec.Mode == EColumnSortMode::Ascending;
+    if (Spec.Column == ColumnTitle)
+    {
+        SortByKey(Entries, bAscending, InOutMatches, [&Entries](int32 A, int32 B)
+        {
+            return Entries.GetTitleLower(A).Compare(Entries.GetTitleLower(B), ESearchCase::CaseSensitive);
+        });
+    }
+    else if (Spec.Column == ColumnAuthor)
+    {
+        const TArray<int32> Ranks = RankInterned(Entries.NumUsers(), [&Entries](int32 A, int32 B)
+        {
+            return Entries.GetInternedUserName(A).Compare(Entries.GetInternedUserName(B), ESearchCase::IgnoreCase);
+        });
+        SortByKey(Entries, bAscending, InOutMatches, [&Entries, &Ranks](int32 A, int32 B)
+        {
+            return CompareKeys(Ranks[Entries.GetAuthorIndex(A)], Ranks[Entries.GetAuthorIndex(B)]);
+        });
+    }
+    else if (Spec.Column == ColumnLevel)
+    {
+        const TArray<int32> Ranks = RankInterned(Entries.NumLevels(), [&Entries](int32 A, int32 B)
+        {
+            return Entries.GetInternedLevelLower(A).Compare(Entries.GetInternedLevelLower(B), ESearchCase::CaseSensitive);
+        });
+        SortByKey(Entries, bAscending, InOutMatches, [&Entries, &Ranks](int32 A, int32 B)
+        {
+            return CompareKeys(Ranks[Entries.GetLevelIndex(A)], Ranks[Entries.GetLevelIndex(B)]);
+        });
+    }
+    else if (Spec.Column == ColumnCreated)
+    {
+        SortByKey(Entries, bAscending, InOutMatches, [&Entries](int32 A, int32 B)
+        {
+            return CompareKeys(Entries.GetCreatedTicks(A), Entries.GetCreatedTicks(B));
+        });
+    }
+    else if (Spec.Column == ColumnLastEdited)
+    {
+        SortByKey(Entries, bAscending, InOutMatches, [&Entries](int32 A, int32 B)
         {
-            FilteredNotes.Add(Note);
+            return CompareKeys(Entries.GetLastEditedTicks(A), Entries.GetLastEditedTicks(B));
+        });
+    }
+    else if (Spec.Column == ColumnTags)
+    {
+        SortByKey(Entries, bAscending, InOutMatches, [&Entries](int32 A, int32 B)
+        {
+            return CompareKeys(Entries.GetTagCount(A), Entries.GetTagCount(B));
+        });
+    }
+    else if (Spec.Column == ColumnDistance)
+    {
+        // Distances depend on the camera, so they are computed once per sort and sorted along with their entries
+        TArray<TPair<double, int32>> Keyed;
+        Keyed.Reserve(InOutMatches.Num());
+        for (const int32 EntryIndex : InOutMatches)
+        {
+            Keyed.Emplace(FVector::DistSquared(Entries.GetWorldPosition(EntryIndex), Spec.CameraLocation), EntryIndex);
         }
 
+        Algo::Sort(Keyed, [&Entries, bAscending](const TPair<double, int32>& A, const TPair<double, int32>& B)
+        {
+            const int32 Result = CompareKeys(A.Key, B.Key);
+            if (Result != 0)
+            {
+                return bAscending ? Result < 0 : Result > 0;
+            }
+            return Entries.GetId(A.Value) < Entries.GetId(B.Value);
+        });
+
+        for (int32 i = 0; i < Keyed.Num(); ++i)
+        {
+            InOutMatches[i] = Keyed[i].Value;
+        }
     }
+}
 
-    if (NotesListView.IsValid())
+EColumnSortMode::Type SDevNoteSelector::GetColumnSortMode(const FName ColumnId) const
+{
+    return ColumnId == SortColumn ? SortMode : EColumnSortMode::None;
+}
+
+void SDevNoteSelector::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode)
+{
+    SortColumn = ColumnId;
+    SortMode = InSortMode;
+
+    const FDevNoteSearchEntries* Entries = FindAppliedEntries();
+    if (!Entries)
     {
-        NotesListView->RequestListRefresh();
+        ParseAndApplyFilters();
+        return;
     }
+
+    // Same notes, new order: no need to filter again
+    SortMatches(*AppliedQuery, *Entries, MakeSortSpec(), AppliedResult);
+    ShowAppliedResult(*Entries, false);
 }
 
 void SDevNoteSelector::Construct(const FArguments& InArgs)
@@ -196,6 +1315,15 @@ void SDevNoteSelector::Construct(const FArguments& InArgs)
     NoteSelectedDelegate = InArgs._OnNoteSelected;
     OnRefreshNotes = InArgs._OnRefreshNotes;
     OnNewNote = InArgs._OnNewNote;
+    TagVisuals = MakeShared<FDevNoteTagVisualCache>();
+    CollapsedPlaceholder = MakeShared<FDevNoteTreeItem>();
+
+    if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+    {
+        Subsystem->OnNotesChanged.AddSP(SharedThis(this), &SDevNoteSelector::ApplyNoteChanges);
+        Subsystem->OnTagsChanged.AddSP(SharedThis(this), &SDevNoteSelector::OnTagsChanged);
+        Subsystem->OnUsersUpdated.AddSP(SharedThis(this), &SDevNoteSelector::OnSearchIndexChanged);
+    }
 
     ChildSlot
     [
@@ -219,6 +1347,40 @@ void SDevNoteSelector::Construct(const FArguments& InArgs)
                 .Text(FText::FromString(TEXT("Add")))
                 .OnClicked(this, &SDevNoteSelector::OnNewNoteClicked)
             ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SComboButton)
+                .ButtonContent()
+                [
+                    SNew(STextBlock)
+                    .Text(FText::FromString(TEXT("Views")))
+                ]
+                .ToolTipText(FText::FromString(TEXT("Open a saved filter, or save the current one")))
+                .OnGetMenuContent(this, &SDevNoteSelector::MakeViewsMenu)
+            ]
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            [
+                SNew(SSpacer)
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            [
+                SNew(SSegmentedControl<EDevNoteGrouping>)
+                .Value(Grouping)
+                .OnValueChanged(this, &SDevNoteSelector::SetGrouping)
+                + SSegmentedControl<EDevNoteGrouping>::Slot(EDevNoteGrouping::None)
+                .Text(FText::FromString(TEXT("List")))
+                .ToolTip(FText::FromString(TEXT("Show notes as a flat list")))
+                + SSegmentedControl<EDevNoteGrouping>::Slot(EDevNoteGrouping::Level)
+                .Text(FText::FromString(TEXT("By Level")))
+                .ToolTip(FText::FromString(TEXT("Group notes by level")))
+                + SSegmentedControl<EDevNoteGrouping>::Slot(EDevNoteGrouping::Tag)
+                .Text(FText::FromString(TEXT("By Tag")))
+                .ToolTip(FText::FromString(TEXT("Group notes by tag. Notes with several tags appear in each of their groups")))
+            ]
         ]
         
         //Search / filter bar
@@ -226,46 +1388,116 @@ void SDevNoteSelector::Construct(const FArguments& InArgs)
         .AutoHeight()
         .HAlign(HAlign_Fill)
         [
-            SNew(SEditableTextBox)
-            .HintText(FText::FromString("Search (e.g., Map=Test User=Alice Name=\"Big Boss\")"))
-            .ToolTipText(FText::FromString(
-                "Filtering syntax:\n"
-                " field=value     (e.g., Map=Test)\n"
-                " field=\"multi word\" (e.g., Name=\"Big Boss\")\n"
-                " Use spaces to add more filters (AND)\n"
-                " Repeat a field for OR (e.g., Name=Alice Name=Bob)\n"
-                " Unqualified terms match any field (OR)\n"
-                "Examples:\n"
-                " Map=Test Name=Bob\n"
-                " Tag=\"Mission Critical\" User=Alice"
-            ))
-            .OnTextChanged(this, &SDevNoteSelector::OnSearchTextChanged)
+            SAssignNew(SuggestionMenu, SMenuAnchor)
+            .Placement(MenuPlacement_ComboBox)
+            .Method(EPopupMethod::UseCurrentWindow)
+            .MenuContent(MakeSuggestionMenu())
+            [
+                SAssignNew(SearchBox, SEditableTextBox)
+                .HintText(FText::FromString("Search (e.g., Map=Test User=Alice Body=crash)"))
+                .ToolTipText(FText::FromString(
+                    "Filtering syntax:\n"
+                    " field=value     (e.g., Map=Test)\n"
+                    " field=\"multi word\" (e.g., Name=\"Big Boss\")\n"
+                    " Use spaces to add more filters (AND)\n"
+                    " Repeat a field for OR (e.g., Name=Alice Name=Bob)\n"
+                    " Unqualified terms match any field, including the body (OR)\n"
+                    " Body=text searches note bodies by word prefix\n"
+                    " With summary sync on, bodies are only searched once fetched,\n"
+                    "  unless the query server searches them\n"
+                    " Results of text searches are ordered by relevance\n"
+                    "Examples:\n"
+                    " Map=Test Name=Bob\n"
+                    " Tag=\"Mission Critical\" User=Alice\n"
+                    "Tag=, User= and Map= values are completed as you type: Up/Down to pick, Tab or Enter to accept"
+                ))
+                .OnTextChanged(this, &SDevNoteSelector::OnSearchTextChanged)
+                .OnKeyDownHandler(this, &SDevNoteSelector::OnSearchKeyDown)
+            ]
+        ]
+
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f, 2.0f)
+        [
+            SAssignNew(BodySearchHint, STextBlock)
+            .Visibility(EVisibility::Collapsed)
+            .ColorAndOpacity(FSlateColor::UseSubduedForeground())
+            .Text(FText::FromString(TEXT("Summary sync is on: only the bodies of notes opened or prefetched so far are searched")))
         ]
 
         // Note editor
         + SVerticalBox::Slot()
         .FillHeight(1.0f)
         [
-            SAssignNew(NotesListView, SListView<TSharedPtr<FDevNote>>)
-            .ListItemsSource(&FilteredNotes)
-            .ReturnFocusToSelection(true)
-            .OnGenerateRow(this, &SDevNoteSelector::OnGenerateNoteRow)
-            .OnSelectionChanged(this, &SDevNoteSelector::OnNoteSelectedInternal)
-            .SelectionMode(ESelectionMode::Single)
+            SAssignNew(ViewSwitcher, SWidgetSwitcher)
+            .WidgetIndex(0)
+            + SWidgetSwitcher::Slot()
+            [
+                SAssignNew(NotesListView, SListView<TSharedPtr<FDevNote>>)
+                .ListItemsSource(&FilteredNotes)
+                .ReturnFocusToSelection(true)
+                .OnGenerateRow(this, &SDevNoteSelector::OnGenerateNoteRow)
+                .OnSelectionChanged(this, &SDevNoteSelector::OnNoteSelectedInternal)
+                .SelectionMode(ESelectionMode::Single)
+                .HeaderRow(MakeHeaderRow())
+            ]
+            + SWidgetSwitcher::Slot()
+            [
+                SAssignNew(NotesTreeView, STreeView<TSharedPtr<FDevNoteTreeItem>>)
+                .TreeItemsSource(&GroupItems)
+                .OnGenerateRow(this, &SDevNoteSelector::OnGenerateTreeRow)
+                .OnGetChildren(this, &SDevNoteSelector::OnGetTreeChildren)
+                .OnExpansionChanged(this, &SDevNoteSelector::OnTreeExpansionChanged)
+                .OnSelectionChanged(this, &SDevNoteSelector::OnTreeSelectionChanged)
+                .SelectionMode(ESelectionMode::Single)
+                .HeaderRow(MakeHeaderRow())
+            ]
         ]
     ];
-}
 
+    // Start from the notes the subsystem already has, later syncs arrive as changes
+    ParseAndApplyFilters();
+}
 
-void SDevNoteSelector::SetNotesSource(const TArray<TSharedPtr<FDevNote>>& InNotes)
+TSharedRef<SHeaderRow> SDevNoteSelector::MakeHeaderRow()
 {
-    Notes.Empty();
-    for (auto& Note : InNotes)
-    {
-        Notes.Add(Note);
-    }
-
-    ParseAndApplyFilters();
+    return SNew(SHeaderRow)
+        + SHeaderRow::Column(DevNoteSelector::ColumnTitle)
+        .DefaultLabel(FText::FromString(TEXT("Title")))
+        .FillWidth(0.3f)
+        .SortMode(this, &SDevNoteSelector::GetColumnSortMode, DevNoteSelector::ColumnTitle)
+        .OnSort(this, &SDevNoteSelector::OnColumnSortModeChanged)
+        + SHeaderRow::Column(DevNoteSelector::ColumnAuthor)
+        .DefaultLabel(FText::FromString(TEXT("Author")))
+        .FillWidth(0.12f)
+        .SortMode(this, &SDevNoteSelector::GetColumnSortMode, DevNoteSelector::ColumnAuthor)
+        .OnSort(this, &SDevNoteSelector::OnColumnSortModeChanged)
+        + SHeaderRow::Column(DevNoteSelector::ColumnLevel)
+        .DefaultLabel(FText::FromString(TEXT("Level")))
+        .FillWidth(0.12f)
+        .SortMode(this, &SDevNoteSelector::GetColumnSortMode, DevNoteSelector::ColumnLevel)
+        .OnSort(this, &SDevNoteSelector::OnColumnSortModeChanged)
+        + SHeaderRow::Column(DevNoteSelector::ColumnCreated)
+        .DefaultLabel(FText::FromString(TEXT("Created")))
+        .FillWidth(0.13f)
+        .SortMode(this, &SDevNoteSelector::GetColumnSortMode, DevNoteSelector::ColumnCreated)
+        .OnSort(this, &SDevNoteSelector::OnColumnSortModeChanged)
+        + SHeaderRow::Column(DevNoteSelector::ColumnLastEdited)
+        .DefaultLabel(FText::FromString(TEXT("Last Edited")))
+        .FillWidth(0.13f)
+        .SortMode(this, &SDevNoteSelector::GetColumnSortMode, DevNoteSelector::ColumnLastEdited)
+        .OnSort(this, &SDevNoteSelector::OnColumnSortModeChanged)
+        + SHeaderRow::Column(DevNoteSelector::ColumnTags)
+        .DefaultLabel(FText::FromString(TEXT("Tags")))
+        .FillWidth(0.12f)
+        .SortMode(this, &SDevNoteSelector::GetColumnSortMode, DevNoteSelector::ColumnTags)
+        .OnSort(this, &SDevNoteSelector::OnColumnSortModeChanged)
+        + SHeaderRow::Column(DevNoteSelector::ColumnDistance)
+        .DefaultLabel(FText::FromString(TEXT("Distance")))
+        .FillWidth(0.08f)
+        .SortMode(this, &SDevNoteSelector::GetColumnSortMode, DevNoteSelector::ColumnDistance)
+        .OnSort(this, &SDevNoteSelector::OnColumnSortModeChanged);
 }
 
 void SDevNoteSelector::SetSelectedNote(const TSharedPtr<FDevNote>& InNote)
@@ -274,73 +1506,39 @@ void SDevNoteSelector::SetSelectedNote(const TSharedPtr<FDevNote>& InNote)
     {
         NotesListView->SetSelection(InNote);
     }
+
+    // Only groups that were opened have rows to select
+    if (NotesTreeView.IsValid() && Grouping != EDevNoteGrouping::None)
+    {
+        for (const TSharedPtr<FDevNoteTreeItem>& Group : GroupItems)
+        {
+            const TSharedPtr<FDevNoteTreeItem>* Found = Group->Children.FindByPredicate([&InNote](const TSharedPtr<FDevNoteTreeItem>& Child)
+            {
+                return Child->Note == InNote;
+            });
+            if (Found)
+            {
+                NotesTreeView->SetSelection(*Found);
+                break;
+            }
+        }
+    }
 }
 
 TSharedRef<ITableRow> SDevNoteSelector::OnGenerateNoteRow(
     TSharedPtr<FDevNote> InNote,
     const TSharedRef<STableViewBase>& OwnerTable)
 {
-    // Get cached tags from subsystem
-    auto CachedTags = UDevNoteSubsystem::Get()->GetCachedTags();
-    
-    TSharedPtr<SHorizontalBox> TagCirclesBox = SNew(SHorizontalBox);
-    
-    // Tag circle for each tag on note
-    for (const FGuid& TagId : InNote->Tags)
-    {
-        if (const FDevNoteTag* FoundTag = CachedTags.FindByPredicate([&TagId](const FDevNoteTag& NoteTag) { 
-            return NoteTag.Id == TagId; 
-        }))
-        {
-            FColor TagColor;
-            TagColor.DWColor() = FoundTag->Colour;
-            FLinearColor DisplayColor = FLinearColor::FromSRGBColor(TagColor);
-            
-            TagCirclesBox->AddSlot()
-            .AutoWidth()
-            .Padding(2.0f, 0.0f)
-            [
-                SNew(SBox)
-                .WidthOverride(12.0f)
-                .HeightOverride(12.0f)
-                .ToolTipText(FText::FromString(FString::Printf(TEXT("%s\nColor: R=%.2f G=%.2f B=%.2f"), 
-                    *FoundTag->Name, 
-                    DisplayColor.R, 
-                    DisplayColor.G, 
-                    DisplayColor.B)))
-                [
-                    SNew(SImage)
-                    .Image(FAppStyle::GetBrush("Icons.FilledCircle"))
-                    .ColorAndOpacity(DisplayColor)
-                ]
-            ];
-        }
-    }
-    
-    return SNew(STableRow<TSharedPtr<FDevNote>>, OwnerTable)
-    [
-        SNew(SHorizontalBox)
-        
-        // Note title
-        + SHorizontalBox::Slot()
-        .FillWidth(1.0f)
-        .VAlign(VAlign_Center)
-        [
-            SNew(STextBlock)
-            .Text(FText::FromString(InNote->Title))
-        ]
-        
-        // Tag circles
-        + SHorizontalBox::Slot()
-        .AutoWidth()
-        .VAlign(VAlign_Center)
-        .Padding(8.0f, 0.0f, 0.0f, 0.0f)
-        [
-            TagCirclesBox.ToSharedRef()
-        ]
-    ];
-
+    DEVNOTES_SCOPE(GenerateRows);
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    const FDevNoteSearchIndex* Index = Subsystem && InNote.IsValid() ? &Subsystem->GetSearchIndex() : nullptr;
 
+    return SNew(SDevNoteListRow, OwnerTable)
+        .Note(InNote)
+        .Entries(Index ? &Index->GetEntries() : nullptr)
+        .EntryIndex(Index ? Index->FindEntryIndex(InNote->Id) : INDEX_NONE)
+        .CameraLocation(UDevNoteSubsystem::GetEditorCameraLocation())
+        .TagVisuals(TagVisuals);
 }
 
 void SDevNoteSelector::OnNoteSelectedInternal(TSharedPtr<FDevNote> InNote, ESelectInfo::Type SelectionType)
@@ -349,6 +1547,36 @@ void SDevNoteSelector::OnNoteSelectedInternal(TSharedPtr<FDevNote> InNote, ESele
     {
         NoteSelectedDelegate.Execute(InNote);
     }
+
+    PrefetchNeighbourBodies(InNote);
+}
+
+void SDevNoteSelector::PrefetchNeighbourBodies(const TSharedPtr<FDevNote>& InNote) const
+{
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!InNote.IsValid() || !Subsystem || !Subsystem->IsSummarySyncEnabled())
+    {
+        return;
+    }
+
+    const int32 SelectedIndex = FilteredNotes.IndexOfByKey(InNote);
+    if (SelectedIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    // Users tend to step through the list with the arrow keys, so warm the rows around the selection
+    const int32 Radius = GetDefault<UDevNotesDeveloperSettings>()->NoteBodyPrefetchRadius;
+    TArray<FGuid> ToPrefetch;
+    for (int32 Index = FMath::Max(0, SelectedIndex - Radius); Index <= FMath::Min(FilteredNotes.Num() - 1, SelectedIndex + Radius); ++Index)
+    {
+        const TSharedPtr<FDevNote>& Neighbour = FilteredNotes[Index];
+        if (Index != SelectedIndex && Neighbour.IsValid() && !Neighbour->bBodyLoaded)
+        {
+            ToPrefetch.Add(Neighbour->Id);
+        }
+    }
+    Subsystem->PrefetchNoteBodies(ToPrefetch);
 }
 
 FReply SDevNoteSelector::OnRefreshClicked()
@@ -1,8 +1,40 @@
 ﻿#pragma once
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/STreeView.h"
+#include "DevNoteQuery.h"
 #include "FDevNote.h"
 
+class FDevNoteTagVisualCache;
+struct FDevNoteChangeSet;
+struct FDevNoteSuggestion;
+class SEditableTextBox;
+class SMenuAnchor;
+class SHeaderRow;
+class SWidgetSwitcher;
+
+enum class EDevNoteGrouping : uint8
+{
+	None,
+	Level,
+	Tag
+};
+
+// An item of the grouped note tree: a group, or a note in one
+struct FDevNoteTreeItem
+{
+	TSharedPtr<FDevNote> Note;
+
+	// Groups only. Children are created from EntryIndices the first time the group is expanded
+	FString GroupKey;
+	FText GroupLabel;
+	TArray<int32> EntryIndices;
+	TArray<TSharedPtr<FDevNoteTreeItem>> Children;
+	bool bChildrenBuilt = false;
+
+	bool IsGroup() const { return !Note.IsValid(); }
+};
+
 DECLARE_DELEGATE_OneParam(FOnDevNoteSelected, TSharedPtr<FDevNote>);
 DECLARE_DELEGATE(FOnRefreshNotes);
 DECLARE_DELEGATE(FOnNewNote);
@@ -18,19 +50,124 @@ SLATE_END_ARGS()
 
 void Construct(const FArguments& InArgs);
 
-	void SetNotesSource(const TArray<TSharedPtr<FDevNote>>& InNotes);
 	void SetSelectedNote(const TSharedPtr<FDevNote>& InNote);
+
+	// Put a saved view's filter in the search box and show its results
+	void ApplySavedView(const FString& Name);
 private:
-	TArray<TSharedPtr<FDevNote>> Notes;
 	TArray<TSharedPtr<FDevNote>> FilteredNotes;
 
 	TSharedPtr<SListView<TSharedPtr<FDevNote>>> NotesListView;
+
+	// Column the list is sorted by. None keeps the sync order, or relevance for text searches
+	FName SortColumn;
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
 	FOnDevNoteSelected NoteSelectedDelegate;
 
+	// Tag colours and tooltips shared by all rows
+	TSharedPtr<FDevNoteTagVisualCache> TagVisuals;
+
+	// Grouped mode shows the same results in a tree of levels or tags
+	EDevNoteGrouping Grouping = EDevNoteGrouping::None;
+	TSharedPtr<SWidgetSwitcher> ViewSwitcher;
+	TSharedPtr<STreeView<TSharedPtr<FDevNoteTreeItem>>> NotesTreeView;
+	TArray<TSharedPtr<FDevNoteTreeItem>> GroupItems;
+	TSet<FString> ExpandedGroupKeys;
+
+	// Reported as the only child of collapsed groups so they get an expander without building their rows
+	TSharedPtr<FDevNoteTreeItem> CollapsedPlaceholder;
+
+	void SetGrouping(EDevNoteGrouping InGrouping);
+	void RebuildGroups(const FDevNoteSearchEntries& Entries);
+	void BuildGroupChildren(FDevNoteTreeItem& Group, const FDevNoteSearchEntries& Entries) const;
+	TSharedRef<SHeaderRow> MakeHeaderRow();
+	TSharedRef<ITableRow> OnGenerateTreeRow(TSharedPtr<FDevNoteTreeItem> InItem, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetTreeChildren(TSharedPtr<FDevNoteTreeItem> InItem, TArray<TSharedPtr<FDevNoteTreeItem>>& OutChildren);
+	void OnTreeExpansionChanged(TSharedPtr<FDevNoteTreeItem> InItem, bool bExpanded);
+	void OnTreeSelectionChanged(TSharedPtr<FDevNoteTreeItem> InItem, ESelectInfo::Type SelectInfo);
+
 	FText SearchText;
+
+	// Query compiled from SearchText, reused until the text or the search index changes
+	TSharedPtr<const FDevNoteQuery, ESPMode::ThreadSafe> CompiledQuery;
+	uint32 CompiledIndexVersion = 0;
+
+	// Filtering runs on worker threads for large note counts. Each pass gets a generation and a cancel flag,
+	// so results of a pass that was overtaken by newer input are dropped
+	TSharedPtr<FActiveTimerHandle> FilterDebounceHandle;
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> InFlightFilterCancel;
+	uint32 FilterGeneration = 0;
+
+	// The last results shown, refined instead of rescanned when the next query only narrows this one.
+	// FilteredNotes holds the note of each AppliedResult entry, in the same order
+	TSharedPtr<const FDevNoteQuery, ESPMode::ThreadSafe> AppliedQuery;
+	uint32 AppliedIndexVersion = 0;
+	TArray<int32> AppliedResult;
+
+	// The entries AppliedResult indexes into, or null once the index changed since. They aren't held between filters,
+	// which would make the index copy all of them on its next update
+	const FDevNoteSearchEntries* FindAppliedEntries() const;
+
+	// With server side filtering on, a failed query means the server is unreachable: filter locally until this time
+	double ServerFilterRetryTime = 0.0;
+
+	// With summary sync on, only bodies fetched so far are indexed. The hint says so while a local search reads bodies
+	TSharedPtr<STextBlock> BodySearchHint;
+	bool bAppliedFromServer = false;
+	void UpdateBodySearchHint();
 	
+	// Completions for the tag, user or level being typed at the end of the search text
+	TSharedPtr<SEditableTextBox> SearchBox;
+	TSharedPtr<SMenuAnchor> SuggestionMenu;
+	TSharedPtr<SListView<TSharedPtr<FDevNoteSuggestion>>> SuggestionListView;
+	TArray<TSharedPtr<FDevNoteSuggestion>> Suggestions;
+
+	// Where the token being completed starts in the search text, and the field it names if any ("tag", "user", ...)
+	int32 SuggestionTokenStart = INDEX_NONE;
+	FString SuggestionTokenKey;
+
+	void UpdateSuggestions(const FString& Text);
+	void AcceptSuggestion(TSharedPtr<FDevNoteSuggestion> Suggestion);
+	void CloseSuggestions();
+	TSharedRef<SWidget> MakeSuggestionMenu();
+	TSharedRef<ITableRow> OnGenerateSuggestionRow(TSharedPtr<FDevNoteSuggestion> InSuggestion, const TSharedRef<STableViewBase>& OwnerTable);
+	FReply OnSearchKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent);
+
 	void OnSearchTextChanged(const FText& Text);
+	EActiveTimerReturnType OnFilterDebounceElapsed(double InCurrentTime, float InDeltaTime);
+	void OnSearchIndexChanged();
+	void OnTagsChanged(const FDevNoteChangeSet& Changes);
+
+	// Patch the shown results with a sync's changes: only added and changed notes are tested against the query.
+	// Queries with a time range get a full pass instead, since notes may have left a relative range without changing
+	void ApplyNoteChanges(const FDevNoteChangeSet& Changes);
+	void CompileQuery(const FDevNoteSearchIndex& Index);
 	void ParseAndApplyFilters();
+	// Show the notes a server query returned, which the subsystem has already merged into the search index
+	void ApplyServerResults(const TArray<FGuid>& NoteIds);
+	// Show entries already known to match the current query, from the server or a saved view
+	void ApplyMatchingEntries(TArray<int32>&& Matches);
+	TSharedRef<SWidget> MakeViewsMenu();
+	void ApplyFilterResults(const TSharedRef<const FDevNoteQuery, ESPMode::ThreadSafe>& Query, const FDevNoteSearchEntriesRef& Entries,
+		uint32 IndexVersion, const FName& SortedBy, EColumnSortMode::Type SortedMode, TArray<int32>&& Matches);
+
+	struct FSortSpec
+	{
+		FName Column;
+		EColumnSortMode::Type Mode = EColumnSortMode::None;
+
+		// Distances are measured from where the camera was when the sort started
+		FVector CameraLocation = FVector::ZeroVector;
+	};
+	FSortSpec MakeSortSpec() const;
+
+	// Order entry indices by the sort column, ties broken by note Id so the order survives re-syncs.
+	// Only reads its arguments, so filter tasks sort on the worker thread too
+	static void SortMatches(const FDevNoteQuery& Query, const FDevNoteSearchEntries& Entries, const FSortSpec& Spec, TArray<int32>& InOutMatches);
+	void ShowAppliedResult(const FDevNoteSearchEntries& Entries, bool bEntriesChanged);
+
+	EColumnSortMode::Type GetColumnSortMode(const FName ColumnId) const;
+	void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode);
 
 	TSharedRef<ITableRow> OnGenerateNoteRow(TSharedPtr<FDevNote>, const TSharedRef<STableViewBase>&);
 	FReply OnRefreshClicked();
@@ -40,5 +177,6 @@ private:
 	FOnNewNote OnNewNote;
 
 	void OnNoteSelectedInternal(TSharedPtr<FDevNote> InNote, ESelectInfo::Type);
+	void PrefetchNeighbourBodies(const TSharedPtr<FDevNote>& InNote) const;
 
 };
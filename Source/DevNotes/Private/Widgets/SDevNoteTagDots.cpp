@@ -0,0 +1,101 @@
+#include "SDevNoteTagDots.h"
+
+#include "DevNoteTagVisualCache.h"
+#include "Rendering/DrawElements.h"
+
+void SDevNoteTagDots::Construct(const FArguments& InArgs)
+{
+    TagVisuals = InArgs._TagVisuals;
+    Tags = InArgs._Tags;
+    DotSize = InArgs._DotSize;
+    DotSpacing = InArgs._DotSpacing;
+
+    SetToolTipText(MakeAttributeSP(this, &SDevNoteTagDots::GetHoveredToolTip));
+}
+
+FVector2D SDevNoteTagDots::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    return FVector2D(NumSlots() * (DotSize + DotSpacing), DotSize);
+}
+
+int32 SDevNoteTagDots::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    if (!TagVisuals.IsValid() || !TagVisuals->GetDotBrush())
+    {
+        return LayerId;
+    }
+
+    const FSlateBrush* Brush = TagVisuals->GetDotBrush();
+    const float Top = (AllottedGeometry.GetLocalSize().Y - DotSize) * 0.5f;
+    float Left = DotSpacing * 0.5f;
+    for (const FDevNoteTagVisualCache::FVisual* Visual : GetSlotVisuals())
+    {
+        FSlateDrawElement::MakeBox(
+            OutDrawElements,
+            LayerId,
+            AllottedGeometry.ToPaintGeometry(FVector2f(DotSize, DotSize), FSlateLayoutTransform(FVector2f(Left, Top))),
+            Brush,
+            ESlateDrawEffect::None,
+            InWidgetStyle.GetColorAndOpacityTint() * Visual->Color);
+        Left += DotSize + DotSpacing;
+    }
+    return LayerId;
+}
+
+FReply SDevNoteTagDots::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+    const float LocalX = MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()).X;
+    const int32 Slot = FMath::FloorToInt(LocalX / (DotSize + DotSpacing));
+    HoveredSlot = Slot >= 0 && Slot < NumSlots() ? Slot : INDEX_NONE;
+    return FReply::Unhandled();
+}
+
+void SDevNoteTagDots::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+    SLeafWidget::OnMouseLeave(MouseEvent);
+    HoveredSlot = INDEX_NONE;
+}
+
+FText SDevNoteTagDots::GetHoveredToolTip() const
+{
+    const FDevNoteTagVisualCache::FVisual* Visual = FindVisualInSlot(HoveredSlot);
+    return Visual ? Visual->ToolTip : FText::GetEmpty();
+}
+
+const FDevNoteTagVisualCache::FVisual* SDevNoteTagDots::FindVisualInSlot(int32 Slot) const
+{
+    const TArray<const FDevNoteTagVisualCache::FVisual*>& Visuals = GetSlotVisuals();
+    return Visuals.IsValidIndex(Slot) ? Visuals[Slot] : nullptr;
+}
+
+int32 SDevNoteTagDots::NumSlots() const
+{
+    return GetSlotVisuals().Num();
+}
+
+const TArray<const FDevNoteTagVisualCache::FVisual*>& SDevNoteTagDots::GetSlotVisuals() const
+{
+    if (!TagVisuals.IsValid())
+    {
+        SlotVisuals.Reset();
+        bSlotVisualsValid = false;
+        return SlotVisuals;
+    }
+
+    if (!bSlotVisualsValid || SlotVisualsVersion != TagVisuals->GetVersion())
+    {
+        // Tags deleted since the note was synced get no slot, so they leave no gap
+        SlotVisuals.Reset(Tags.Num());
+        for (const FGuid& TagId : Tags)
+        {
+            if (const FDevNoteTagVisualCache::FVisual* Visual = TagVisuals->Find(TagId))
+            {
+                SlotVisuals.Add(Visual);
+            }
+        }
+        SlotVisualsVersion = TagVisuals->GetVersion();
+        bSlotVisualsValid = true;
+    }
+    return SlotVisuals;
+}
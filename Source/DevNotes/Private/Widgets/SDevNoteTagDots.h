@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DevNoteTagVisualCache.h"
+#include "Widgets/SLeafWidget.h"
+
+/**
+ * A row of coloured dots, one per known tag, painted directly instead of built from a widget per dot.
+ * Tags missing from the cache (deleted since the note was synced) get no dot and leave no gap.
+ * Colours and tooltips are read from the shared tag visual cache, so tag edits show up without regenerating rows.
+ */
+class SDevNoteTagDots : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SDevNoteTagDots)
+        : _DotSize(12.0f)
+        , _DotSpacing(4.0f)
+    {}
+        SLATE_ARGUMENT(TSharedPtr<FDevNoteTagVisualCache>, TagVisuals)
+        SLATE_ARGUMENT(TArray<FGuid>, Tags)
+        SLATE_ARGUMENT(float, DotSize)
+        SLATE_ARGUMENT(float, DotSpacing)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+    virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+    virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+
+protected:
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+    FText GetHoveredToolTip() const;
+
+    // The visual of the Slot-th tag that has one, counting from the left
+    const FDevNoteTagVisualCache::FVisual* FindVisualInSlot(int32 Slot) const;
+    int32 NumSlots() const;
+
+    // Look the tags up again only when the cache was rebuilt, which is also the only time its visuals move
+    const TArray<const FDevNoteTagVisualCache::FVisual*>& GetSlotVisuals() const;
+
+    TSharedPtr<FDevNoteTagVisualCache> TagVisuals;
+    TArray<FGuid> Tags;
+    mutable TArray<const FDevNoteTagVisualCache::FVisual*> SlotVisuals;
+    mutable uint32 SlotVisualsVersion = 0;
+    mutable bool bSlotVisualsValid = false;
+    float DotSize = 12.0f;
+    float DotSpacing = 4.0f;
+    int32 HoveredSlot = INDEX_NONE;
+};
@@ -1,5 +1,6 @@
 ﻿#include "SDevNoteTagPicker.h"
 
+#include "DevNoteChangeSet.h"
 #include "DevNoteSubsystem.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Input/SMenuAnchor.h"
@@ -13,10 +14,10 @@
 #include "Layout/Visibility.h"
 #include "Widgets/Layout/SUniformGridPanel.h"
 #include "Input/Events.h"
+#include "Algo/BinarySearch.h"
 
 void SDevNoteTagPicker::Construct(const FArguments& InArgs)
 {
-    TagsList = InArgs._AvailableTags;
     SelectedTagIds = InArgs._SelectedTagIds;
     OnTagAdded = InArgs._OnTagAdded;
     OnNewTagCreated = InArgs._OnNewTagCreated;
@@ -138,14 +139,24 @@ void SDevNoteTagPicker::OnMenuOpenChanged(bool bIsOpen)
 {
     if (bIsOpen)
     {
-        // Update list and refresh view
-        UnselectedTags = GetUnselectedTags();
-        if (TagListView.IsValid())
+        // Every open starts from the full list, which is only rebuilt if something changed since it was last shown
+        if (SearchBox.IsValid() && !SearchTextLower.IsEmpty())
         {
-            TagListView->RequestListRefresh();
+            SearchBox->SetText(FText::GetEmpty());
+            SearchTextLower.Reset();
+            bVisibleTagsDirty = true;
+        }
+        if (bVisibleTagsDirty)
+        {
+            UpdateVisibleTags();
         }
         OnTagListOpened.ExecuteIfBound();
 
+        if (SearchBox.IsValid() && FSlateApplication::IsInitialized())
+        {
+            FSlateApplication::Get().SetKeyboardFocus(SearchBox, EFocusCause::SetDirectly);
+        }
+
         // Register for mouse button down events to detect outside clicks
         if (FSlateApplication::IsInitialized())
         {
@@ -170,24 +181,65 @@ void SDevNoteTagPicker::OnMenuOpenChanged(bool bIsOpen)
     }
 }
 
-TArray<TSharedPtr<FDevNoteTag>> SDevNoteTagPicker::GetUnselectedTags() const
+void SDevNoteTagPicker::RebuildSortedTags()
 {
-    TArray<TSharedPtr<FDevNoteTag>> Result;
-    
-    if (!TagsList || !SelectedTagIds)
+    SortedTags.Reset();
+    if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
     {
-        return Result;
+        SortedTags.Reserve(Subsystem->GetSharedTags().Num());
+        for (const TSharedPtr<FDevNoteTag>& NoteTag : Subsystem->GetSharedTags())
+        {
+            if (NoteTag.IsValid())
+            {
+                SortedTags.Add({ NoteTag, NoteTag->Name.ToLower() });
+            }
+        }
     }
-    
-    for (const auto& NoteTag : *TagsList)
+
+    SortedTags.Sort([](const FSortedTag& A, const FSortedTag& B)
     {
-        if (NoteTag.IsValid() && !SelectedTagIds->Contains(NoteTag->Id))
+        return A.NameLower.Compare(B.NameLower, ESearchCase::CaseSensitive) < 0;
+    });
+    bSortedTagsDirty = false;
+}
+
+void SDevNoteTagPicker::UpdateVisibleTags()
+{
+    if (bSortedTagsDirty)
+    {
+        RebuildSortedTags();
+    }
+
+    TSet<FGuid> Selected;
+    if (SelectedTagIds)
+    {
+        Selected.Append(*SelectedTagIds);
+    }
+
+    // Names starting with the search text are one contiguous run of the sorted tags
+    const int32 Begin = SearchTextLower.IsEmpty() ? 0 : Algo::LowerBoundBy(SortedTags, SearchTextLower, &FSortedTag::NameLower,
+        [](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+
+    UnselectedTags.Reset();
+    for (int32 i = Begin; i < SortedTags.Num() && SortedTags[i].NameLower.StartsWith(SearchTextLower, ESearchCase::CaseSensitive); ++i)
+    {
+        if (!Selected.Contains(SortedTags[i].Tag->Id))
         {
-            Result.Add(NoteTag);
+            UnselectedTags.Add(SortedTags[i].Tag);
         }
     }
-    
-    return Result;
+    bVisibleTagsDirty = false;
+
+    if (TagListView.IsValid())
+    {
+        TagListView->RequestListRefresh();
+    }
+}
+
+void SDevNoteTagPicker::OnSearchTextChanged(const FText& NewText)
+{
+    SearchTextLower = NewText.ToString().TrimStartAndEnd().ToLower();
+    UpdateVisibleTags();
 }
 
 
@@ -210,17 +262,21 @@ TSharedRef<SWidget> SDevNoteTagPicker::GenerateTagDropdown()
                     .Font(FCoreStyle::GetDefaultFontStyle("Bold", 10))
                 ]
 
-                // Tag List
+                // Search
+                + SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 4)
+                [
+                    SAssignNew(SearchBox, SSearchBox)
+                    .HintText(FText::FromString(TEXT("Search tags")))
+                    .OnTextChanged(this, &SDevNoteTagPicker::OnSearchTextChanged)
+                ]
+
+                // Tag List. The list scrolls itself, so only the visible rows are ever built
                 + SVerticalBox::Slot().AutoHeight().MaxHeight(200)
                 [
-                    SNew(SScrollBox)
-                    + SScrollBox::Slot()
-                    [
-                        SAssignNew(TagListView, SListView<TSharedPtr<FDevNoteTag>>)
-                        .ListItemsSource(&UnselectedTags)
-                        .OnGenerateRow(this, &SDevNoteTagPicker::GenerateTagRow)
-                        .SelectionMode(ESelectionMode::None)
-                    ]
+                    SAssignNew(TagListView, SListView<TSharedPtr<FDevNoteTag>>)
+                    .ListItemsSource(&UnselectedTags)
+                    .OnGenerateRow(this, &SDevNoteTagPicker::GenerateTagRow)
+                    .SelectionMode(ESelectionMode::None)
                 ]
 
                 // Separator
@@ -406,12 +462,29 @@ void SDevNoteTagPicker::OnTagClicked(TSharedPtr<FDevNoteTag> ClickedTag)
 
 void SDevNoteTagPicker::RefreshTagsList()
 {
-    // Update the unselected tags list
-    UnselectedTags = GetUnselectedTags();
-    
-    if (TagListView.IsValid())
+    bVisibleTagsDirty = true;
+    if (TagPickerAnchor.IsValid() && TagPickerAnchor->IsOpen())
     {
-        TagListView->RequestListRefresh();
+        UpdateVisibleTags();
+    }
+}
+
+void SDevNoteTagPicker::ApplyTagChanges(const FDevNoteChangeSet& Changes)
+{
+    // Renames can move tags anywhere in the order
+    bSortedTagsDirty = true;
+    bVisibleTagsDirty = true;
+    if (!TagPickerAnchor.IsValid() || !TagPickerAnchor->IsOpen())
+    {
+        return;
+    }
+
+    UpdateVisibleTags();
+
+    // Renamed or recoloured tags keep their item, so their rows have to be regenerated to show it
+    if (!Changes.Changed.IsEmpty() && TagListView.IsValid())
+    {
+        TagListView->RebuildList();
     }
 }
 
@@ -487,14 +560,8 @@ FReply SDevNoteTagPicker::OnAddNewTagClicked()
     FColor SRGBColor = PendingTagColor.ToFColor(true);
     NewTag.Colour = SRGBColor.ToPackedARGB();
 
-    // Add to tags list
-    if (TagsList)
-    {
-        TagsList->Add(MakeShared<FDevNoteTag>(NewTag));
-        RefreshTagsList();
-    }
+    // Notify parent that new tag was created. It is listed once the server confirmed it and tags were synced
 
-    // Notify parent that new tag was created
     OnNewTagCreated.ExecuteIfBound(NewTag);
     
     // Reset form
@@ -5,23 +5,29 @@
 #include "Widgets/Input/SMenuAnchor.h"
 #include "Widgets/Views/SListView.h"
 #include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Colors/SColorBlock.h"
 #include "Widgets/Colors/SColorPicker.h"
 #include "FDevNoteTag.h"
 
+struct FDevNoteChangeSet;
+
 DECLARE_DELEGATE_OneParam(FOnTagAdded, FGuid);
 DECLARE_DELEGATE_OneParam(FOnNewTagCreated, const FDevNoteTag&);
 DECLARE_DELEGATE(FOnOpened);
 
 
+/**
+ * Menu for adding tags to a note, listing the subsystem's shared tag objects.
+ * Tags are kept sorted by lowercased name so typing in the search box narrows the list to a prefix by binary search.
+ * The list is only rebuilt when tags, the selection or the search changed, never just because the menu opened.
+ */
 class DEVNOTES_API SDevNoteTagPicker : public SCompoundWidget
 {
 public:
     SLATE_BEGIN_ARGS(SDevNoteTagPicker)
-        : _AvailableTags(nullptr)
-        , _SelectedTagIds(nullptr)
+        : _SelectedTagIds(nullptr)
     {}
-        SLATE_ARGUMENT(TArray<TSharedPtr<FDevNoteTag>>*, AvailableTags)
         SLATE_ARGUMENT(TArray<FGuid>*, SelectedTagIds)
         SLATE_EVENT(FOnTagAdded, OnTagAdded)
         SLATE_EVENT(FOnNewTagCreated, OnNewTagCreated)
@@ -31,10 +37,15 @@ public:
     void Construct(const FArguments& InArgs);
     virtual ~SDevNoteTagPicker() override;
     
+    // The selected tags changed, update the list now if it is showing or when it next opens
     void RefreshTagsList();
+
+    // A tag sync added, renamed or removed tags
+    void ApplyTagChanges(const FDevNoteChangeSet& Changes);
     void SetSelectedTagIDs(TArray<FGuid>* TagsArray)
     {
         SelectedTagIds = TagsArray;
+        RefreshTagsList();
     };
 
 private:
@@ -64,14 +75,25 @@ private:
     bool IsNewTagValid() const;
     
     // Helper methods
-    TArray<TSharedPtr<FDevNoteTag>> GetUnselectedTags() const;
+    void RebuildSortedTags();
+    void UpdateVisibleTags();
+    void OnSearchTextChanged(const FText& NewText);
 
     FReply OnTagRowMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent, TSharedPtr<FDevNoteTag> ClickedTag);
     void OnDeleteTagClicked(TSharedPtr<FDevNoteTag> TagToDelete);
 
 private:
     // Data
-    TArray<TSharedPtr<FDevNoteTag>>* TagsList = nullptr;
+    struct FSortedTag
+    {
+        TSharedPtr<FDevNoteTag> Tag;
+        FString NameLower;
+    };
+    TArray<FSortedTag> SortedTags;
+    bool bSortedTagsDirty = true;
+    bool bVisibleTagsDirty = true;
+    FString SearchTextLower;
+
     TArray<FGuid>* SelectedTagIds = nullptr;
     TArray<TSharedPtr<FDevNoteTag>> UnselectedTags;
     FOnTagAdded OnTagAdded;
@@ -81,6 +103,7 @@ private:
     // UI Components
     TSharedPtr<SMenuAnchor> TagPickerAnchor;
     TSharedPtr<SListView<TSharedPtr<FDevNoteTag>>> TagListView;
+    TSharedPtr<SSearchBox> SearchBox;
     TSharedPtr<SEditableTextBox> NewTagNameBox;
     TSharedPtr<SColorBlock> ColorBlockWidget;
     TSharedPtr<SWidget> MenuContentWidget;
@@ -0,0 +1,77 @@
+#include "SDevNoteViewBadges.h"
+
+#include "DevNoteSubsystem.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+
+void SDevNoteViewBadges::Construct(const FArguments& InArgs)
+{
+    OnViewClicked = InArgs._OnViewClicked;
+
+    ChildSlot
+    [
+        SAssignNew(Buttons, SHorizontalBox)
+    ];
+
+    if (UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get())
+    {
+        Subsystem->OnSavedViewsUpdated.AddSP(SharedThis(this), &SDevNoteViewBadges::OnSavedViewsUpdated);
+    }
+    OnSavedViewsUpdated();
+}
+
+void SDevNoteViewBadges::OnSavedViewsUpdated()
+{
+    UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    TArray<FString> Names;
+    for (const FDevNoteSavedView& View : Subsystem->GetSavedViews().GetViews())
+    {
+        if (View.bShowInToolbar)
+        {
+            Names.Add(View.Name);
+        }
+    }
+
+    // Counts are bound to the views, only a different set of buttons needs new widgets
+    if (Names == ShownViews)
+    {
+        return;
+    }
+    ShownViews = MoveTemp(Names);
+
+    Buttons->ClearChildren();
+    for (const FString& Name : ShownViews)
+    {
+        Buttons->AddSlot()
+        .AutoWidth()
+        .Padding(2.0f, 0.0f)
+        [
+            SNew(SButton)
+            .ToolTipText(FText::Format(FText::FromString(TEXT("Open the '{0}' view in Dev Notes")), FText::FromString(Name)))
+            .OnClicked_Lambda([this, Name]()
+            {
+                OnViewClicked.ExecuteIfBound(Name);
+                return FReply::Handled();
+            })
+            [
+                SNew(STextBlock)
+                .Text(this, &SDevNoteViewBadges::GetCountText, Name)
+            ]
+        ];
+    }
+}
+
+FText SDevNoteViewBadges::GetCountText(FString Name) const
+{
+    const UDevNoteSubsystem* Subsystem = UDevNoteSubsystem::Get();
+    const FDevNoteSavedView* View = Subsystem ? Subsystem->GetSavedViews().FindByName(Name) : nullptr;
+    return View
+        ? FText::Format(FText::FromString(TEXT("{0} {1}")), FText::FromString(Name), FText::AsNumber(View->NoteIds.Num()))
+        : FText::FromString(Name);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class SHorizontalBox;
+
+DECLARE_DELEGATE_OneParam(FOnDevNoteViewClicked, const FString&);
+
+/**
+ * Toolbar buttons for the saved views marked Show In Toolbar, each with the view's live note count.
+ * Counts are read from the subsystem's materialized views, so showing them never filters anything.
+ */
+class SDevNoteViewBadges : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SDevNoteViewBadges) {}
+        SLATE_EVENT(FOnDevNoteViewClicked, OnViewClicked)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+private:
+    // Rebuild the buttons if views were added to or removed from the toolbar
+    void OnSavedViewsUpdated();
+    FText GetCountText(FString Name) const;
+
+    TSharedPtr<SHorizontalBox> Buttons;
+    TArray<FString> ShownViews;
+    FOnDevNoteViewClicked OnViewClicked;
+};
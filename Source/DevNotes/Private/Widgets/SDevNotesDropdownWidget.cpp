@@ -54,6 +54,14 @@ void SDevNotesDropdownWidget::NewNote()
 	}
 }
 
+void SDevNotesDropdownWidget::ApplySavedView(const FString& Name)
+{
+	if (Selector.IsValid())
+	{
+		Selector->ApplySavedView(Name);
+	}
+}
+
 void SDevNotesDropdownWidget::Construct(const FArguments& InArgs)
 {
 	if (GEditor)
@@ -62,7 +70,7 @@ void SDevNotesDropdownWidget::Construct(const FArguments& InArgs)
 		if (Subsystem)
 		{
 			// Bind to authentication and note events in subsystem
-			Subsystem->OnNotesUpdated.AddSP(SharedThis(this), &SDevNotesDropdownWidget::OnNotesUpdated);
+			Subsystem->OnNotesChanged.AddSP(SharedThis(this), &SDevNotesDropdownWidget::OnNotesChanged);
 			Subsystem->OnSignedIn.AddSP(SharedThis(this), &SDevNotesDropdownWidget::OnSignedIn);
 			Subsystem->OnSignedOut.AddSP(SharedThis(this), &SDevNotesDropdownWidget::OnSignedOut);
 		}
@@ -232,43 +240,16 @@ void SDevNotesDropdownWidget::OnNoteSelected(TSharedPtr<FDevNote> InNote)
 	SelectedNoteId = (InNote.IsValid()) ? InNote->Id : FGuid();
 }
 
-void SDevNotesDropdownWidget::SetNotesSource(const TArray<TSharedPtr<FDevNote>>& InNotes)
+void SDevNotesDropdownWidget::OnNotesChanged(const FDevNoteChangeSet& Changes)
 {
-	// Pass note source to selector
-	Selector->SetNotesSource(InNotes);
-
-	// Re-select previously selected note if it exists
-	if (SelectedNoteId.IsValid())
-	{
-		TSharedPtr<FDevNote> Found;
-		for (const TSharedPtr<FDevNote>& Note : InNotes)
-		{
-			if (Note.IsValid() && Note->Id == SelectedNoteId)
-			{
-				Found = Note;
-				break;
-			}
-		}
-		SelectedNote = Found;
-	}
-	else
+	// Notes are updated in place, so the selection only needs fixing up when the selected note is gone.
+	// The selector and editor pick up the rest of the changes themselves
+	if (SelectedNoteId.IsValid() && Changes.WasRemoved(SelectedNoteId))
 	{
 		SelectedNote.Reset();
-	}
-	
-	// Propagate note selection to sub-widgets
-	Editor->SetSelectedNote(SelectedNote);
-	Selector->SetSelectedNote(SelectedNote);
-}
-
-void SDevNotesDropdownWidget::OnNotesUpdated()
-{
-	if (GEditor)
-	{
-		if (UDevNoteSubsystem* Subsystem = GEditor->GetEditorSubsystem<UDevNoteSubsystem>())
-		{
-			SetNotesSource(Subsystem->GetNotes());
-		}
+		SelectedNoteId.Invalidate();
+		Editor->SetSelectedNote(SelectedNote);
+		Selector->SetSelectedNote(SelectedNote);
 	}
 }
 
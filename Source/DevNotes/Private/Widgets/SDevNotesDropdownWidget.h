@@ -7,6 +7,7 @@
 
 class SDevNoteSelector;
 class SDevNoteEditor;
+struct FDevNoteChangeSet;
 
 
 DECLARE_DELEGATE_TwoParams(FOnSignInComplete, bool, const FString&);
@@ -19,19 +20,20 @@ public:
 	SLATE_END_ARGS()
 
 	
-	void SetNotesSource(const TArray<TSharedPtr<FDevNote>>& InNotes);
-	void OnNotesUpdated();
+	void OnNotesChanged(const FDevNoteChangeSet& Changes);
 	void Construct(const FArguments& InArgs);
 	void RefreshNotes();
 
 	void OnSignedIn(FString Token);
 	void OnSignedOut();
+
+	// Show the results of a saved view in the note list
+	void ApplySavedView(const FString& Name);
 private:
 	void NewNote();
 
 	TSharedPtr<FDevNote> SelectedNote;
 	FGuid SelectedNoteId;
-	TArray<TSharedPtr<FDevNote>> NotesSource;
 
 	TSharedPtr<SDevNoteEditor> Editor;
 	TSharedPtr<SDevNoteSelector> Selector;
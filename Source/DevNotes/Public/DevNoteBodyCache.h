@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Size-bounded LRU cache of note bodies, used when notes are synced as summaries.
+ * Entries remember the LastEdited time they were fetched for, so a newer edit on the server invalidates them.
+ */
+class DEVNOTES_API FDevNoteBodyCache
+{
+public:
+	explicit FDevNoteBodyCache(int64 InMaxBytes = 8 * 1024 * 1024);
+
+	// Change the byte budget, evicting least recently used bodies if needed
+	void SetMaxBytes(int64 InMaxBytes);
+
+	// Add or replace a body. Bodies larger than the whole budget are not cached
+	void Add(const FGuid& NoteId, const FString& Body, const FDateTime& LastEdited);
+
+	// Look up a body that is at least as new as LastEdited, marking it as recently used
+	bool TryGet(const FGuid& NoteId, const FDateTime& LastEdited, FString& OutBody);
+
+	bool Contains(const FGuid& NoteId) const { return EntryIndices.Contains(NoteId); }
+	void Remove(const FGuid& NoteId);
+	void Empty();
+
+	int64 GetUsedBytes() const { return UsedBytes; }
+	int32 Num() const { return EntryIndices.Num(); }
+
+private:
+	// Entries form a doubly linked list by index, most recently used first, so touching and evicting are O(1)
+	struct FEntry
+	{
+		FGuid NoteId;
+		FString Body;
+		FDateTime LastEdited;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	static int64 GetEntryBytes(const FString& Body) { return Body.GetAllocatedSize(); }
+	void Link(int32 Index);
+	void Unlink(int32 Index);
+	void RemoveAt(int32 Index);
+	void EvictToBudget();
+
+	TSparseArray<FEntry> Entries;
+	TMap<FGuid, int32> EntryIndices;
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+	int64 MaxBytes = 0;
+	int64 UsedBytes = 0;
+};
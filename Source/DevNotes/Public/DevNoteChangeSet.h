@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Ids of the items one sync added, changed or removed. Used for notes and for tags.
+ * Changed items are updated in place, so listeners holding a pointer to one see the new values.
+ */
+struct FDevNoteChangeSet
+{
+	TArray<FGuid> Added;
+	TArray<FGuid> Changed;
+	TArray<FGuid> Removed;
+
+	bool IsEmpty() const { return Added.IsEmpty() && Changed.IsEmpty() && Removed.IsEmpty(); }
+	int32 Num() const { return Added.Num() + Changed.Num() + Removed.Num(); }
+
+	bool WasChanged(const FGuid& Id) const { return Changed.Contains(Id); }
+	bool WasRemoved(const FGuid& Id) const { return Removed.Contains(Id); }
+};
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DevNotesStats.h"
+#include "Containers/RingBuffer.h"
+
+// Groups of server endpoints that latency is reported for
+enum class EDevNoteEndpoint : uint8
+{
+	Notes,
+	NoteBodies,
+	Tags,
+	Users,
+	Query,
+	Mutations,
+	Auth,
+	Num
+};
+
+// Client side sync work timed alongside the requests
+enum class EDevNoteStage : uint8
+{
+	Parse,
+	ApplyCache,
+	RefreshWaypoints,
+	Num
+};
+
+// Time a sync stage for `stat DevNotes`, Insights and the diagnostics tab in one scope. Stage names both the stat and the EDevNoteStage
+#define DEVNOTES_STAGE_SCOPE(Diagnostics, Stage) \
+	DEVNOTES_SCOPE(Stage); \
+	FDevNoteDiagnostics::FScope PREPROCESSOR_JOIN(DevNoteStageScope, __LINE__)(Diagnostics, EDevNoteStage::Stage)
+
+struct FDevNoteRequestRecord
+{
+	EDevNoteEndpoint Endpoint = EDevNoteEndpoint::Notes;
+	FString Verb;
+	FString Route;
+
+	// FPlatformTime::Seconds()
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	int64 BytesSent = 0;
+	int64 BytesReceived = 0;
+
+	// 0 when no response arrived
+	int32 ResponseCode = 0;
+	bool bFailed = false;
+
+	// Repeats a request whose last attempt failed, e.g. the next poll after a failed one
+	bool bRetry = false;
+};
+
+struct FDevNoteStageRecord
+{
+	EDevNoteStage Stage = EDevNoteStage::Parse;
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+};
+
+struct FDevNoteLatencySummary
+{
+	// Upper bounds of the histogram buckets in milliseconds. The last bucket holds everything slower
+	static constexpr double BucketLimitsMs[] = { 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0, 2500.0, 5000.0 };
+	static constexpr int32 NumBuckets = UE_ARRAY_COUNT(BucketLimitsMs) + 1;
+
+	int32 Count = 0;
+	int32 NumFailed = 0;
+	int32 NumRetried = 0;
+
+	double P50Ms = 0.0;
+	double P95Ms = 0.0;
+	double P99Ms = 0.0;
+	double MaxMs = 0.0;
+	int32 Histogram[NumBuckets] = {};
+
+	// Response payloads, or request payloads for mutations
+	int64 P50Bytes = 0;
+	int64 P95Bytes = 0;
+	int64 MaxBytes = 0;
+};
+
+/**
+ * Rolling record of the subsystem's requests and sync stages, kept for the last WindowSeconds.
+ * Feeds the diagnostics tab and can be dumped as a Chrome trace (chrome://tracing, Perfetto) to see a sync end to end.
+ * Game thread only.
+ */
+class DEVNOTES_API FDevNoteDiagnostics
+{
+public:
+	static constexpr double WindowSeconds = 15.0 * 60.0;
+
+	// Times a stage from construction to destruction
+	class FScope
+	{
+	public:
+		FScope(FDevNoteDiagnostics& InDiagnostics, EDevNoteStage InStage);
+		~FScope();
+
+	private:
+		FDevNoteDiagnostics& Diagnostics;
+		EDevNoteStage Stage;
+		double StartTime;
+	};
+
+	// Path and query of a request URL without scheme and server address, e.g. "/notes?summary=true"
+	static FString GetPathAndQuery(const FString& URL);
+
+	// Path of a request URL with Ids replaced by {id}, e.g. "/notes/{id}", so requests to one endpoint share a route
+	static FString GetRequestRoute(const FString& URL);
+
+	static EDevNoteEndpoint ClassifyRequest(const FString& Verb, const FString& Route);
+	static const TCHAR* GetEndpointName(EDevNoteEndpoint Endpoint);
+	static const TCHAR* GetStageName(EDevNoteStage Stage);
+
+	void BeginRequest();
+	void EndRequest(FDevNoteRequestRecord&& Record);
+
+	// Did the last request with this verb and route fail?
+	bool DidLastAttemptFail(const FString& Verb, const FString& Route) const;
+	void AddStage(EDevNoteStage Stage, double StartTime, double EndTime);
+
+	// Requests sent and not yet answered
+	int32 GetRequestsInFlight() const { return RequestsInFlight; }
+	int32 GetPeakRequestsInFlight(double SinceTime) const;
+
+	FDevNoteLatencySummary SummarizeRequests(EDevNoteEndpoint Endpoint, double SinceTime) const;
+
+	// Durations of a stage in the window, in the P50Ms/P95Ms/P99Ms/MaxMs fields
+	FDevNoteLatencySummary SummarizeStage(EDevNoteStage Stage, double SinceTime) const;
+
+	// The same over records gathered elsewhere, e.g. from many subsystems at once
+	static FDevNoteLatencySummary SummarizeRequests(TArrayView<const FDevNoteRequestRecord> Records, EDevNoteEndpoint Endpoint, double SinceTime);
+	static FDevNoteLatencySummary SummarizeStage(TArrayView<const FDevNoteStageRecord> Records, EDevNoteStage Stage, double SinceTime);
+
+	// Everything still in the window, ordered by end time
+	const TRingBuffer<FDevNoteRequestRecord>& GetRequests() const { return Requests; }
+	const TRingBuffer<FDevNoteStageRecord>& GetStages() const { return Stages; }
+
+	// Chrome trace event JSON of everything that finished after SinceTime
+	FString ToChromeTrace(double SinceTime) const;
+
+	// Write the last Minutes of activity to Saved/DevNotes. Returns the file written, or an empty string on failure
+	FString DumpChromeTrace(double Minutes) const;
+
+	void Empty();
+
+private:
+	void TrimToWindow(double Now);
+
+	// Ordered by end time. Expired records leave from the front without moving the rest
+	TRingBuffer<FDevNoteRequestRecord> Requests;
+	TRingBuffer<FDevNoteStageRecord> Stages;
+
+	// Requests in flight after each change, for the queue depth
+	TRingBuffer<TPair<double, int32>> DepthSamples;
+	int32 RequestsInFlight = 0;
+
+	// Verb and route of every request whose last attempt failed. Routes carry no Ids, so this stays as small as the API
+	TSet<FString> FailedRequests;
+};
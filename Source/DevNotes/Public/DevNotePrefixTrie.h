@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Maps lowercased keys to caller defined items, for completing partially typed names.
+ * A key is reachable from the start of each of its words as well as from its first character, so "boss" completes "big boss".
+ * Items can't be removed one by one, the owner empties and refills the trie when its keys change.
+ */
+class DEVNOTES_API FDevNotePrefixTrie
+{
+public:
+	FDevNotePrefixTrie();
+
+	void Add(const FString& KeyLower, int32 Item);
+	void Empty();
+
+	// Collect the items of every key with a word starting with PrefixLower, each once and in no particular order.
+	// An empty prefix matches every key
+	void Find(FStringView PrefixLower, TArray<int32>& OutItems) const;
+
+	int32 NumNodes() const { return Nodes.Num(); }
+
+private:
+	struct FNode
+	{
+		TMap<TCHAR, int32> Children;
+		TArray<int32> Items;
+	};
+
+	void Insert(FStringView Suffix, int32 Item);
+
+	// Node 0 is the root
+	TArray<FNode> Nodes;
+};
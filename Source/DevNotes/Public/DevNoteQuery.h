@@ -0,0 +1,203 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "DevNoteSearchIndex.h"
+#include <atomic>
+
+/**
+ * A selector filter string compiled into a predicate plan.
+ *
+ * Syntax (see README):
+ *  field=value          name, user, map, tag or body. Repeating a field ORs its values
+ *  "quoted values"      may contain spaces
+ *  bare terms           match title, body, map, user or tag name. Bare terms are ORed together
+ *  +tag=value           the note must also carry a tag matching value, each +tag is ANDed
+ *  -tag=value           the note must carry no tag matching value
+ *  created<when         also created>, edited< and edited>. When is a local date (2024-05-01) or an age such as
+ *                       30m, 12h, 2d or 3w, so edited<2d reads "edited less than two days ago". Bounds on one field narrow each other
+ * Different fields, and the bare terms as a group, are ANDed.
+ *
+ * Time terms take their candidates from the entries' time order by binary search, so only notes in range are tested.
+ * Tag terms become bitsets over the entries' interned tags, so tag filters are a few word-wide ANDs per note.
+ * Tag and user terms are resolved against the search index when compiling, so evaluation only checks Id sets.
+ * Body and free text terms are looked up by word prefix in the text index, which also gives each note a relevance score.
+ * A name, map, tag, user or free text term that no known word contains is treated as a misspelling and also matches
+ * similarly spelled words from the index vocabulary. Such fuzzy matches rank below exact ones.
+ */
+class DEVNOTES_API FDevNoteQuery
+{
+public:
+	// Compile with the fuzzy match threshold from the plugin settings
+	static FDevNoteQuery Compile(const FString& QueryString, const FDevNoteSearchIndex& Index);
+
+	// Compile with an explicit fuzzy match threshold, 0 disables fuzzy matching
+	static FDevNoteQuery Compile(const FString& QueryString, const FDevNoteSearchIndex& Index, float FuzzyThreshold);
+
+	// Split a query on whitespace, keeping quoted sections together
+	static void Tokenize(const FString& InStr, TArray<FString>& OutTokens);
+
+	// One side of a created or edited range, in UTC ticks
+	struct FTimeBound
+	{
+		EDevNoteTimeField Field = EDevNoteTimeField::Created;
+
+		// Upper bounds exclude Ticks, lower bounds include it
+		bool bUpper = false;
+		int64 Ticks = 0;
+	};
+
+	/**
+	 * Parse a time comparison such as edited<2d or created>2024-05-01. Returns false if Token isn't one.
+	 * OutBound stays unset while the value is still being typed.
+	 */
+	static bool ParseTimeBound(const FString& Token, const FDateTime& UtcNow, TOptional<FTimeBound>& OutBound);
+
+	// Does this query let every note through?
+	bool IsEmpty() const;
+
+	// Test a single entry. Evaluate prepares the per level, user and tag lookups once for a whole pass instead
+	bool Matches(const FDevNoteSearchEntries& Entries, int32 EntryIndex) const;
+
+	/**
+	 * Collect the indices of matching entries, in entry order. Large inputs are split into chunks evaluated in parallel.
+	 * When Candidates is given only those entry indices are tested, e.g. the previous results of a narrower query.
+	 * Returns false, leaving OutMatches untouched, if bCancelled was raised while evaluating.
+	 */
+	bool Evaluate(const FDevNoteSearchEntries& Entries, const TArray<int32>* Candidates, TArray<int32>& OutMatches,
+		const std::atomic<bool>* bCancelled = nullptr) const;
+
+	// Order entry indices by relevance, best first, keeping the existing order between equal scores
+	void SortByScore(const FDevNoteSearchEntries& Entries, TArray<int32>& InOutMatches) const;
+
+	// Can this query only match a subset of what Previous matched, so its results can be refined instead of rescanned?
+	// Compares the compiled clauses, so both queries must have been compiled against the same index
+	bool IsNarrowingOf(const FDevNoteQuery& Previous) const;
+
+	// Does the query carry text terms or fuzzy matches that results should be ordered by?
+	bool IsRanked() const { return BodyClause.bActive || GenericClause.bActive || bFuzzy; }
+
+	// Does the query search note bodies, through body= or bare terms?
+	bool ReadsBody() const { return BodyClause.bActive || GenericClause.bActive; }
+
+	// Were any misspelled terms expanded to similar words?
+	bool IsFuzzy() const { return bFuzzy; }
+
+	// Does the query compare creation or edit times? Relative ones like edited<7d match differently as time passes
+	bool HasTimeClause() const { return CreatedClause.bActive || EditedClause.bActive; }
+
+	// Relevance of a matching entry for ranked queries, higher is better
+	float GetScore(const FDevNoteSearchEntries& Entries, int32 EntryIndex) const;
+
+	const FString& GetSourceString() const { return SourceString; }
+
+private:
+	static constexpr int32 EvaluateChunkSize = 4096;
+
+	// Substring terms ORed together. Empty when the field wasn't used
+	struct FTextClause
+	{
+		TArray<FString> Terms;
+
+		// Corrections of misspelled terms, matched as substrings too
+		TArray<FDevNoteTrigramIndex::FMatch> FuzzyTerms;
+		bool bActive = false;
+
+		bool Matches(FStringView Lower) const;
+
+		// 1 for an exact term match, the similarity of the best correction for a fuzzy one, 0 for no match
+		float Relevance(FStringView Lower) const;
+
+		// Does every term contain one of Previous' terms? Ignores corrections
+		bool IsNarrowingOf(const FTextClause& Previous) const;
+	};
+
+	// Terms already resolved to the Ids whose names match, with 1 for exact and the similarity for fuzzy matches
+	struct FIdClause
+	{
+		TMap<FGuid, float> Ids;
+		bool bActive = false;
+
+		bool IsNarrowingOf(const FIdClause& Previous) const;
+	};
+
+	FString SourceString;
+
+	FTextClause NameClause;
+	FTextClause MapClause;
+	FIdClause UserClause;
+	FIdClause TagClause;
+
+	// One clause per +tag value, all of which must match, and the tags -tag values exclude
+	TArray<FIdClause> RequiredTagClauses;
+	FIdClause ExcludedTagClause;
+
+	// Notes found in the text index, with their relevance
+	struct FScoreClause
+	{
+		TMap<FGuid, float> Scores;
+		bool bActive = false;
+
+		bool IsNarrowingOf(const FScoreClause& Previous) const;
+	};
+	FScoreClause BodyClause;
+
+	// A half-open range of UTC ticks. Inactive until a value parses
+	struct FTimeClause
+	{
+		int64 MinTicks = MIN_int64;
+		int64 MaxTicks = MAX_int64;
+		bool bActive = false;
+
+		bool Contains(int64 Ticks) const { return Ticks >= MinTicks && Ticks < MaxTicks; }
+
+		bool IsNarrowingOf(const FTimeClause& Previous) const
+		{
+			return !Previous.bActive || (bActive && MinTicks >= Previous.MinTicks && MaxTicks <= Previous.MaxTicks);
+		}
+	};
+	FTimeClause CreatedClause;
+	FTimeClause EditedClause;
+
+	// Apply a created or edited comparison to Query. Returns false if Token isn't one
+	static bool ParseTimeTerm(const FString& Token, const FDateTime& UtcNow, FDevNoteQuery& Query);
+
+	// Entry indices inside the active time ranges, in entry order. Returns false if no time clause is active
+	bool FindTimeCandidates(const FDevNoteSearchEntries& Entries, TArray<int32>& OutCandidates) const;
+
+	FTextClause GenericClause;
+	TMap<FGuid, float> GenericUserIds;
+	TMap<FGuid, float> GenericTagIds;
+	TMap<FGuid, float> GenericTextScores;
+
+	bool bFuzzy = false;
+
+	// Clause relevance per interned level, user and tag of one FDevNoteSearchEntries, 0 where the clause doesn't match.
+	// Rows then only index these small tables instead of searching strings or hashing Guids
+	struct FBoundQuery
+	{
+		TArray<float> MapRelevance;
+		TArray<float> GenericLevelRelevance;
+		TArray<float> UserRelevance;
+		TArray<float> GenericUserRelevance;
+		TArray<float> TagRelevance;
+		TArray<float> GenericTagRelevance;
+
+		// Bitsets over interned tag indices, as wide as the entries' tag bits
+		TArray<uint64> TagMask;
+		TArray<uint64> GenericTagMask;
+		TArray<uint64> ExcludedTagMask;
+		TArray<TArray<uint64>> RequiredTagMasks;
+	};
+
+	FBoundQuery Bind(const FDevNoteSearchEntries& Entries) const;
+	bool Matches(const FDevNoteSearchEntries& Entries, const FBoundQuery& Bound, int32 EntryIndex) const;
+	float GetScore(const FDevNoteSearchEntries& Entries, const FBoundQuery& Bound, int32 EntryIndex) const;
+
+	// Best relevance of the note's tags, 0 if none matches
+	static float BestTagIn(TArrayView<const uint16> NoteTags, const TArray<float>& TagRelevance);
+
+	static TArray<uint64> MakeTagMask(const FDevNoteSearchEntries& Entries, const TMap<FGuid, float>& TagIds);
+
+	// Does the note carry any tag in Mask?
+	static bool HasAnyTag(TArrayView<const uint64> NoteTags, const TArray<uint64>& Mask);
+};
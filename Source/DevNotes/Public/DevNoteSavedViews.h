@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FDevNoteQuery;
+class FDevNoteSearchIndex;
+struct FDevNoteChangeSet;
+
+struct FDevNoteSavedView
+{
+	FString Name;
+	FString QueryString;
+	bool bShowInToolbar = false;
+
+	// The notes the view currently matches
+	TSet<FGuid> NoteIds;
+};
+
+/**
+ * The results of the user's saved filters, materialized once and then patched with every sync's changes.
+ * Only added and changed notes are tested again, so keeping a view current costs what the sync touched, not a full scan.
+ * Name resolution depends on tags and users, so their syncs re-evaluate every view.
+ * Views with a time clause also need RefreshTimedViews now and then, as relative times move on without any sync.
+ */
+class DEVNOTES_API FDevNoteSavedViews
+{
+public:
+	// Replace the views, evaluating each over every note once
+	void SetViews(TArray<FDevNoteSavedView>&& InViews, const FDevNoteSearchIndex& Index);
+
+	// Re-evaluate every view, e.g. after tags or users changed what names resolve to
+	void Rebuild(const FDevNoteSearchIndex& Index);
+
+	// Patch the results with a note sync. The index must already hold the changes
+	void ApplyNoteChanges(const FDevNoteSearchIndex& Index, const FDevNoteChangeSet& Changes);
+
+	// Re-evaluate only the views that compare creation or edit times. Returns true if there were any
+	bool RefreshTimedViews(const FDevNoteSearchIndex& Index);
+
+	const TArray<FDevNoteSavedView>& GetViews() const { return Views; }
+	const FDevNoteSavedView* FindByName(const FString& Name) const;
+
+	// Views are matched by their exact query string, so typing a saved filter by hand also gets its results for free
+	const FDevNoteSavedView* FindByQuery(const FString& QueryString) const;
+
+	// Do the results reflect the index as it is now?
+	bool IsCurrent(const FDevNoteSearchIndex& Index) const;
+
+private:
+	void Evaluate(const FDevNoteSearchIndex& Index, const FDevNoteQuery& Query, FDevNoteSavedView& View) const;
+
+	TArray<FDevNoteSavedView> Views;
+	uint32 IndexVersion = 0;
+};
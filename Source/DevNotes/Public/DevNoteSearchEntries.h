@@ -0,0 +1,247 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FDevNote.h"
+
+/**
+ * Per-note fields prepared once at ingest so filtering never has to re-derive them.
+ * Only used to fill rows of FDevNoteSearchEntries, which stores them column by column.
+ */
+struct FDevNoteSearchEntry
+{
+	TSharedPtr<FDevNote> Note;
+
+	FGuid Id;
+	FGuid CreatedById;
+	TArray<FGuid> Tags;
+	FString TitleLower;
+	FString LevelLower;
+	FString AuthorName;
+	FString LevelName;
+	FDateTime CreatedAt;
+	FDateTime LastEdited;
+	FVector WorldPosition = FVector::ZeroVector;
+
+	static FDevNoteSearchEntry Make(const TSharedPtr<FDevNote>& InNote);
+};
+
+/**
+ * Variable length values of many rows packed into one array.
+ * A row that shrinks is overwritten in place. One that grows or is removed leaves a hole, reclaimed once holes make up half the pool.
+ */
+template <typename ElementType>
+class TDevNotePooledColumn
+{
+	static_assert(TIsPODType<ElementType>::Value, "Pooled values are moved with memcpy");
+
+public:
+	TArrayView<const ElementType> Get(int32 Row) const
+	{
+		return TArrayView<const ElementType>(Pool.GetData() + Starts[Row], Counts[Row]);
+	}
+
+	int32 GetCount(int32 Row) const { return Counts[Row]; }
+
+	void Add(TArrayView<const ElementType> Values)
+	{
+		Starts.Add(Pool.Num());
+		Counts.Add(Values.Num());
+		Pool.Append(Values.GetData(), Values.Num());
+	}
+
+	void Set(int32 Row, TArrayView<const ElementType> Values)
+	{
+		if (Values.Num() <= Counts[Row])
+		{
+			FMemory::Memcpy(Pool.GetData() + Starts[Row], Values.GetData(), Values.Num() * sizeof(ElementType));
+			Garbage += Counts[Row] - Values.Num();
+		}
+		else
+		{
+			Garbage += Counts[Row];
+			Starts[Row] = Pool.Num();
+			Pool.Append(Values.GetData(), Values.Num());
+		}
+		Counts[Row] = Values.Num();
+		CompactIfWasteful();
+	}
+
+	// The last row takes Row's place
+	void RemoveAtSwap(int32 Row)
+	{
+		Garbage += Counts[Row];
+		Starts.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+		Counts.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+		CompactIfWasteful();
+	}
+
+	void Reserve(int32 NumRows, int32 NumElements)
+	{
+		Starts.Reserve(NumRows);
+		Counts.Reserve(NumRows);
+		Pool.Reserve(NumElements);
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Pool.GetAllocatedSize() + Starts.GetAllocatedSize() + Counts.GetAllocatedSize();
+	}
+
+private:
+	static constexpr int32 MinGarbageToCompact = 4096;
+
+	void CompactIfWasteful()
+	{
+		if (Garbage < MinGarbageToCompact || Garbage * 2 < Pool.Num())
+		{
+			return;
+		}
+
+		TArray<ElementType> Packed;
+		Packed.Reserve(Pool.Num() - Garbage);
+		for (int32 Row = 0; Row < Starts.Num(); ++Row)
+		{
+			const int32 Start = Packed.Num();
+			Packed.Append(Pool.GetData() + Starts[Row], Counts[Row]);
+			Starts[Row] = Start;
+		}
+		Pool = MoveTemp(Packed);
+		Garbage = 0;
+	}
+
+	TArray<ElementType> Pool;
+	TArray<int32> Starts;
+	TArray<int32> Counts;
+	int32 Garbage = 0;
+};
+
+enum class EDevNoteTimeField : uint8
+{
+	Created,
+	LastEdited,
+};
+
+/**
+ * The search entries of every note, stored as one array per field so filter and sort passes scan contiguous memory.
+ * Level paths, authors and tags are interned: rows hold small indices into tables of the distinct values,
+ * so a clause can be evaluated once per level, user or tag and then looked up per row.
+ * Interned tables only grow. Values no row refers to any more stay until the index rebuilds its entries.
+ * Rows are also kept ordered by created and last edited time, so time ranges are found by binary search.
+ */
+class DEVNOTES_API FDevNoteSearchEntries
+{
+public:
+	int32 Num() const { return Ids.Num(); }
+	bool IsValidIndex(int32 Row) const { return Ids.IsValidIndex(Row); }
+	void Reserve(int32 NumRows);
+
+	// Returns the index of the new row
+	int32 Add(const FDevNoteSearchEntry& Entry);
+
+	// Add many rows, ordering them by time once at the end rather than row by row
+	void Append(TArrayView<const FDevNoteSearchEntry> NewEntries);
+	void Set(int32 Row, const FDevNoteSearchEntry& Entry);
+
+	// The last row takes Row's place, so only that one row changes index
+	void RemoveAtSwap(int32 Row);
+
+	// Refresh the display name of every interned author. Authors missing from Names get an empty one
+	void SetUserNames(const TMap<FGuid, FString>& Names);
+
+	// Only used to hand results back to the UI, filters never read through it
+	const TSharedPtr<FDevNote>& GetNote(int32 Row) const { return Notes[Row]; }
+
+	const FGuid& GetId(int32 Row) const { return Ids[Row]; }
+	FStringView GetTitleLower(int32 Row) const
+	{
+		const TArrayView<const TCHAR> Chars = TitlesLower.Get(Row);
+		return FStringView(Chars.GetData(), Chars.Num());
+	}
+	int64 GetCreatedTicks(int32 Row) const { return CreatedTicks[Row]; }
+	int64 GetLastEditedTicks(int32 Row) const { return LastEditedTicks[Row]; }
+	FVector GetWorldPosition(int32 Row) const { return FVector(WorldPositions[Row]); }
+
+	int32 GetLevelIndex(int32 Row) const { return LevelIndices[Row]; }
+	const FString& GetLevelLower(int32 Row) const { return LevelsLower[LevelIndices[Row]]; }
+	const FString& GetLevelName(int32 Row) const { return LevelNames[LevelIndices[Row]]; }
+
+	int32 GetAuthorIndex(int32 Row) const { return AuthorIndices[Row]; }
+	const FGuid& GetAuthorId(int32 Row) const { return UserIds[AuthorIndices[Row]]; }
+	const FString& GetAuthorName(int32 Row) const { return UserNames[AuthorIndices[Row]]; }
+
+	TArrayView<const uint16> GetTagIndices(int32 Row) const { return TagIndices.Get(Row); }
+	int32 GetTagCount(int32 Row) const { return TagIndices.GetCount(Row); }
+
+	// The row's tags as a bitset over interned tag indices, GetTagWordsPerRow() words long
+	TArrayView<const uint64> GetTagBits(int32 Row) const
+	{
+		return TArrayView<const uint64>(TagBits.GetData() + Row * TagWordsPerRow, TagWordsPerRow);
+	}
+	int32 GetTagWordsPerRow() const { return TagWordsPerRow; }
+
+	// Rows whose time lies in [MinTicks, MaxTicks), oldest first. A view into the time order, valid until the next change
+	TArrayView<const int32> GetRowsInTimeRange(EDevNoteTimeField Field, int64 MinTicks, int64 MaxTicks) const;
+
+	// Interned values, addressed by the indices rows hold
+	int32 NumLevels() const { return LevelsLower.Num(); }
+	const FString& GetInternedLevelLower(int32 LevelIndex) const { return LevelsLower[LevelIndex]; }
+	const FString& GetInternedLevelName(int32 LevelIndex) const { return LevelNames[LevelIndex]; }
+
+	int32 NumUsers() const { return UserIds.Num(); }
+	const FGuid& GetInternedUserId(int32 UserIndex) const { return UserIds[UserIndex]; }
+	const FString& GetInternedUserName(int32 UserIndex) const { return UserNames[UserIndex]; }
+
+	int32 NumTags() const { return TagIds.Num(); }
+	const FGuid& GetInternedTagId(int32 TagIndex) const { return TagIds[TagIndex]; }
+
+	// Heap memory held by the columns and interned tables, not counting the notes themselves
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 InternLevel(const FDevNoteSearchEntry& Entry);
+	int32 InternUser(const FGuid& UserId, const FString& Name);
+	int32 AddRow(const FDevNoteSearchEntry& Entry);
+	void InsertTimeOrder(int32 Row);
+	void RemoveTimeOrder(int32 Row);
+
+	// Position of Row in Order, found by binary search on its time
+	static int32 FindInTimeOrder(const TArray<int32>& Order, const TArray<int64>& Ticks, int32 Row);
+
+	void InternTags(const TArray<FGuid>& Tags, TArray<uint16, TInlineAllocator<16>>& OutIndices);
+	void SetTagBits(int32 Row, TArrayView<const uint16> Tags);
+
+	// Re-lay every row's bitset when a newly interned tag doesn't fit in the current width
+	void WidenTagBits(int32 NewWordsPerRow);
+
+	// One element per row
+	TArray<TSharedPtr<FDevNote>> Notes;
+	TArray<FGuid> Ids;
+	TDevNotePooledColumn<TCHAR> TitlesLower;
+	TArray<int32> LevelIndices;
+	TArray<int32> AuthorIndices;
+	TDevNotePooledColumn<uint16> TagIndices;
+	TArray<uint64> TagBits;
+	int32 TagWordsPerRow = 0;
+	TArray<int64> CreatedTicks;
+	TArray<int64> LastEditedTicks;
+
+	// Row indices sorted by time, ties in no particular order
+	TArray<int32> RowsByCreated;
+	TArray<int32> RowsByLastEdited;
+
+	// Single precision is plenty for ordering by distance from the camera
+	TArray<FVector3f> WorldPositions;
+
+	TArray<FString> LevelsLower;
+	TArray<FString> LevelNames;
+	TMap<FString, int32> LevelIndexByPath;
+
+	TArray<FGuid> UserIds;
+	TArray<FString> UserNames;
+	TMap<FGuid, int32> UserIndexById;
+
+	TArray<FGuid> TagIds;
+	TMap<FGuid, int32> TagIndexById;
+};
+
+using FDevNoteSearchEntriesRef = TSharedRef<const FDevNoteSearchEntries, ESPMode::ThreadSafe>;
@@ -0,0 +1,109 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "DevNotePrefixTrie.h"
+#include "DevNoteSearchEntries.h"
+#include "DevNoteTextIndex.h"
+#include "DevNoteTrigramIndex.h"
+#include "FDevNote.h"
+
+struct FDevNoteTag;
+struct FDevNoteUser;
+
+enum class EDevNoteSuggestionField : uint8
+{
+	Tag,
+	User,
+	Level,
+};
+
+// A completion for a partially typed filter value
+struct FDevNoteSuggestion
+{
+	EDevNoteSuggestionField Field = EDevNoteSuggestionField::Tag;
+
+	// What to put after the field's '=', as the user would type it
+	FString Value;
+
+	// How many notes the completed filter would match on its own
+	int32 NoteCount = 0;
+};
+
+/**
+ * Lookup structures for filtering notes, maintained by the subsystem as notes, tags and users are synced.
+ * Everything string-like is stored lowercased so queries can use case sensitive comparisons.
+ */
+class DEVNOTES_API FDevNoteSearchIndex
+{
+public:
+	FDevNoteSearchIndex();
+
+	void RebuildNotes(const TArray<TSharedPtr<FDevNote>>& Notes);
+
+	// Add or refresh a single note, e.g. one created locally or one whose body just arrived
+	void UpdateNote(const TSharedPtr<FDevNote>& Note);
+
+	// Drop a note. The last entry takes its place, so only that one entry changes index
+	void RemoveNote(const FGuid& NoteId);
+	void SetTags(const TArray<FDevNoteTag>& Tags);
+
+	// Does nothing, not even bump the version, when every user already has the same name
+	void SetUsers(const TArray<FDevNoteUser>& Users);
+	void Empty();
+
+	int32 FindEntryIndex(const FGuid& NoteId) const;
+	const FDevNoteSearchEntries& GetEntries() const { return *Entries; }
+
+	// The current entries as an immutable array that stays valid for a worker thread after the index changes
+	FDevNoteSearchEntriesRef GetEntriesSnapshot() const { return Entries; }
+
+	const TMap<FGuid, FString>& GetTagNamesLower() const { return TagNamesLower; }
+	const TMap<FGuid, FString>& GetUserNamesLower() const { return UserNamesLower; }
+	const FDevNoteTextIndex& GetTextIndex() const { return TextIndex; }
+
+	// Words of titles, tag names, user names and level paths, for correcting misspelled terms
+	const FDevNoteTrigramIndex& GetVocabulary() const { return Vocabulary; }
+
+	// Entry indices per level (lowercased path) and per tag, maintained as notes sync so grouped views never scan every note.
+	// Notes without tags are listed under an invalid Guid. Indices within a group are in no particular order
+	const TMap<FString, TArray<int32>>& GetEntriesByLevel() const { return EntriesByLevel; }
+	const TMap<FGuid, TArray<int32>>& GetEntriesByTag() const { return EntriesByTag; }
+
+	// Tags, users or levels with a word starting with PrefixLower, most used first, skipping ones no note refers to
+	void Suggest(EDevNoteSuggestionField Field, FStringView PrefixLower, int32 MaxSuggestions, TArray<FDevNoteSuggestion>& OutSuggestions) const;
+
+	// Bumped on every change, so compiled queries know when their resolved Id sets are stale
+	uint32 GetVersion() const { return Version; }
+
+private:
+	FDevNoteSearchEntry MakeEntry(const TSharedPtr<FDevNote>& Note) const;
+	void AddEntryWords(const FDevNoteSearchEntries& InEntries, int32 EntryIndex);
+	void RemoveEntryWords(const FDevNoteSearchEntries& InEntries, int32 EntryIndex);
+	void AddToGroups(int32 EntryIndex);
+	void RemoveFromGroups(int32 EntryIndex);
+
+	// Add levels interned since the last call to the level trie
+	void SyncLevelTrie();
+
+	// Copy-on-write: a snapshot handed out to a filter task is never modified in place
+	TSharedRef<FDevNoteSearchEntries, ESPMode::ThreadSafe> Entries;
+	TMap<FGuid, int32> EntryIndexById;
+	TMap<FGuid, FString> TagNamesLower;
+	TMap<FGuid, FString> UserNamesLower;
+	TMap<FGuid, FString> UserNames;
+	FDevNoteTextIndex TextIndex;
+	FDevNoteTrigramIndex Vocabulary;
+	TMap<FString, TArray<int32>> EntriesByLevel;
+	TMap<FGuid, TArray<int32>> EntriesByTag;
+	TMap<FGuid, int32> NoteCountByUser;
+
+	// Completion tries. Tag and user items index the arrays below, level items are interned level indices of Entries
+	FDevNotePrefixTrie TagTrie;
+	FDevNotePrefixTrie UserTrie;
+	FDevNotePrefixTrie LevelTrie;
+	TArray<TPair<FGuid, FString>> TagTrieItems;
+	TArray<TPair<FGuid, FString>> UserTrieItems;
+	int32 NumLevelsInTrie = 0;
+
+	uint32 Version = 0;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FDevNote.h"
+
+class FJsonObject;
+
+/**
+ * A selector filter translated into the structured query the server's POST /notes/query endpoint takes.
+ * The server answers with the matching notes as a JSON array, in the same format as GET /notes (summaries when "summary" is set).
+ *
+ * Contract, all string comparisons case insensitive:
+ *  clauses   every clause must hold (AND). A clause names a field and how its values combine:
+ *            "any" at least one value matches (field=a field=b), "all" every value matches one of the note's tags (+tag=),
+ *            "none" no value matches any of the note's tags (-tag=)
+ *  fields    name and map match the title and level path by substring, body matches body words by prefix,
+ *            user and tag match the author's and the tags' names by substring
+ *  terms     bare terms, of which at least one must match the title, body, level path, author name or a tag name (OR)
+ *  created, edited   {"from", "to"} ISO 8601 UTC times, from inclusive and to exclusive, either may be left out
+ * Fuzzy matching and relevance ordering are client side only, the server returns exact matches in any order.
+ */
+struct DEVNOTES_API FDevNoteServerQuery
+{
+	enum class EMatch : uint8
+	{
+		Any,
+		All,
+		None,
+	};
+
+	struct FClause
+	{
+		FString Field;
+		EMatch Match = EMatch::Any;
+
+		// Lowercased
+		TArray<FString> Values;
+	};
+
+	// A half-open range of UTC ticks
+	struct FRange
+	{
+		int64 MinTicks = MIN_int64;
+		int64 MaxTicks = MAX_int64;
+
+		bool IsSet() const { return MinTicks != MIN_int64 || MaxTicks != MAX_int64; }
+		bool Contains(int64 Ticks) const { return Ticks >= MinTicks && Ticks < MaxTicks; }
+	};
+
+	TArray<FClause> Clauses;
+	TArray<FString> Terms;
+	FRange Created;
+	FRange Edited;
+
+	// Ask for notes without their bodies
+	bool bSummary = true;
+
+	// Does the query let every note through?
+	bool IsEmpty() const;
+
+	// Do any of the clauses or terms look at note bodies?
+	bool ReadsBody() const;
+
+	/**
+	 * Translate a selector filter string, with the same syntax and AND/OR rules as FDevNoteQuery.
+	 * Values still being typed (an empty value, an unparsed time) are left out rather than matching nothing.
+	 */
+	static FDevNoteServerQuery Translate(const FString& QueryString, const FDateTime& UtcNow);
+
+	TSharedRef<FJsonObject> ToJson() const;
+	FString ToJsonString() const;
+	static bool FromJson(const TSharedPtr<FJsonObject>& Json, FDevNoteServerQuery& OutQuery);
+
+	/**
+	 * Reference evaluation of the contract, as the local stand-in server runs it.
+	 * Tag and user names are looked up by Id and must be lowercased
+	 */
+	bool Matches(const FDevNote& Note, const TMap<FGuid, FString>& TagNamesLower, const TMap<FGuid, FString>& UserNamesLower) const;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FDevNote.h"
+#include "FDevNoteTag.h"
+#include "FDevNoteUser.h"
+
+struct FDevNoteChangeSet;
+
+/**
+ * An immutable copy of the synced notes, tags and users, safe to read from any thread.
+ * The subsystem publishes a new one whenever its caches change. Readers keep the one they hold for as long as they need it,
+ * and it is freed once the last of them lets go.
+ */
+struct DEVNOTES_API FDevNoteSnapshot
+{
+	using FNoteRef = TSharedRef<const FDevNote, ESPMode::ThreadSafe>;
+
+	// The notes whose Id hashes to one bucket. Snapshots share the buckets no change touched
+	struct FBucket
+	{
+		TArray<FNoteRef> Notes;
+		TMap<FGuid, int32> NoteIndexById;
+	};
+	using FBucketRef = TSharedRef<const FBucket, ESPMode::ThreadSafe>;
+
+	// Enough that a single edit copies a few hundred notes even at 100k
+	static constexpr int32 NumBuckets = 256;
+
+	// Increases with every published snapshot
+	uint32 Version = 0;
+
+	// Empty until the first notes are published, NumBuckets long after
+	TArray<FBucketRef> Buckets;
+	TArray<FDevNoteTag> Tags;
+	TArray<FDevNoteUser> Users;
+
+	int32 NumNotes() const { return NumNoteRefs; }
+	const FDevNote* FindNote(const FGuid& NoteId) const;
+
+	// Visit every note, in no particular order
+	template <typename FunctorType>
+	void ForEachNote(FunctorType&& Functor) const
+	{
+		for (const FBucketRef& Bucket : Buckets)
+		{
+			for (const FNoteRef& Note : Bucket->Notes)
+			{
+				Functor(*Note);
+			}
+		}
+	}
+
+	/**
+	 * Build the snapshot following Previous by applying NoteChanges, with the changed notes copied from CachedNotesById.
+	 * Only the buckets of changed notes are copied, the rest and every unchanged note are shared with Previous.
+	 * Null tags or users are kept from Previous.
+	 */
+	static TSharedRef<const FDevNoteSnapshot, ESPMode::ThreadSafe> MakeNext(const FDevNoteSnapshot& Previous,
+		const TMap<FGuid, TSharedPtr<FDevNote>>& CachedNotesById, const FDevNoteChangeSet& NoteChanges,
+		const TArray<FDevNoteTag>* CachedTags, const TArray<FDevNoteUser>* CachedUsers);
+
+private:
+	static int32 GetBucketIndex(const FGuid& NoteId) { return GetTypeHash(NoteId) % NumBuckets; }
+
+	int32 NumNoteRefs = 0;
+};
+
+using FDevNoteSnapshotRef = TSharedRef<const FDevNoteSnapshot, ESPMode::ThreadSafe>;
@@ -3,8 +3,16 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "DevNoteBodyCache.h"
+#include "DevNoteChangeSet.h"
+#include "DevNoteDiagnostics.h"
+#include "DevNoteSavedViews.h"
+#include "DevNoteSearchIndex.h"
+#include "DevNoteSnapshot.h"
+#include "DevNoteTrafficCapture.h"
 #include "FDevNote.h"
 #include "FDevNoteUser.h"
+#include "HAL/CriticalSection.h"
 #include "HttpFwd.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "DevNoteSubsystem.generated.h"
@@ -14,11 +22,16 @@
  */
 
 struct FDevNoteTag;
+struct FDevNoteServerQuery;
 class ADevNoteActor;
-DECLARE_MULTICAST_DELEGATE(FOnNotesUpdated);
-DECLARE_MULTICAST_DELEGATE(FOnTagsUpdated);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnNotesChanged, const FDevNoteChangeSet&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTagsChanged, const FDevNoteChangeSet&);
+DECLARE_MULTICAST_DELEGATE(FOnUsersUpdated);
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnSignedIn, FString);
 DECLARE_MULTICAST_DELEGATE(FOnSignedOut);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnNoteBodyLoaded, const FGuid&, const FString&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnNoteUpdateFailed, const FGuid&);
+DECLARE_MULTICAST_DELEGATE(FOnSavedViewsUpdated);
 
 UCLASS()
 class DEVNOTES_API UDevNoteSubsystem : public UEditorSubsystem 
@@ -27,6 +40,9 @@ class DEVNOTES_API UDevNoteSubsystem : public UEditorSubsystem
 
 public:
 	static UDevNoteSubsystem* Get();
+
+	// Location of the active perspective level viewport camera, or the origin if there is none
+	static FVector GetEditorCameraLocation();
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 
 	const TArray<TSharedPtr<FDevNote>>& GetNotes() const { return CachedNotes; }
@@ -41,11 +57,30 @@ public:
 	// Fetches all tags from the server
 	void RequestTagsFromServer();
 
+	// Is the project configured to sync note headers only, fetching bodies on demand?
+	bool IsSummarySyncEnabled() const;
+
+	// Fetches the body of a note received from a summary sync. Served from the body cache when possible
+	void RequestNoteBody(const FGuid& NoteId, TFunction<void(bool bSuccess)> Completion = nullptr);
+
+	// Fetches the bodies of notes that are likely to be opened soon (e.g. rows next to the selection)
+	void PrefetchNoteBodies(const TArray<FGuid>& NoteIds);
+
+	// Should the selector send its filters to the server instead of evaluating them locally?
+	bool IsServerFilteringEnabled() const;
+
+	/**
+	 * Ask the server's /notes/query endpoint for the notes matching Query. Completion gets their Ids, or bSuccess false
+	 * if the server couldn't be reached or doesn't support queries, in which case callers filter locally.
+	 * Matching notes the cache doesn't have yet are added to it, none are removed.
+	 */
+	void QueryNotesOnServer(const FDevNoteServerQuery& Query, TFunction<void(bool bSuccess, const TArray<FGuid>& NoteIds)> Completion);
+
 	// Create a new note on the server
 	UFUNCTION(BlueprintCallable, Category="DevNotes")
 	void PostNote(const FDevNote& Note);
 
-	// Update a note in-place on the server
+	// Update a note in-place on the server. OnNoteUpdateFailed is broadcast if the edit could not be sent or was rejected
 	UFUNCTION(BlueprintCallable, Category="DevNotes")
 	void UpdateNote(const FDevNote& Note);
 
@@ -76,19 +111,61 @@ public:
 
 	const TArray<FDevNoteTag>& GetCachedTags() const { return CachedTags; }
 
-	// Callbacks
-	FOnNotesUpdated OnNotesUpdated;
-	FOnTagsUpdated OnTagsUpdated;
+	// The same tags as shared objects that live as long as the tag does. Renames and recolours update them in place
+	const TArray<TSharedPtr<FDevNoteTag>>& GetSharedTags() const { return SharedTags; }
+	TSharedPtr<FDevNoteTag> FindSharedTag(const FGuid& TagId) const { return SharedTagsById.FindRef(TagId); }
+
+	// Lowercased note fields and tag/user names, kept in sync with the caches for fast filtering
+	const FDevNoteSearchIndex& GetSearchIndex() const { return SearchIndex; }
+
+	// The cached notes, tags and users as an immutable snapshot. Safe to call and to read from any thread.
+	// Notes created in this editor and fetched bodies show up at once, edits to existing notes once they were synced back
+	FDevNoteSnapshotRef GetSnapshot() const;
+
+	// The local user's saved filters, with results kept current as notes sync
+	const FDevNoteSavedViews& GetSavedViews() const { return SavedViews; }
+
+	// Request latencies and sync stage timings of the last few minutes
+	const FDevNoteDiagnostics& GetDiagnostics() const { return Diagnostics; }
+
+	// Records completed requests to a file while started
+	FDevNoteTrafficCapture& GetTrafficCapture() { return TrafficCapture; }
+
+	// Store Query as a view in the user's settings, replacing any view of the same name
+	void SaveView(const FString& Name, const FString& Query);
+	void DeleteView(const FString& Name);
+
+	// Callbacks. Note and tag syncs only broadcast when something changed, with the Ids that did
+	FOnNotesChanged OnNotesChanged;
+	FOnTagsChanged OnTagsChanged;
+	FOnUsersUpdated OnUsersUpdated;
 	FOnSignedIn OnSignedIn;
 	FOnSignedOut OnSignedOut;
+	FOnNoteBodyLoaded OnNoteBodyLoaded;
+	FOnNoteUpdateFailed OnNoteUpdateFailed;
+
+	// Views were added, removed or edited, or their results changed
+	FOnSavedViewsUpdated OnSavedViewsUpdated;
 
 	// JSON Conversion functions - explicit conversions due to needing to format FGuid in a specific way, and other datatype conversions 
-	static bool ParseNoteFromJsonObject(const TSharedPtr<FJsonObject>& JsonObj, FDevNote& OutNote);
+	// Only a summary (bSummary) may leave the body out, a full note without one is rejected
+	static bool ParseNoteFromJsonObject(const TSharedPtr<FJsonObject>& JsonObj, FDevNote& OutNote, bool bSummary = false);
 	static TSharedPtr<FJsonObject> ConvertNoteToJsonObject(const FDevNote& Note);
 	static FString SerializeNoteToJsonString(const FDevNote& Note);
 	static TSharedPtr<FJsonObject> ConvertTagToJsonObject(const FDevNoteTag& Tag);
 	static bool ParseTagFromJsonObject(const TSharedPtr<FJsonObject>& JsonObj, FDevNoteTag& OutTag);
-	void ParseAndCacheNotesFromJson(const FString& JsonString);
+
+	// Parse a JSON array of notes, skipping malformed ones. False if the array itself couldn't be read
+	static bool ParseNotesFromJson(const FString& JsonString, TArray<FDevNote>& OutNotes, bool bSummary = false);
+
+	// Merge a notes response into the cache. Notes that already exist are updated in place, so pointers to them stay valid
+	FDevNoteChangeSet ParseAndCacheNotesFromJson(const FString& JsonString, bool bSummary = false);
+
+	// Apply a /notes, /tags or /users response body as if the server had just sent it, e.g. when replaying captured traffic.
+	// Tags and users are cleared when !bSuccess, a successful body that doesn't parse leaves them unchanged
+	void ApplyNotesResponse(const FString& ResponseString, bool bSummary = false);
+	void ApplyTagsResponse(const FString& ResponseString, bool bSuccess);
+	void ApplyUsersResponse(const FString& ResponseString, bool bSuccess);
 
 	// Create a new note + waypoint at the editor camera's location
 	void CreateNewNoteAtEditorLocation();
@@ -110,18 +187,52 @@ public:
 	const FDevNoteUser& GetCurrentUser();
 
 	bool TryAutoSignIn();
+
+	/**
+	 * Make this one of many simulated clients in the same process, as the load test creates them.
+	 * It talks to ServerAddress, keeps its session out of the saved token file and spawns no waypoints.
+	 */
+	void MakeSimulatedClient(const FString& ServerAddress);
 private:
 	const FString SessionTokenFileName = TEXT("DevNotes/session.token");
 	FTimerHandle RefreshNotesTimerHandle;
+	FTimerHandle RefreshTimedViewsTimerHandle;
 
 	bool bIsEditorEditing = false; // Editing state flag
 	bool bRefreshPendingWhileEditing = false; // Wants to refresh once editing flag is toggled off again
 
 	// TODO: Replace with TMap? Looking up by id is a common use case. Also investigate if TSharedPtr is still needed
 	TArray<TSharedPtr<FDevNote>> CachedNotes; // Local copy of all notes
+	TMap<FGuid, TSharedPtr<FDevNote>> CachedNotesById;
 	TArray<FDevNoteTag> CachedTags; // Local copy of all tags
+	TArray<TSharedPtr<FDevNoteTag>> SharedTags;
+	TMap<FGuid, TSharedPtr<FDevNoteTag>> SharedTagsById;
 	TArray<FDevNoteUser> CachedUsers; // Local copy of all users
 
+	FDevNoteSearchIndex SearchIndex;
+
+	// Replaced, never modified, on the game thread. Readers only hold the lock while taking a reference
+	FDevNoteSnapshotRef Snapshot = MakeShared<const FDevNoteSnapshot, ESPMode::ThreadSafe>();
+	mutable FRWLock SnapshotLock;
+	void SyncSharedTags(const FDevNoteChangeSet& Changes);
+	void PublishSnapshot(const FDevNoteChangeSet& NoteChanges, bool bTagsChanged, bool bUsersChanged);
+
+	FDevNoteSavedViews SavedViews;
+
+	// Load the views from the user settings and evaluate them
+	void ReloadSavedViews();
+
+	// Patch the views with notes the search index just took in, or re-evaluate them after tags or users changed
+	void UpdateSavedViews(const FDevNoteChangeSet& NoteChanges);
+	void RebuildSavedViews();
+
+	FDevNoteDiagnostics Diagnostics;
+	FDevNoteTrafficCapture TrafficCapture;
+
+	// Bodies fetched on demand while summary sync is enabled
+	FDevNoteBodyCache BodyCache;
+	TMap<FGuid, TArray<TFunction<void(bool)>>> PendingBodyRequests;
+
 	// Current user data
 	FGuid CurrentUserId;
 	FString SessionToken;
@@ -133,23 +244,50 @@ private:
 	// Called every 30 seconds to refresh notes from server
 	void OnPollNotesTimerTimeout();
 
+	// Called every minute to move saved views with relative times like edited<7d along with the clock
+	void OnRefreshTimedViewsTimerTimeout();
+
 	// Self explanatory
 	ADevNoteActor* SpawnWaypointForNote(TSharedPtr<FDevNote> Note);
 
+	// Spawned waypoints by note, so a sync only touches the waypoints of notes it changed
+	TMap<FGuid, TWeakObjectPtr<ADevNoteActor>> WaypointsByNoteId;
+	void ApplyWaypointChanges(const FDevNoteChangeSet& Changes);
+	void DestroyWaypoint(const FGuid& NoteId);
+
 	// Get a list of waypoints selected in the viewport (only their underlying notes, we dont really care about the actors)
 	TArray<TSharedPtr<FDevNote>> GetSelectedNoteWaypoints();
 	void StoreSelectedNoteIDs();
 
+	// Send a request built by one of the functions above, counting its traffic and time spent waiting on the server
+	void ProcessRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request);
+
 	// Http Responses
 	void HandleNotesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
 	void HandleUsersResponse(TSharedPtr<IHttpRequest> HttpRequest, TSharedPtr<IHttpResponse> HttpResponse, bool bWasSuccessful);
 	void HandleTagsResponse(TSharedPtr<IHttpRequest> HttpRequest, TSharedPtr<IHttpResponse> HttpResponse, bool bWasSuccessful);
+	void HandleNoteBodyResponse(FGuid NoteId, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	// Update the cached note with Parsed, or cache it as a new one if Note is null. Records what changed
+	void MergeParsedNote(FDevNote&& Parsed, TSharedPtr<FDevNote>& Note, FDevNoteChangeSet& Changes);
+
+	// Bring the search index in line with the cache after merging Changes into it
+	void UpdateSearchIndex(const FDevNoteChangeSet& Changes);
+
+	// Copy a body into the cached note with the given Id and notify listeners
+	void ApplyNoteBody(const FGuid& NoteId, const FString& Body);
+	TSharedPtr<FDevNote> FindCachedNote(const FGuid& NoteId) const;
 
 	// All loaded levels and sublevels
 	TSet<FString> GetLoadedLevelPaths();
 
+	// Simulated clients don't touch the editor's session or level
+	bool bSimulatedClient = false;
+	FString ServerAddressOverride;
+
 	// Get the desired server connection address from user settings
 	FString GetServerAddress() const;
+	FString GetQueryServerAddress() const;
 
 	// Auth functions
 	FString GetSessionTokenFilePath() const;
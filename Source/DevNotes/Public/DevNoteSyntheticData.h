@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FDevNote.h"
+#include "FDevNoteTag.h"
+#include "FDevNoteUser.h"
+#include "Math/RandomStream.h"
+
+struct FDevNoteSyntheticDataParams
+{
+	int32 NumNotes = 10000;
+	int32 NumTags = 2000;
+	int32 NumUsers = 500;
+	int32 NumLevels = 200;
+	int32 MaxTagsPerNote = 4;
+
+	// Words per note body, 0 for notes without one
+	int32 BodyWords = 40;
+	int32 Seed = 1234;
+
+	// Notes are created over the year before this, so relative time filters like edited<30d have something to cut
+	FDateTime LatestTime = FDateTime::UtcNow();
+
+	// Package path used as level 0, e.g. the map open in the editor so its notes get waypoints. Generated when empty
+	FString FirstLevelPackage;
+};
+
+/**
+ * Deterministic notes, tags, users and levels shaped like a real project's, for benchmarks and the mock server.
+ * The same params always produce the same titles, tags, levels and positions. Ids are derived from the seed too,
+ * times from LatestTime, which defaults to now.
+ * Tag 0 is "Bug" and levels are named Zone00, Zone01, ... so benchmark queries like `tag=bug map=zone04` match.
+ */
+struct DEVNOTES_API FDevNoteSyntheticData
+{
+	TArray<FDevNoteTag> Tags;
+	TArray<FDevNoteUser> Users;
+
+	// Object paths, e.g. /Game/Maps/Zone04.Zone04
+	TArray<FString> LevelPaths;
+	TArray<FDevNote> Notes;
+	FDateTime LatestTime;
+
+	static FDevNoteSyntheticData Generate(const FDevNoteSyntheticDataParams& Params);
+
+	// Another note over the same tags, users and levels, e.g. for a simulated client to post
+	FDevNote MakeNote(FRandomStream& Random, int32 BodyWords) const;
+
+	// The server's JSON for GET /notes, /tags and /users
+	FString NotesToJson(bool bSummary = false) const;
+	FString TagsToJson() const;
+	FString UsersToJson() const;
+
+	static FGuid MakeGuid(FRandomStream& Random);
+};
@@ -0,0 +1,70 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "FDevNote.h"
+
+/**
+ * Inverted index over the words in note titles and bodies.
+ * Updated incrementally: notes whose title and body didn't change since the last sync are skipped.
+ * Lookups are by word prefix, so a partially typed word already finds its notes.
+ */
+class DEVNOTES_API FDevNoteTextIndex
+{
+public:
+	enum class EField : uint8
+	{
+		Title = 1 << 0,
+		Body = 1 << 1,
+		Any = Title | Body
+	};
+
+	// Index or re-index a note. Bodies that haven't been fetched yet are left out
+	void UpdateNote(const FDevNote& Note);
+	void RemoveNote(const FGuid& NoteId);
+
+	// Bring the index in line with a full note list, removing notes that are no longer present
+	void SyncNotes(const TArray<TSharedPtr<FDevNote>>& Notes);
+	void Empty();
+
+	/**
+	 * Score every note that has, for each word in Phrase, a word starting with it.
+	 * Scores favour title hits, whole word hits and rare words. Returns false if Phrase has no words to look up.
+	 */
+	bool Search(const FString& Phrase, EField Fields, TMap<FGuid, float>& OutScores) const;
+
+	// Split text into lowercase words, counting occurrences
+	static void Tokenize(const FString& Text, TMap<FString, int32>& OutCounts);
+
+	int32 NumNotes() const { return Docs.Num(); }
+	int32 NumWords() const { return Postings.Num(); }
+
+private:
+	struct FPosting
+	{
+		int32 DocId = INDEX_NONE;
+		uint16 TitleHits = 0;
+		uint16 BodyHits = 0;
+	};
+
+	struct FDoc
+	{
+		int32 DocId = INDEX_NONE;
+		uint32 Fingerprint = 0;
+		TArray<FString> Words;
+	};
+
+	void RemoveDocWords(const FDoc& Doc);
+	void EnsureSortedWords() const;
+	void SearchWord(const FString& Prefix, EField Fields, TMap<int32, float>& OutScores) const;
+
+	TMap<FGuid, FDoc> Docs;
+	TArray<FGuid> NoteIdByDocId;
+	TArray<int32> FreeDocIds;
+	TMap<FString, TArray<FPosting>> Postings;
+
+	// Vocabulary sorted for prefix range lookups, rebuilt lazily after words are added or removed
+	mutable TArray<FString> SortedWords;
+	mutable bool bSortedWordsDirty = false;
+};
+
+ENUM_CLASS_FLAGS(FDevNoteTextIndex::EField);
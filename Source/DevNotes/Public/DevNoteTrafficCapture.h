@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpFwd.h"
+
+// One request and its response, as captured
+struct FDevNoteExchange
+{
+	// Seconds from the start of the capture to the response
+	double Time = 0.0;
+	double DurationMs = 0.0;
+
+	FString Verb;
+
+	// Path and query, without the server address, e.g. /notes?summary=true
+	FString Url;
+	FString RequestBody;
+
+	// 0 when no response arrived
+	int32 ResponseCode = 0;
+	FString ResponseBody;
+};
+
+/**
+ * Writes every request the subsystem completes to a JSON lines file, one exchange per line, for offline replay.
+ * Session tokens are replaced wherever they appear, as are token and password fields of JSON object bodies.
+ * Game thread only.
+ */
+class DEVNOTES_API FDevNoteTrafficCapture
+{
+public:
+	~FDevNoteTrafficCapture();
+
+	// Start a new capture file, replacing one at Path. An empty Path picks one under Saved/DevNotes/Captures
+	bool Start(const FString& Path = FString());
+	void Stop();
+
+	bool IsRecording() const { return Writer.IsValid(); }
+	const FString& GetPath() const { return Path; }
+	int32 GetNumRecorded() const { return NumRecorded; }
+
+	// SessionToken is scrubbed along with the request's own token header
+	void Record(const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, double RequestStartTime, double EndTime, const FString& SessionToken);
+
+	// Read a capture file, ordered by response time
+	static bool Load(const FString& Path, TArray<FDevNoteExchange>& OutExchanges);
+
+	static FString Scrub(const FString& Text, TConstArrayView<FString> Secrets);
+
+private:
+	TUniquePtr<FArchive> Writer;
+	FString Path;
+	double StartTime = 0.0;
+	int32 NumRecorded = 0;
+};
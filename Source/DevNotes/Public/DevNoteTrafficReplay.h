@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "DevNoteTrafficCapture.h"
+
+class UDevNoteSubsystem;
+
+/**
+ * Feeds captured /notes, /tags and /users responses back into a subsystem through the code that applies live ones,
+ * so parsing, cache reconciliation and waypoint updates can be profiled against real traffic without a server.
+ * Other exchanges (sign in, mutations, note bodies, queries) and failed ones are left out.
+ */
+class DEVNOTES_API FDevNoteTrafficReplay : public TSharedFromThis<FDevNoteTrafficReplay>
+{
+public:
+	FDevNoteTrafficReplay(UDevNoteSubsystem& InTarget, TArray<FDevNoteExchange>&& InExchanges);
+	~FDevNoteTrafficReplay();
+
+	// Replay on the core ticker. Speed 1 keeps the captured spacing, 10 is ten times faster, 0 applies one response per tick
+	void Start(float InSpeed);
+	void Stop();
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+	// Apply every remaining response right away, in order
+	void ApplyAll();
+
+	int32 Num() const { return Exchanges.Num(); }
+	int32 GetNumApplied() const { return NextIndex; }
+	int32 GetNumLeftOut() const { return NumLeftOut; }
+
+	static bool IsReplayable(const FDevNoteExchange& Exchange);
+
+private:
+	bool Tick(float DeltaTime);
+	void ApplyNext();
+
+	TWeakObjectPtr<UDevNoteSubsystem> Target;
+	TArray<FDevNoteExchange> Exchanges;
+	int32 NextIndex = 0;
+	int32 NumLeftOut = 0;
+
+	float Speed = 1.0f;
+	double StartTime = 0.0;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
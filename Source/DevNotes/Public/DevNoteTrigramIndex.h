@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Trigram index over a vocabulary of words, used to find words spelled similarly to a (possibly misspelled) search term.
+ * Words are reference counted, so the same word coming from many titles, tags or levels is stored once
+ * and disappears when the last text using it is removed.
+ */
+class DEVNOTES_API FDevNoteTrigramIndex
+{
+public:
+	struct FMatch
+	{
+		FString Word;
+
+		// Jaccard similarity of the trigram sets, 1 for identical words
+		float Similarity = 0.0f;
+	};
+
+	// Add or remove every word of Text, split the same way as the text index does
+	void AddText(const FString& Text);
+	void RemoveText(const FString& Text);
+	void Empty();
+
+	/**
+	 * Collect vocabulary words at least MinSimilarity similar to Term, best first, at most MaxMatches of them.
+	 * Only misspellings are corrected: nothing is returned when a word already contains Term, e.g. a partially typed word.
+	 * Terms shorter than MinTermLen are not looked up, they'd match almost anything.
+	 */
+	void FindCorrections(const FString& Term, float MinSimilarity, TArray<FMatch>& OutMatches, int32 MaxMatches = 16) const;
+
+	int32 NumWords() const { return WordIdByWord.Num(); }
+
+	static constexpr int32 MinTermLen = 3;
+
+private:
+	struct FWordInfo
+	{
+		FString Word;
+		int32 RefCount = 0;
+		int32 NumTrigrams = 0;
+	};
+
+	static void GetTrigrams(const FString& Word, TArray<uint64>& OutTrigrams);
+
+	void AddWord(const FString& Word);
+	void RemoveWord(const FString& Word);
+
+	TMap<FString, int32> WordIdByWord;
+	TArray<FWordInfo> Words;
+	TArray<int32> FreeWordIds;
+	TMap<uint64, TArray<int32>> WordIdsByTrigram;
+};
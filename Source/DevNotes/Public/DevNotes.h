@@ -8,6 +8,8 @@
 class FToolBarBuilder;
 class FMenuBuilder;
 class SDevNotesDropdownWidget;
+class SDockTab;
+class FSpawnTabArgs;
 class FDevNotesModule : public IModuleInterface
 {
 public:
@@ -17,9 +19,21 @@ public:
 	virtual void ShutdownModule() override;
 
 
+	// Open the DevNotes tab, or focus it if it is already open
+	void OpenNotesTab();
+
+	// Open the DevNotes tab showing the notes of a saved view
+	void OpenSavedView(const FString& Name);
+
+	static const FName NotesTabName;
+	static const FName DiagnosticsTabName;
+
 private:
 	TSharedPtr<SButton> ToolButton;
-	TSharedRef<SWidget> GenerateNotesDropdown();
+	TSharedRef<SDockTab> SpawnNotesTab(const FSpawnTabArgs& Args);
+	TSharedRef<SDockTab> SpawnDiagnosticsTab(const FSpawnTabArgs& Args);
+
+	// Lives as long as the module, so reopening the tab reuses it as is
 	TSharedPtr<SDevNotesDropdownWidget> NotesWidget;
 	void RegisterMenus();
 };
@@ -23,4 +23,28 @@ public:
 	// Actor used to represent a note in the world
 	UPROPERTY(Config, EditDefaultsOnly, Category="Dev Note")
 	TSoftClassPtr<ADevNoteActor> DevNoteActorRepresentation = ADevNoteActor::StaticClass();
+
+	// Only sync note headers (title, tags, position, level, timestamps). Bodies are fetched when a note is opened
+	UPROPERTY(Config, EditDefaultsOnly, Category="Dev Note|Sync")
+	bool bSummaryNoteSync = false;
+
+	// Memory budget for note bodies fetched while summary sync is enabled
+	UPROPERTY(Config, EditDefaultsOnly, Category="Dev Note|Sync", meta=(EditCondition="bSummaryNoteSync", ClampMin="64", Units="Kilobytes"))
+	int32 NoteBodyCacheSizeKB = 8192;
+
+	// Number of rows above and below the selected note whose bodies are prefetched
+	UPROPERTY(Config, EditDefaultsOnly, Category="Dev Note|Sync", meta=(EditCondition="bSummaryNoteSync", ClampMin="0", ClampMax="16"))
+	int32 NoteBodyPrefetchRadius = 2;
+
+	// How alike a misspelled search term and a word in a title, tag, user or level must be to still match (0 - 1). 0 disables fuzzy matching
+	UPROPERTY(Config, EditDefaultsOnly, Category="Dev Note|Search", meta=(ClampMin="0", ClampMax="1"))
+	float FuzzyMatchThreshold = 0.4f;
+
+	// Send selector filters to the server and list only the notes it returns. Filters locally while the server can't be reached
+	UPROPERTY(Config, EditDefaultsOnly, Category="Dev Note|Search")
+	bool bServerSideFiltering = false;
+
+	// Where filter queries are sent, empty for Server Address. Point it at DevNotes.QueryStandIn.Start to try queries without backend support
+	UPROPERTY(Config, EditDefaultsOnly, Category="Dev Note|Search", meta=(EditCondition="bServerSideFiltering"))
+	FString QueryServerAddress;
 };
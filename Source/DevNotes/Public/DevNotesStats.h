@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+// `stat DevNotes` in the editor console. Scopes also show up as CPU events in Unreal Insights
+DECLARE_STATS_GROUP(TEXT("DevNotes"), STATGROUP_DevNotes, STATCAT_Advanced);
+
+// Sync pipeline, in the order a sync runs through it
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Request"), STAT_DevNotes_BuildRequest, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse Response"), STAT_DevNotes_Parse, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply To Cache"), STAT_DevNotes_ApplyCache, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh Waypoints"), STAT_DevNotes_RefreshWaypoints, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Filter"), STAT_DevNotes_Filter, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Rows"), STAT_DevNotes_GenerateRows, STATGROUP_DevNotes, DEVNOTES_API);
+
+// Requests complete on later frames, so their wait is reported when they do
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Network Wait (ms)"), STAT_DevNotes_NetworkWait, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests In Flight"), STAT_DevNotes_RequestsInFlight, STATGROUP_DevNotes, DEVNOTES_API);
+
+// Per frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Sent"), STAT_DevNotes_BytesSent, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Received"), STAT_DevNotes_BytesReceived, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Notes Parsed"), STAT_DevNotes_NotesParsed, STATGROUP_DevNotes, DEVNOTES_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actors Spawned"), STAT_DevNotes_ActorsSpawned, STATGROUP_DevNotes, DEVNOTES_API);
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Search Entries"), STAT_DevNotes_SearchEntriesMemory, STATGROUP_DevNotes, DEVNOTES_API);
+
+// Everything the plugin allocates under a DevNotes scope, visible with -llm
+LLM_DECLARE_TAG_API(DevNotes, DEVNOTES_API);
+
+// Time a pipeline stage for both `stat DevNotes` and Insights
+#define DEVNOTES_SCOPE(Stage) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(DevNotes_##Stage); \
+	SCOPE_CYCLE_COUNTER(STAT_DevNotes_##Stage)
+
+namespace DevNotesStats
+{
+	// Counted per frame in `stat DevNotes` and as running totals in Insights
+	DEVNOTES_API void AddBytesSent(int64 Bytes);
+	DEVNOTES_API void AddBytesReceived(int64 Bytes);
+	DEVNOTES_API void AddNotesParsed(int32 Count);
+	DEVNOTES_API void AddActorsSpawned(int32 Count);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "DevNotesUserSettings.generated.h"
+
+USTRUCT()
+struct FDevNoteSavedViewSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category="View")
+	FString Name;
+
+	// A filter in the selector's search syntax, e.g. tag=bug map=Zone04
+	UPROPERTY(EditAnywhere, Category="View")
+	FString Query;
+
+	// Show a button with the view's live note count on the level editor toolbar
+	UPROPERTY(EditAnywhere, Category="View")
+	bool bShowInToolbar = false;
+};
+
+/**
+ * DevNotes preferences of the local user, stored per project but outside source control.
+ */
+UCLASS(Config=EditorPerProjectUserSettings, meta=(DisplayName="DevNotes"))
+class DEVNOTES_API UDevNotesUserSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	// Listed under Editor Preferences rather than Project Settings
+	virtual FName GetContainerName() const override { return TEXT("Editor"); }
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	// Named filters whose results are kept up to date as notes sync, so switching to one shows its notes immediately
+	UPROPERTY(Config, EditAnywhere, Category="Dev Note|Views")
+	TArray<FDevNoteSavedViewSettings> SavedViews;
+};
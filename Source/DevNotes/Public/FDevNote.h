@@ -33,4 +33,8 @@ struct FDevNote
 
 	UPROPERTY(BlueprintReadOnly, Category="Dev Note")
 	TArray<FGuid> Tags;
+
+	// False when the note came from a summary sync and its body hasn't been fetched yet
+	UPROPERTY(Transient)
+	bool bBodyLoaded = true;
 };
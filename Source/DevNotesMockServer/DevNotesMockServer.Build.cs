@@ -0,0 +1,26 @@
+using UnrealBuildTool;
+
+public class DevNotesMockServer : ModuleRules
+{
+    public DevNotesMockServer(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "DevNotes",
+                "HTTPServer"
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "CoreUObject",
+                "Json"
+            }
+        );
+    }
+}
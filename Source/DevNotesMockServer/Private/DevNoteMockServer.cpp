@@ -0,0 +1,577 @@
+#include "DevNoteMockServer.h"
+
+#include "DevNoteSubsystem.h"
+#include "DevNotesMockServerLog.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/PackageName.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace DevNoteMockServer
+{
+	static FString GetBodyString(const FHttpServerRequest& Request)
+	{
+		const FUTF8ToTCHAR Body(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+		return FString(Body.Length(), Body.Get());
+	}
+
+	static TSharedPtr<FJsonObject> ParseBodyObject(const FHttpServerRequest& Request)
+	{
+		TSharedPtr<FJsonObject> Json;
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(GetBodyString(Request)), Json);
+		return Json;
+	}
+
+	static FString GetSessionToken(const FHttpServerRequest& Request)
+	{
+		const TArray<FString>* Values = Request.Headers.Find(TEXT("X-Session-Token"));
+		return Values && !Values->IsEmpty() ? (*Values)[0] : FString();
+	}
+
+	static bool GetPathId(const FHttpServerRequest& Request, FGuid& OutId)
+	{
+		return FGuid::Parse(Request.PathParams.FindRef(TEXT("id")), OutId);
+	}
+
+	static FString ToJsonString(const TSharedRef<FJsonObject>& Json)
+	{
+		FString String;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&String);
+		FJsonSerializer::Serialize(Json, Writer);
+		return String;
+	}
+
+	static FString ToJsonString(const TArray<TSharedPtr<FJsonValue>>& Values)
+	{
+		FString String;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&String);
+		FJsonSerializer::Serialize(Values, Writer);
+		return String;
+	}
+
+	static TUniquePtr<FHttpServerResponse> JsonResponse(const FString& Json, EHttpServerResponseCodes Code = EHttpServerResponseCodes::Ok)
+	{
+		TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Json, TEXT("application/json"));
+		Response->Code = Code;
+		return Response;
+	}
+
+	// As the server sends notes, with the time it last stored them
+	static TSharedRef<FJsonObject> NoteToJson(const FDevNote& Note)
+	{
+		const TSharedRef<FJsonObject> Json = UDevNoteSubsystem::ConvertNoteToJsonObject(Note).ToSharedRef();
+		Json->SetStringField(TEXT("lastEdited"), Note.LastEdited.ToIso8601());
+		return Json;
+	}
+}
+
+FDevNoteMockServerSettings FDevNoteMockServerSettings::FromString(const TCHAR* Params)
+{
+	FDevNoteMockServerSettings Settings;
+	FParse::Value(Params, TEXT("Port="), Settings.Port);
+	FParse::Value(Params, TEXT("Notes="), Settings.Data.NumNotes);
+	FParse::Value(Params, TEXT("Tags="), Settings.Data.NumTags);
+	FParse::Value(Params, TEXT("Users="), Settings.Data.NumUsers);
+	FParse::Value(Params, TEXT("Levels="), Settings.Data.NumLevels);
+	FParse::Value(Params, TEXT("BodyWords="), Settings.Data.BodyWords);
+	FParse::Value(Params, TEXT("Seed="), Settings.Data.Seed);
+	FParse::Value(Params, TEXT("LatencyMs="), Settings.LatencyMs);
+	FParse::Value(Params, TEXT("JitterMs="), Settings.JitterMs);
+	FParse::Value(Params, TEXT("ErrorRate="), Settings.ErrorRate);
+	FParse::Value(Params, TEXT("ErrorCode="), Settings.ErrorCode);
+	FParse::Value(Params, TEXT("Password="), Settings.Password);
+	return Settings;
+}
+
+FDevNoteMockServer::FDevNoteMockServer(const FDevNoteMockServerSettings& InSettings)
+	: Settings(InSettings)
+	, Random(InSettings.Data.Seed)
+{
+	FDevNoteSyntheticData Data = FDevNoteSyntheticData::Generate(Settings.Data);
+	Tags = MoveTemp(Data.Tags);
+	Users = MoveTemp(Data.Users);
+	Notes.Reserve(Data.Notes.Num());
+	for (FDevNote& Note : Data.Notes)
+	{
+		const FGuid NoteId = Note.Id;
+		Note.bBodyLoaded = true;
+		Notes.Add(NoteId, MoveTemp(Note));
+	}
+}
+
+FDevNoteMockServer::~FDevNoteMockServer()
+{
+	Stop();
+}
+
+bool FDevNoteMockServer::Start()
+{
+	Stop();
+
+	FHttpServerModule& HttpServer = FHttpServerModule::Get();
+	Router = HttpServer.GetHttpRouter(Settings.Port, /* bFailOnBindFailure */ true);
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogDevNotesMockServer, Error, TEXT("Mock server could not listen on port %u"), Settings.Port);
+		return false;
+	}
+
+	Bind(TEXT("/signin"), EHttpServerRequestVerbs::VERB_POST, &FDevNoteMockServer::HandleSignIn, false);
+	Bind(TEXT("/validatetoken"), EHttpServerRequestVerbs::VERB_POST, &FDevNoteMockServer::HandleValidateToken, false);
+	Bind(TEXT("/signout"), EHttpServerRequestVerbs::VERB_POST, &FDevNoteMockServer::HandleSignOut, false);
+	Bind(TEXT("/notes"), EHttpServerRequestVerbs::VERB_GET, &FDevNoteMockServer::HandleGetNotes);
+	Bind(TEXT("/notes"), EHttpServerRequestVerbs::VERB_POST, &FDevNoteMockServer::HandlePostNote);
+
+	// Runtime uploads carry an upload key rather than a session, the author is named in the note
+	Bind(TEXT("/notes/dto"), EHttpServerRequestVerbs::VERB_POST, &FDevNoteMockServer::HandlePostNoteDto, false);
+	Bind(TEXT("/notes/:id"), EHttpServerRequestVerbs::VERB_GET, &FDevNoteMockServer::HandleGetNote);
+	Bind(TEXT("/notes/:id"), EHttpServerRequestVerbs::VERB_PUT, &FDevNoteMockServer::HandlePutNote);
+	Bind(TEXT("/notes/:id"), EHttpServerRequestVerbs::VERB_DELETE, &FDevNoteMockServer::HandleDeleteNote);
+	Bind(TEXT("/tags"), EHttpServerRequestVerbs::VERB_GET, &FDevNoteMockServer::HandleGetTags);
+	Bind(TEXT("/tags"), EHttpServerRequestVerbs::VERB_POST, &FDevNoteMockServer::HandlePostTag);
+	Bind(TEXT("/tags/:id"), EHttpServerRequestVerbs::VERB_DELETE, &FDevNoteMockServer::HandleDeleteTag);
+	Bind(TEXT("/users"), EHttpServerRequestVerbs::VERB_GET, &FDevNoteMockServer::HandleGetUsers);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FDevNoteMockServer::SendDueResponses));
+	HttpServer.StartAllListeners();
+
+	UE_LOG(LogDevNotesMockServer, Display, TEXT("Mock server serving %d notes, %d tags and %d users at %s (latency %.0f +- %.0f ms, error rate %.2f)"),
+		Notes.Num(), Tags.Num(), Users.Num(), *GetAddress(), Settings.LatencyMs, Settings.JitterMs, Settings.ErrorRate);
+	return true;
+}
+
+void FDevNoteMockServer::Stop()
+{
+	if (!Router.IsValid())
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	// Nobody would answer these connections otherwise
+	TArray<FPendingResponse> Pending = MoveTemp(PendingResponses);
+	for (FPendingResponse& Response : Pending)
+	{
+		Response.OnComplete(MoveTemp(Response.Response));
+	}
+
+	for (const FHttpRouteHandle& RouteHandle : RouteHandles)
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+	RouteHandles.Reset();
+	Router.Reset();
+	UE_LOG(LogDevNotesMockServer, Display, TEXT("Mock server stopped after %lld requests, %lld failed on purpose"), RequestsHandled, ErrorsInjected);
+}
+
+void FDevNoteMockServer::SetLatency(float InLatencyMs, float InJitterMs)
+{
+	Settings.LatencyMs = FMath::Max(0.0f, InLatencyMs);
+	Settings.JitterMs = FMath::Max(0.0f, InJitterMs);
+}
+
+void FDevNoteMockServer::SetErrorRate(float InErrorRate, int32 InErrorCode)
+{
+	Settings.ErrorRate = FMath::Clamp(InErrorRate, 0.0f, 1.0f);
+	Settings.ErrorCode = InErrorCode;
+}
+
+FString FDevNoteMockServer::CreateSession(const FString& UserName)
+{
+	const FGuid UserId = FindOrAddUser(UserName).Id;
+	const FString Token = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	Sessions.Add(Token, UserId);
+	return Token;
+}
+
+void FDevNoteMockServer::Bind(const TCHAR* Path, EHttpServerRequestVerbs Verbs, FHandler Handler, bool bRequiresSession)
+{
+	const FHttpRouteHandle RouteHandle = Router->BindRoute(FHttpPath(Path), Verbs,
+		FHttpRequestHandler::CreateSP(this, &FDevNoteMockServer::Handle, Handler, bRequiresSession));
+	if (RouteHandle.IsValid())
+	{
+		RouteHandles.Add(RouteHandle);
+	}
+	else
+	{
+		UE_LOG(LogDevNotesMockServer, Warning, TEXT("Mock server could not bind %s, is something else serving it on port %u?"), Path, Settings.Port);
+	}
+}
+
+bool FDevNoteMockServer::Handle(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, FHandler Handler, bool bRequiresSession)
+{
+	++RequestsHandled;
+
+	if (Settings.ErrorRate > 0.0f && Random.FRand() < Settings.ErrorRate)
+	{
+		++ErrorsInjected;
+		Respond(FHttpServerResponse::Error(static_cast<EHttpServerResponseCodes>(Settings.ErrorCode), TEXT("Injected"), TEXT("Failed by the mock server's error rate")), OnComplete);
+		return true;
+	}
+
+	FGuid UserId;
+	if (bRequiresSession)
+	{
+		const FGuid* SessionUserId = Sessions.Find(DevNoteMockServer::GetSessionToken(Request));
+		if (!SessionUserId)
+		{
+			Respond(FHttpServerResponse::Error(EHttpServerResponseCodes::Denied, TEXT("InvalidToken"), TEXT("Unknown session token")), OnComplete);
+			return true;
+		}
+		UserId = *SessionUserId;
+	}
+
+	Respond((this->*Handler)(Request, UserId), OnComplete);
+	return true;
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleSignIn(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	const TSharedPtr<FJsonObject> Body = DevNoteMockServer::ParseBodyObject(Request);
+	FString UserName;
+	FString Password;
+	if (!Body.IsValid() || !Body->TryGetStringField(TEXT("UserName"), UserName) || UserName.IsEmpty())
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("InvalidSignIn"), TEXT("Expected a UserName"));
+	}
+	Body->TryGetStringField(TEXT("Password"), Password);
+	if (!Settings.Password.IsEmpty() && Password != Settings.Password)
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::Denied, TEXT("InvalidCredentials"), TEXT("Wrong user name or password"));
+	}
+
+	const FString Token = CreateSession(UserName);
+	const TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetStringField(TEXT("token"), Token);
+	Json->SetStringField(TEXT("Id"), Sessions[Token].ToString(EGuidFormats::DigitsWithHyphens));
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(Json));
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleValidateToken(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	// Sent either as {"token": ...} or as the bare token
+	FString Token = DevNoteMockServer::GetBodyString(Request).TrimStartAndEnd();
+	const TSharedPtr<FJsonObject> Body = DevNoteMockServer::ParseBodyObject(Request);
+	if (Body.IsValid())
+	{
+		Body->TryGetStringField(TEXT("token"), Token);
+	}
+
+	const FGuid* SessionUserId = Sessions.Find(Token);
+	if (!SessionUserId)
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::Denied, TEXT("InvalidToken"), TEXT("Unknown session token"));
+	}
+
+	const TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetStringField(TEXT("Id"), SessionUserId->ToString(EGuidFormats::DigitsWithHyphens));
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(Json));
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleSignOut(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	FString Token = DevNoteMockServer::GetSessionToken(Request);
+	if (Token.IsEmpty())
+	{
+		Token = DevNoteMockServer::GetBodyString(Request).TrimStartAndEnd();
+	}
+	Sessions.Remove(Token);
+	return DevNoteMockServer::JsonResponse(TEXT("{}"));
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleGetNotes(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	const bool bSummary = Request.QueryParams.FindRef(TEXT("summary")) == TEXT("true");
+	TOptional<FString>& Json = bSummary ? NoteSummariesJson : NotesJson;
+	if (!Json.IsSet())
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(Notes.Num());
+		for (const TPair<FGuid, FDevNote>& Pair : Notes)
+		{
+			const TSharedRef<FJsonObject> NoteJson = DevNoteMockServer::NoteToJson(Pair.Value);
+			if (bSummary)
+			{
+				NoteJson->RemoveField(TEXT("body"));
+			}
+			Values.Add(MakeShared<FJsonValueObject>(NoteJson));
+		}
+		Json = DevNoteMockServer::ToJsonString(Values);
+	}
+	return DevNoteMockServer::JsonResponse(Json.GetValue());
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleGetNote(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	FGuid NoteId;
+	const FDevNote* Note = DevNoteMockServer::GetPathId(Request, NoteId) ? Notes.Find(NoteId) : nullptr;
+	if (!Note)
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::NotFound, TEXT("NoteNotFound"));
+	}
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(DevNoteMockServer::NoteToJson(*Note)));
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandlePostNote(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	FDevNote Note;
+	if (!UDevNoteSubsystem::ParseNoteFromJsonObject(DevNoteMockServer::ParseBodyObject(Request), Note))
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("InvalidNote"), TEXT("Expected a note object"));
+	}
+	if (!Note.Id.IsValid())
+	{
+		Note.Id = FGuid::NewGuid();
+	}
+
+	// A note posted again replaces the one stored, like a retried create would on the real server
+	const FGuid NoteId = Note.Id;
+	StoreNote(MoveTemp(Note), UserId);
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(DevNoteMockServer::NoteToJson(Notes[NoteId])), EHttpServerResponseCodes::Created);
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandlePostNoteDto(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	const TSharedPtr<FJsonObject> Body = DevNoteMockServer::ParseBodyObject(Request);
+	FDevNote Note;
+	if (!Body.IsValid() || !Body->TryGetStringField(TEXT("title"), Note.Title))
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("InvalidNote"), TEXT("Expected a note with a title"));
+	}
+
+	FString IdString;
+	Body->TryGetStringField(TEXT("id"), IdString);
+	if (!FGuid::Parse(IdString, Note.Id))
+	{
+		Note.Id = FGuid::NewGuid();
+	}
+	Body->TryGetStringField(TEXT("body"), Note.Body);
+
+	double X = 0.0, Y = 0.0, Z = 0.0;
+	Body->TryGetNumberField(TEXT("worldX"), X);
+	Body->TryGetNumberField(TEXT("worldY"), Y);
+	Body->TryGetNumberField(TEXT("worldZ"), Z);
+	Note.WorldPosition = FVector(X, Y, Z);
+
+	// The runtime sends the level's package name, the editor keeps object paths
+	FString LevelPackage;
+	Body->TryGetStringField(TEXT("levelPath"), LevelPackage);
+	if (!LevelPackage.IsEmpty())
+	{
+		Note.LevelPath = FSoftObjectPath(LevelPackage.Contains(TEXT(".")) ? LevelPackage : LevelPackage + TEXT(".") + FPackageName::GetShortName(LevelPackage));
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* TagNames = nullptr;
+	if (Body->TryGetArrayField(TEXT("tagNames"), TagNames))
+	{
+		for (const TSharedPtr<FJsonValue>& TagName : *TagNames)
+		{
+			Note.Tags.AddUnique(FindOrAddTag(TagName->AsString()).Id);
+		}
+	}
+
+	FString UserName;
+	Body->TryGetStringField(TEXT("createdByUserName"), UserName);
+	const FGuid AuthorId = FindOrAddUser(UserName.IsEmpty() ? TEXT("Runtime") : UserName).Id;
+
+	const FGuid NoteId = Note.Id;
+	StoreNote(MoveTemp(Note), AuthorId);
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(DevNoteMockServer::NoteToJson(Notes[NoteId])), EHttpServerResponseCodes::Created);
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandlePutNote(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	FGuid NoteId;
+	const FDevNote* Existing = DevNoteMockServer::GetPathId(Request, NoteId) ? Notes.Find(NoteId) : nullptr;
+	if (!Existing)
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::NotFound, TEXT("NoteNotFound"));
+	}
+
+	FDevNote Note;
+	if (!UDevNoteSubsystem::ParseNoteFromJsonObject(DevNoteMockServer::ParseBodyObject(Request), Note))
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("InvalidNote"), TEXT("Expected a note object"));
+	}
+
+	// The path names the note, and who created it and when never changes
+	Note.Id = NoteId;
+	Note.CreatedAt = Existing->CreatedAt;
+	Note.CreatedById = Existing->CreatedById;
+	StoreNote(MoveTemp(Note), UserId);
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(DevNoteMockServer::NoteToJson(Notes[NoteId])));
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleDeleteNote(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	FGuid NoteId;
+	if (!DevNoteMockServer::GetPathId(Request, NoteId) || Notes.Remove(NoteId) == 0)
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::NotFound, TEXT("NoteNotFound"));
+	}
+	NotesJson.Reset();
+	NoteSummariesJson.Reset();
+	return DevNoteMockServer::JsonResponse(FString(), EHttpServerResponseCodes::NoContent);
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleGetTags(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	Values.Reserve(Tags.Num());
+	for (const FDevNoteTag& Tag : Tags)
+	{
+		Values.Add(MakeShared<FJsonValueObject>(UDevNoteSubsystem::ConvertTagToJsonObject(Tag)));
+	}
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(Values));
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandlePostTag(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	FDevNoteTag Tag;
+	if (!UDevNoteSubsystem::ParseTagFromJsonObject(DevNoteMockServer::ParseBodyObject(Request), Tag) || Tag.Name.IsEmpty())
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("InvalidTag"), TEXT("Expected a tag with a name"));
+	}
+	if (!Tag.Id.IsValid())
+	{
+		Tag.Id = FGuid::NewGuid();
+	}
+
+	FDevNoteTag* Existing = Tags.FindByPredicate([&Tag](const FDevNoteTag& Other) { return Other.Id == Tag.Id; });
+	if (Existing)
+	{
+		*Existing = Tag;
+	}
+	else
+	{
+		Tags.Add(Tag);
+	}
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(UDevNoteSubsystem::ConvertTagToJsonObject(Tag).ToSharedRef()), EHttpServerResponseCodes::Created);
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleDeleteTag(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	FGuid TagId;
+	if (!DevNoteMockServer::GetPathId(Request, TagId) || Tags.RemoveAll([&TagId](const FDevNoteTag& Tag) { return Tag.Id == TagId; }) == 0)
+	{
+		return FHttpServerResponse::Error(EHttpServerResponseCodes::NotFound, TEXT("TagNotFound"));
+	}
+
+	// Notes lose the tag, and count as edited so polling clients pick that up
+	const FDateTime Now = FDateTime::UtcNow();
+	for (TPair<FGuid, FDevNote>& Pair : Notes)
+	{
+		if (Pair.Value.Tags.Remove(TagId) > 0)
+		{
+			Pair.Value.LastEdited = Now;
+			NotesJson.Reset();
+			NoteSummariesJson.Reset();
+		}
+	}
+	return DevNoteMockServer::JsonResponse(FString(), EHttpServerResponseCodes::NoContent);
+}
+
+TUniquePtr<FHttpServerResponse> FDevNoteMockServer::HandleGetUsers(const FHttpServerRequest& Request, const FGuid& UserId)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	Values.Reserve(Users.Num());
+	for (const FDevNoteUser& User : Users)
+	{
+		const TSharedRef<FJsonObject> UserJson = MakeShared<FJsonObject>();
+		UserJson->SetStringField(TEXT("id"), User.Id.ToString(EGuidFormats::DigitsWithHyphens));
+		UserJson->SetStringField(TEXT("name"), User.Name);
+		Values.Add(MakeShared<FJsonValueObject>(UserJson));
+	}
+	return DevNoteMockServer::JsonResponse(DevNoteMockServer::ToJsonString(Values));
+}
+
+const FDevNoteUser& FDevNoteMockServer::FindOrAddUser(const FString& UserName)
+{
+	if (const FDevNoteUser* User = Users.FindByPredicate([&UserName](const FDevNoteUser& Other) { return Other.Name == UserName; }))
+	{
+		return *User;
+	}
+
+	FDevNoteUser& User = Users.AddDefaulted_GetRef();
+	User.Id = FGuid::NewGuid();
+	User.Name = UserName;
+	return User;
+}
+
+const FDevNoteTag& FDevNoteMockServer::FindOrAddTag(const FString& TagName)
+{
+	if (const FDevNoteTag* Tag = Tags.FindByPredicate([&TagName](const FDevNoteTag& Other) { return Other.Name == TagName; }))
+	{
+		return *Tag;
+	}
+
+	FDevNoteTag& Tag = Tags.AddDefaulted_GetRef();
+	Tag.Id = FGuid::NewGuid();
+	Tag.Name = TagName;
+	return Tag;
+}
+
+void FDevNoteMockServer::StoreNote(FDevNote&& Note, const FGuid& UserId)
+{
+	Note.LastEdited = FDateTime::UtcNow();
+	if (Note.CreatedAt.GetTicks() == 0)
+	{
+		Note.CreatedAt = Note.LastEdited;
+	}
+	if (!Note.CreatedById.IsValid())
+	{
+		Note.CreatedById = UserId;
+	}
+	Note.bBodyLoaded = true;
+
+	const FGuid NoteId = Note.Id;
+	Notes.Add(NoteId, MoveTemp(Note));
+	NotesJson.Reset();
+	NoteSummariesJson.Reset();
+}
+
+void FDevNoteMockServer::Respond(TUniquePtr<FHttpServerResponse>&& Response, const FHttpResultCallback& OnComplete)
+{
+	const float JitterMs = Settings.JitterMs > 0.0f ? Random.FRandRange(-Settings.JitterMs, Settings.JitterMs) : 0.0f;
+	const float DelayMs = Settings.LatencyMs + JitterMs;
+	if (DelayMs <= 0.0f)
+	{
+		OnComplete(MoveTemp(Response));
+		return;
+	}
+
+	FPendingResponse& Pending = PendingResponses.AddDefaulted_GetRef();
+	Pending.DueTime = FPlatformTime::Seconds() + DelayMs / 1000.0;
+	Pending.Response = MoveTemp(Response);
+	Pending.OnComplete = OnComplete;
+}
+
+bool FDevNoteMockServer::SendDueResponses(float DeltaTime)
+{
+	// Take the due ones out first, sending may come back in and queue more
+	const double Now = FPlatformTime::Seconds();
+	TArray<FPendingResponse> Due;
+	for (int32 Index = PendingResponses.Num() - 1; Index >= 0; --Index)
+	{
+		if (PendingResponses[Index].DueTime <= Now)
+		{
+			Due.Add(MoveTemp(PendingResponses[Index]));
+			PendingResponses.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	Due.Sort([](const FPendingResponse& A, const FPendingResponse& B) { return A.DueTime < B.DueTime; });
+	for (FPendingResponse& Pending : Due)
+	{
+		Pending.OnComplete(MoveTemp(Pending.Response));
+	}
+	return true;
+}
@@ -0,0 +1,104 @@
+#include "DevNotesMockServer.h"
+
+#include "DevNoteMockServer.h"
+#include "DevNotesMockServerLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+
+DEFINE_LOG_CATEGORY(LogDevNotesMockServer);
+
+void FDevNotesMockServerModule::StartupModule()
+{
+	// -DevNotesMockServer, or -DevNotesMockServer="Notes=100000 LatencyMs=50" to configure it
+	FString Params;
+	if (FParse::Value(FCommandLine::Get(), TEXT("DevNotesMockServer="), Params, /* bShouldStopOnSeparator */ false)
+		|| FParse::Param(FCommandLine::Get(), TEXT("DevNotesMockServer")))
+	{
+		StartServer(FDevNoteMockServerSettings::FromString(*Params));
+	}
+}
+
+void FDevNotesMockServerModule::ShutdownModule()
+{
+	StopServer();
+}
+
+FDevNotesMockServerModule& FDevNotesMockServerModule::Get()
+{
+	return FModuleManager::LoadModuleChecked<FDevNotesMockServerModule>(TEXT("DevNotesMockServer"));
+}
+
+TSharedPtr<FDevNoteMockServer> FDevNotesMockServerModule::StartServer(const FDevNoteMockServerSettings& Settings)
+{
+	StopServer();
+
+	Server = MakeShared<FDevNoteMockServer>(Settings);
+	if (!Server->Start())
+	{
+		Server.Reset();
+	}
+	return Server;
+}
+
+void FDevNotesMockServerModule::StopServer()
+{
+	if (Server.IsValid())
+	{
+		Server->Stop();
+		Server.Reset();
+	}
+}
+
+namespace DevNotesMockServerCommands
+{
+	static void Start(const TArray<FString>& Args)
+	{
+		FDevNotesMockServerModule::Get().StartServer(FDevNoteMockServerSettings::FromString(*FString::Join(Args, TEXT(" "))));
+	}
+
+	static void Stop()
+	{
+		FDevNotesMockServerModule::Get().StopServer();
+	}
+
+	static void Set(const TArray<FString>& Args)
+	{
+		const TSharedPtr<FDevNoteMockServer> Server = FDevNotesMockServerModule::Get().GetServer();
+		if (!Server.IsValid())
+		{
+			UE_LOG(LogDevNotesMockServer, Warning, TEXT("The mock server isn't running"));
+			return;
+		}
+
+		const FString Params = FString::Join(Args, TEXT(" "));
+		FDevNoteMockServerSettings Settings = Server->GetSettings();
+		FParse::Value(*Params, TEXT("LatencyMs="), Settings.LatencyMs);
+		FParse::Value(*Params, TEXT("JitterMs="), Settings.JitterMs);
+		FParse::Value(*Params, TEXT("ErrorRate="), Settings.ErrorRate);
+		FParse::Value(*Params, TEXT("ErrorCode="), Settings.ErrorCode);
+		Server->SetLatency(Settings.LatencyMs, Settings.JitterMs);
+		Server->SetErrorRate(Settings.ErrorRate, Settings.ErrorCode);
+		UE_LOG(LogDevNotesMockServer, Display, TEXT("Mock server latency %.0f +- %.0f ms, error rate %.2f answered with %d"),
+			Settings.LatencyMs, Settings.JitterMs, Settings.ErrorRate, Settings.ErrorCode);
+	}
+}
+
+static FAutoConsoleCommand GDevNotesMockServerStartCommand(
+	TEXT("DevNotes.MockServer.Start"),
+	TEXT("Serves a synthetic DevNotes dataset locally, for testing the client without the DevNotes Server.\n")
+	TEXT("Usage: DevNotes.MockServer.Start [Port=7126] [Notes=10000] [Tags=2000] [Users=500] [Levels=200] [BodyWords=40] [Seed=1234]\n")
+	TEXT("       [LatencyMs=0] [JitterMs=0] [ErrorRate=0] [ErrorCode=500] [Password=]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DevNotesMockServerCommands::Start));
+
+static FAutoConsoleCommand GDevNotesMockServerStopCommand(
+	TEXT("DevNotes.MockServer.Stop"),
+	TEXT("Stops the local mock server."),
+	FConsoleCommandDelegate::CreateStatic(&DevNotesMockServerCommands::Stop));
+
+static FAutoConsoleCommand GDevNotesMockServerSetCommand(
+	TEXT("DevNotes.MockServer.Set"),
+	TEXT("Changes the running mock server's latency and error rate.\n")
+	TEXT("Usage: DevNotes.MockServer.Set [LatencyMs=] [JitterMs=] [ErrorRate=] [ErrorCode=]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DevNotesMockServerCommands::Set));
+
+IMPLEMENT_MODULE(FDevNotesMockServerModule, DevNotesMockServer)
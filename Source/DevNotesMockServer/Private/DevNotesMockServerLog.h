@@ -0,0 +1,3 @@
+#pragma once
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDevNotesMockServer, Log, All);
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DevNoteSyntheticData.h"
+#include "HttpResultCallback.h"
+#include "HttpServerConstants.h"
+#include "HttpServerResponse.h"
+#include "HttpRouteHandle.h"
+#include "Containers/Ticker.h"
+#include "Math/RandomStream.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+
+struct DEVNOTESMOCKSERVER_API FDevNoteMockServerSettings
+{
+	uint32 Port = 7126;
+
+	// The dataset the server starts with
+	FDevNoteSyntheticDataParams Data;
+
+	// Every response waits LatencyMs, give or take up to JitterMs
+	float LatencyMs = 0.0f;
+	float JitterMs = 0.0f;
+
+	// Fraction of requests, 0 to 1, answered with ErrorCode instead of being handled
+	float ErrorRate = 0.0f;
+	int32 ErrorCode = 500;
+
+	// Sign in accepts any user name, and any password while this is empty
+	FString Password;
+
+	// Read Port=, Notes=, Tags=, Users=, Levels=, BodyWords=, Seed=, LatencyMs=, JitterMs=, ErrorRate=, ErrorCode= and Password=
+	static FDevNoteMockServerSettings FromString(const TCHAR* Params);
+};
+
+/**
+ * An in-process stand-in for the DevNotes Server, serving an in-memory synthetic dataset over HTTPServer.
+ * Implements sign in and out, token validation, notes (list, summary list, fetch, create, update, delete, /notes/dto),
+ * tags (list, create, delete) and users. Session tokens are checked like the real server's, answering 401 when unknown.
+ * Requests are handled on the game thread. Responses are held back by the configured latency, so jitter can reorder them.
+ */
+class DEVNOTESMOCKSERVER_API FDevNoteMockServer : public TSharedFromThis<FDevNoteMockServer>
+{
+public:
+	explicit FDevNoteMockServer(const FDevNoteMockServerSettings& InSettings);
+	~FDevNoteMockServer();
+
+	bool Start();
+
+	// Sends every response still waiting out its latency, then stops serving
+	void Stop();
+
+	bool IsRunning() const { return Router.IsValid(); }
+	const FDevNoteMockServerSettings& GetSettings() const { return Settings; }
+	FString GetAddress() const { return FString::Printf(TEXT("http://localhost:%u"), Settings.Port); }
+
+	// Takes effect for the next request
+	void SetLatency(float InLatencyMs, float InJitterMs);
+	void SetErrorRate(float InErrorRate, int32 InErrorCode);
+
+	int32 NumNotes() const { return Notes.Num(); }
+	int64 NumRequestsHandled() const { return RequestsHandled; }
+	int64 NumErrorsInjected() const { return ErrorsInjected; }
+
+	// A session token for UserName, as if it had signed in
+	FString CreateSession(const FString& UserName);
+
+private:
+	using FHandler = TUniquePtr<FHttpServerResponse> (FDevNoteMockServer::*)(const FHttpServerRequest&, const FGuid& UserId);
+
+	void Bind(const TCHAR* Path, EHttpServerRequestVerbs Verbs, FHandler Handler, bool bRequiresSession = true);
+	bool Handle(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, FHandler Handler, bool bRequiresSession);
+
+	TUniquePtr<FHttpServerResponse> HandleSignIn(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandleValidateToken(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandleSignOut(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandleGetNotes(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandleGetNote(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandlePostNote(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandlePostNoteDto(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandlePutNote(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandleDeleteNote(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandleGetTags(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandlePostTag(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandleDeleteTag(const FHttpServerRequest& Request, const FGuid& UserId);
+	TUniquePtr<FHttpServerResponse> HandleGetUsers(const FHttpServerRequest& Request, const FGuid& UserId);
+
+	const FDevNoteUser& FindOrAddUser(const FString& UserName);
+	const FDevNoteTag& FindOrAddTag(const FString& TagName);
+
+	// Store a created or updated note, stamping its edit time
+	void StoreNote(FDevNote&& Note, const FGuid& UserId);
+
+	// Queue a response to go out once its latency has passed
+	void Respond(TUniquePtr<FHttpServerResponse>&& Response, const FHttpResultCallback& OnComplete);
+	bool SendDueResponses(float DeltaTime);
+
+	FDevNoteMockServerSettings Settings;
+	FRandomStream Random;
+
+	TMap<FGuid, FDevNote> Notes;
+	TArray<FDevNoteTag> Tags;
+	TArray<FDevNoteUser> Users;
+
+	// Session token to user
+	TMap<FString, FGuid> Sessions;
+
+	// GET /notes responses, serialized on the first poll after the notes change rather than on every poll
+	TOptional<FString> NotesJson;
+	TOptional<FString> NoteSummariesJson;
+
+	struct FPendingResponse
+	{
+		double DueTime = 0.0;
+		TUniquePtr<FHttpServerResponse> Response;
+		FHttpResultCallback OnComplete;
+	};
+	TArray<FPendingResponse> PendingResponses;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	TSharedPtr<IHttpRouter> Router;
+	TArray<FHttpRouteHandle> RouteHandles;
+
+	int64 RequestsHandled = 0;
+	int64 ErrorsInjected = 0;
+};
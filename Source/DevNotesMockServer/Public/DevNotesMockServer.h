@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+class FDevNoteMockServer;
+struct FDevNoteMockServerSettings;
+
+class DEVNOTESMOCKSERVER_API FDevNotesMockServerModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	static FDevNotesMockServerModule& Get();
+
+	// Replaces any server already running. Returns null if the port could not be bound
+	TSharedPtr<FDevNoteMockServer> StartServer(const FDevNoteMockServerSettings& Settings);
+	void StopServer();
+
+	TSharedPtr<FDevNoteMockServer> GetServer() const { return Server; }
+
+private:
+	TSharedPtr<FDevNoteMockServer> Server;
+};